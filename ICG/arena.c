@@ -0,0 +1,109 @@
+/* arena (bump pointer) allocation */
+
+# include <stdio.h>
+# include <stdlib.h>
+# include <string.h>
+# include "arena.h"
+
+# define ALIGN    sizeof(double)	   /* alignment of aalloc results */
+
+extern void yyerror(const char *);
+
+/*
+ * newblk - allocate a block able to hold n bytes
+ */
+static struct arena_blk *newblk(unsigned n)
+{
+   struct arena_blk *b;
+
+   if ((b = malloc(sizeof(struct arena_blk) + n)) == NULL) {
+      yyerror("csem: out of space");
+      exit (1);
+   }
+   b->b_next = NULL;
+   b->b_end = b->b_data + n;
+   return (b);
+}
+
+/*
+ * ainit - initialize arena a with blocks of blksize bytes
+ */
+void ainit(struct arena *a, unsigned blksize)
+{
+   a->a_blksize = blksize;
+   a->a_first = a->a_blk = newblk(blksize);
+   a->a_free = a->a_blk->b_data;
+}
+
+/*
+ * grow - make the current block one that has room for n bytes
+ *
+ * Blocks past the current one are left over from an arelease and are
+ * reused before any new block is allocated.
+ */
+static void grow(struct arena *a, unsigned n)
+{
+   struct arena_blk *b = a->a_blk->b_next;
+
+   if (b == NULL || (unsigned) (b->b_end - b->b_data) < n) {
+      b = newblk(n > a->a_blksize ? n : a->a_blksize);
+      b->b_next = a->a_blk->b_next;
+      a->a_blk->b_next = b;
+   }
+   a->a_blk = b;
+   a->a_free = b->b_data;
+}
+
+/*
+ * aalloc - allocate n bytes aligned for any semantic structure
+ */
+char *aalloc(struct arena *a, unsigned n)
+{
+   char *p;
+
+   n = (n + ALIGN - 1) & ~(ALIGN - 1);
+   p = (char *) (((unsigned long) a->a_free + ALIGN - 1) & ~(ALIGN - 1));
+   if (p + n > a->a_blk->b_end) {
+      grow(a, n);
+      p = a->a_free;
+   }
+   a->a_free = p + n;
+   return (p);
+}
+
+/*
+ * asave - copy n bytes of s into a, nul terminate, return the copy
+ */
+char *asave(struct arena *a, char *s, unsigned n)
+{
+   char *p;
+
+   if (a->a_free + n + 1 > a->a_blk->b_end)
+      grow(a, n + 1);
+   p = a->a_free;
+   memcpy(p, s, n);
+   p[n] = '\0';
+   a->a_free = p + n + 1;
+   return (p);
+}
+
+/*
+ * amark - return a marker for the current top of a
+ */
+struct amark amark(struct arena *a)
+{
+   struct amark m;
+
+   m.m_blk = a->a_blk;
+   m.m_free = a->a_free;
+   return (m);
+}
+
+/*
+ * arelease - release everything allocated in a since mark m
+ */
+void arelease(struct arena *a, struct amark m)
+{
+   a->a_blk = m.m_blk;
+   a->a_free = m.m_free;
+}
@@ -0,0 +1,24 @@
+/* arena (bump pointer) allocator */
+struct arena_blk {
+   struct arena_blk *b_next;		/* next block in chain */
+   char *b_end;				/* one past the last usable byte */
+   char b_data[1];			/* storage, extends to b_end */
+};
+
+struct arena {
+   struct arena_blk *a_first;		/* first block */
+   struct arena_blk *a_blk;		/* block currently being filled */
+   char *a_free;			/* next free byte in a_blk */
+   unsigned a_blksize;			/* default block size */
+};
+
+struct amark {
+   struct arena_blk *m_blk;		/* block current at the mark */
+   char *m_free;			/* free pointer at the mark */
+};
+
+void ainit(struct arena *, unsigned);
+char *aalloc(struct arena *, unsigned);
+char *asave(struct arena *, char *, unsigned);
+struct amark amark(struct arena *);
+void arelease(struct arena *, struct amark);
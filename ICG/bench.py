@@ -0,0 +1,94 @@
+"""
+Times csem on large programs from genprog.py.  For each set of flags it
+reports source lines and quads per second of the best of several runs,
+the peak memory of the process, and the time csem spent reading,
+scanning, parsing, in the semantic actions, optimizing and writing, from
+a separate run with -p (timing the phases slows them a little).
+"""
+import argparse
+import os
+import re
+import subprocess
+import sys
+import tempfile
+import time
+
+import genprog
+
+PHASES = ['read', 'lex', 'parse', 'semantic', 'optimize', 'write']
+
+
+def run(csem, flags, src, out):
+    """Run csem once, return its wall time in seconds, peak memory in KB
+    and what it wrote on stderr."""
+    with open(src) as fin, open(out, 'w') as fout:
+        start = time.time()
+        p = subprocess.Popen([csem] + flags, stdin=fin, stdout=fout,
+                             stderr=subprocess.PIPE)
+        err = p.stderr.read()
+        _, status, usage = os.wait4(p.pid, 0)
+        wall = time.time() - start
+    p.returncode = os.waitstatus_to_exitcode(status)
+    if p.returncode != 0:
+        sys.stderr.write(err.decode())
+        sys.exit("csem %s failed on %s" % (' '.join(flags), src))
+    return wall, usage.ru_maxrss, err.decode()
+
+
+def phases(text):
+    """The msec of each phase in the -p output text."""
+    times = {}
+    for line in text.splitlines():
+        m = re.match(r'(\w+)\s+([\d.]+)$', line)
+        if m and m.group(1) in PHASES:
+            times[m.group(1)] = float(m.group(2))
+    return times
+
+
+def lines(path):
+    """The number of lines in the file path."""
+    with open(path) as fp:
+        return sum(1 for _ in fp)
+
+
+if __name__ == '__main__':
+    parser = argparse.ArgumentParser()
+    parser.add_argument('--csem', type=str, default='./csem')
+    parser.add_argument('--functions', '-n', type=int, nargs='+',
+                        default=[500, 2000],
+                        help="sizes of the programs, in functions")
+    parser.add_argument('--flags', '-f', type=str, default=',-O1,-O2,-O3',
+                        help="sets of csem flags to time, split by commas; "
+                             "EXAMPLE: -f=-O2,-O2 -t4")
+    parser.add_argument('--runs', '-r', type=int, default=3,
+                        help="runs of each, the best is kept")
+    parser.add_argument('--seed', '-s', type=int, default=1)
+    args = parser.parse_args()
+
+    tmp = tempfile.mkdtemp(prefix='csembench')
+    print("%-6s %-8s %8s %9s %8s %10s %11s %8s  %s" % (
+        "funcs", "flags", "lines", "quads", "sec", "lines/s", "quads/s",
+        "peak KB", ' '.join("%8s" % p for p in PHASES)))
+    for n in args.functions:
+        src = os.path.join(tmp, 'bench%d.c' % n)
+        out = os.path.join(tmp, 'bench%d.q' % n)
+        with open(src, 'w') as fp:
+            fp.write(genprog.generate(n, args.seed))
+        nlines = lines(src)
+        for flagset in args.flags.split(','):
+            flags = flagset.split()
+            best, peak = None, 0
+            for _ in range(args.runs):
+                wall, rss, _ = run(args.csem, flags, src, out)
+                best = wall if best is None else min(best, wall)
+                peak = max(peak, rss)
+            nquads = lines(out)
+            _, _, err = run(args.csem, flags + ['-p'], src, out)
+            t = phases(err)
+            print("%-6d %-8s %8d %9d %8.3f %10.0f %11.0f %8d  %s" % (
+                n, flagset or '-', nlines, nquads, best, nlines / best,
+                nquads / best, peak,
+                ' '.join("%8.1f" % t.get(p, 0) for p in PHASES)))
+            os.remove(out)
+        os.remove(src)
+    os.rmdir(tmp)
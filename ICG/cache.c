@@ -0,0 +1,295 @@
+/* cache of optimized functions, kept in files from one run to the next */
+
+# include <stdio.h>
+# include <stdlib.h>
+# include <string.h>
+# include <unistd.h>
+# include <pthread.h>
+# include "cc.h"
+# include "quad.h"
+# include "opt.h"
+# include "sym.h"
+# include "cache.h"
+
+extern void yyerror(const char *);
+
+/*
+ * A function is known by the quads the semantic routines made for it,
+ * before they are resolved or optimized.  They are what the rest of the
+ * output depends on: the declarations of the globals it names show in
+ * their types and conversions, and a change that leaves them alone, such
+ * as to a comment or to another function, leaves the function alone.
+ *
+ * Temporaries, labels and lines run on through a file, so before hashing
+ * the quads are numbered as if each of the four started at the function:
+ * the same text anywhere in any file has the same key.  An entry holds the
+ * finished quads numbered the same way, and is moved back to where the
+ * function is when it is used, so the output is what optimizing it would
+ * have given.
+ *
+ * An entry is the file named by the key in hex in cachedir:
+ *
+ *    csem-cache 1 nquads ntemps
+ *    op t z x y n m len s
+ *    ...
+ *
+ * a line per quad, len being -1 if the quad has no string.  It is written
+ * under another name and renamed, so a reader never sees half of one.
+ */
+
+# define CMAGIC "csem-cache 1"	/* first words of an entry */
+# define FNVBASIS 14695981039346656037ULL
+# define FNVPRIME 1099511628211ULL
+
+char *cachedir = NULL;			/* -C directory, NULL for none */
+
+/* counts for -p, shared by all threads */
+static pthread_mutex_t cslock = PTHREAD_MUTEX_INITIALIZER;
+static long chits = 0;			/* functions served from the cache */
+static long cmisses = 0;		/* functions optimized */
+static long cstores = 0;		/* entries written */
+
+/*
+ * cmove - renumber quad q by the bases in k, down from where it is to
+ *         the cache with sign -1, back up with 1
+ */
+static void cmove(struct quad *q, struct ckey *k, int sign)
+{
+   if (q->q_z)
+      q->q_z += sign * k->k_temp;
+   if (qusesx(q->q_op))
+      q->q_x += sign * k->k_temp;
+   if (qusesy(q->q_op) && q->q_y)
+      q->q_y += sign * k->k_temp;
+   switch (q->q_op) {
+      case Q_BT: case Q_BR: case Q_BPATCH:
+         q->q_n += sign * k->k_bpatch;
+         if (q->q_m)
+            q->q_m += sign * k->k_label;
+         break;
+      case Q_LABEL:
+         q->q_n += sign * k->k_label;
+         break;
+      case Q_BGNSTMT:
+         q->q_n += sign * k->k_line;
+         break;
+   }
+}
+
+/*
+ * chash - fold the n bytes at p into hash h
+ */
+static unsigned long long chash(unsigned long long h, void *p, unsigned n)
+{
+   unsigned char *s = p;
+
+   while (n-- > 0)
+      h = (h ^ *s++) * FNVPRIME;
+   return (h);
+}
+
+/*
+ * ckeyof - find the bases of f, and hash its quads numbered from them
+ *          with the options that shape what is made of them
+ */
+static void ckeyof(struct qfunc *f, struct ckey *k)
+{
+   struct quad *q, c;
+   unsigned long long h;
+   int lo, hi, v[8];
+
+   qtemps(f, &lo, &hi);
+   k->k_temp = hi ? lo - 1 : f->f_ntemp;
+   k->k_label = k->k_bpatch = k->k_line = 0x7fffffff;
+   for (q = f->f_quads; q < &f->f_quads[f->f_nquads]; q++)
+      if (q->q_op == Q_LABEL && q->q_n <= k->k_label)
+         k->k_label = q->q_n - 1;
+      else if ((q->q_op == Q_BT || q->q_op == Q_BR || q->q_op == Q_BPATCH) &&
+               q->q_n <= k->k_bpatch)
+         k->k_bpatch = q->q_n - 1;
+      else if (q->q_op == Q_BGNSTMT && q->q_n <= k->k_line)
+         k->k_line = q->q_n - 1;
+   if (k->k_label == 0x7fffffff)
+      k->k_label = 0;
+   if (k->k_bpatch == 0x7fffffff)
+      k->k_bpatch = 0;
+   if (k->k_line == 0x7fffffff)
+      k->k_line = 0;
+
+   v[0] = optlevel;
+   v[1] = qbpatch;
+   v[2] = f->f_ntemp - k->k_temp;
+   h = chash(FNVBASIS, v, 3 * sizeof(int));
+   for (q = f->f_quads; q < &f->f_quads[f->f_nquads]; q++) {
+      c = *q;
+      cmove(&c, k, -1);
+      v[0] = c.q_op;
+      v[1] = c.q_t;
+      v[2] = c.q_z;
+      v[3] = c.q_x;
+      v[4] = c.q_y;
+      v[5] = c.q_n;
+      v[6] = c.q_m;
+      v[7] = c.q_s ? (int) strlen(c.q_s) : -1;
+      h = chash(h, v, sizeof(v));
+      if (c.q_s)
+         h = chash(h, c.q_s, v[7]);
+   }
+   k->k_hash = h;
+}
+
+/*
+ * cpath - name of the entry for key k, to be freed
+ */
+static char *cpath(struct ckey *k)
+{
+   char *p;
+
+   p = alloc(strlen(cachedir) + 24);
+   sprintf(p, "%s/%016llx", cachedir, k->k_hash);
+   return (p);
+}
+
+/*
+ * cnum - read the number at *p into *n and move *p past it and the blank
+ *        after it, return zero if there is none
+ */
+static int cnum(char **p, int *n)
+{
+   char *s;
+
+   *n = (int) strtol(*p, &s, 10);
+   if (s == *p || (*s != ' ' && *s != '\n'))
+      return (0);
+   *p = s + 1;
+   return (1);
+}
+
+/*
+ * cread - read the entry on fp for key k into g, return nonzero if it
+ *         was whole
+ */
+static int cread(FILE *fp, struct qfunc *g, struct ckey *k)
+{
+   struct quad *q;
+   char *buf, *p, *end;
+   int n, ntemp, len;
+   long size;
+
+   if (fseek(fp, 0L, SEEK_END) != 0 || (size = ftell(fp)) <= 0 ||
+       fseek(fp, 0L, SEEK_SET) != 0)
+      return (0);
+   buf = alloc(size + 1);
+   end = buf + fread(buf, 1, size, fp);
+   *end = '\0';
+   p = buf + sizeof(CMAGIC);
+   if (strncmp(buf, CMAGIC " ", sizeof(CMAGIC)) != 0 || !cnum(&p, &n) ||
+       !cnum(&p, &ntemp) || n < 0) {
+      free(buf);
+      return (0);
+   }
+   g->f_ntemp = k->k_temp + ntemp;
+   for (q = qinsert(g, 0, n); q < &g->f_quads[n]; q++) {
+      if (!cnum(&p, &q->q_op) || !cnum(&p, &q->q_t) || !cnum(&p, &q->q_z) ||
+          !cnum(&p, &q->q_x) || !cnum(&p, &q->q_y) || !cnum(&p, &q->q_n) ||
+          !cnum(&p, &q->q_m) || !cnum(&p, &len) ||
+          q->q_op < 0 || q->q_op >= Q_NOPS || len >= end - p)
+         break;
+      if (len >= 0) {
+         q->q_s = snlookup(p, len);
+         p += len;
+      }
+      if (*p++ != '\n')
+         break;
+      cmove(q, k, 1);
+   }
+   free(buf);
+   return (q == &g->f_quads[n]);
+}
+
+/*
+ * cfetch - find the key of the unoptimized function f in k, and if the
+ *          cache has it replace f by its entry and return nonzero
+ */
+int cfetch(struct qfunc *f, struct ckey *k)
+{
+   struct qfunc g;
+   FILE *fp;
+   char *path;
+   int ok = 0;
+
+   ckeyof(f, k);
+   path = cpath(k);
+   if ((fp = fopen(path, "r")) != NULL) {
+      memset(&g, 0, sizeof(g));
+      if ((ok = cread(fp, &g, k)) != 0) {
+         g.f_nlabel = f->f_nlabel;
+         free(f->f_quads);
+         *f = g;
+      }
+      else
+         free(g.f_quads);
+      fclose(fp);
+   }
+   free(path);
+
+   pthread_mutex_lock(&cslock);
+   if (ok)
+      chits++;
+   else
+      cmisses++;
+   pthread_mutex_unlock(&cslock);
+   return (ok);
+}
+
+/*
+ * cstore - enter the finished function f in the cache under key k
+ */
+void cstore(struct qfunc *f, struct ckey *k)
+{
+   struct quad *q, c;
+   FILE *fp = NULL;
+   char *path, *tmp;
+   int fd;
+
+   path = cpath(k);
+   tmp = alloc(strlen(path) + 8);
+   sprintf(tmp, "%s.XXXXXX", path);
+   if ((fd = mkstemp(tmp)) < 0 || (fp = fdopen(fd, "w")) == NULL) {
+      if (fd >= 0) {
+         close(fd);
+         unlink(tmp);
+      }
+      free(tmp);
+      free(path);
+      return;
+   }
+   fprintf(fp, "%s %d %d\n", CMAGIC, f->f_nquads, f->f_ntemp - k->k_temp);
+   for (q = f->f_quads; q < &f->f_quads[f->f_nquads]; q++) {
+      c = *q;
+      cmove(&c, k, -1);
+      fprintf(fp, "%d %d %d %d %d %d %d %d ", c.q_op, c.q_t, c.q_z, c.q_x,
+              c.q_y, c.q_n, c.q_m, c.q_s ? (int) strlen(c.q_s) : -1);
+      if (c.q_s)
+         fputs(c.q_s, fp);
+      putc('\n', fp);
+   }
+   if (fclose(fp) == 0 && rename(tmp, path) == 0) {
+      pthread_mutex_lock(&cslock);
+      cstores++;
+      pthread_mutex_unlock(&cslock);
+   }
+   else
+      unlink(tmp);
+   free(tmp);
+   free(path);
+}
+
+/*
+ * cstats - print the use made of the cache on fp
+ */
+void cstats(FILE *fp)
+{
+   fprintf(fp, "cache %s: %ld hits, %ld misses, %ld stored\n", cachedir,
+           chits, cmisses, cstores);
+}
@@ -0,0 +1,14 @@
+/* where a function's numbering starts, and the hash of its quads */
+struct ckey {
+   unsigned long long k_hash;	/* of the quads numbered from the bases */
+   int k_temp;			/* temporaries are numbered after this */
+   int k_label;			/* labels Ln */
+   int k_bpatch;		/* backpatch labels Bn */
+   int k_line;			/* statement lines */
+};
+
+extern char *cachedir;
+
+int cfetch(struct qfunc *, struct ckey *);
+void cstore(struct qfunc *, struct ckey *);
+void cstats(FILE *);
@@ -1,6 +1,12 @@
+/*
+ * The state of a compilation is kept apart for each thread, so one csem
+ * can translate several files at once.
+ */
+# define UNIT __thread
+
 /* symbol table entry */
 struct id_entry {
-   struct id_entry *i_link;	/* pointer to next entry on hash chain */
+   struct id_entry *i_link;	/* pointer to entry this one hides */
    char *i_name;		/* pointer to name in string table */
    int i_type;			/* type code */
    int i_blevel;		/* block level */
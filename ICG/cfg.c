@@ -0,0 +1,377 @@
+/* basic blocks and control-flow graph of a function */
+
+# include <stdio.h>
+# include <stdlib.h>
+# include "cc.h"
+# include "quad.h"
+# include "cfg.h"
+# include "opt.h"
+
+int cfgdump = 0;			/* print the graph of each function */
+
+/*
+ * leader - nonzero if quad i of f starts a basic block
+ */
+static int leader(struct qfunc *f, int i)
+{
+   int op;
+
+   if (i == 0 || f->f_quads[i].q_op == Q_LABEL)
+      return (1);
+   op = f->f_quads[i - 1].q_op;
+   return (op == Q_BT || op == Q_BR || op == Q_GOTO || op == Q_RET);
+}
+
+/*
+ * cfgbuild - divide f into basic blocks and link them into graph g
+ *
+ * A block starts at a label or after a branch or return, and falls into
+ * the next one unless it ends in br or ret.  Branches still on backpatch
+ * labels (csem -B) go where their Bn=Lm says.  A block that returns or
+ * ends the function has no successors.
+ */
+void cfgbuild(struct cfg *g, struct qfunc *f)
+{
+   struct quad *q;
+   struct block *b, *s;
+   int *bmap, *lblock, blo, bhi, llo, lhi, i, n, l;
+
+   g->c_f = f;
+   g->c_order = NULL;
+   g->c_norder = 0;
+   g->c_loops = NULL;
+   g->c_nloops = 0;
+   blo = llo = 0x7fffffff;
+   bhi = lhi = 0;
+   for (n = i = 0, q = f->f_quads; i < f->f_nquads; i++, q++) {
+      if (leader(f, i))
+         n++;
+      if (q->q_op == Q_BT || q->q_op == Q_BR || q->q_op == Q_BPATCH) {
+         blo = q->q_n < blo ? q->q_n : blo;
+         bhi = q->q_n > bhi ? q->q_n : bhi;
+      }
+      else if (q->q_op == Q_LABEL) {
+         llo = q->q_n < llo ? q->q_n : llo;
+         lhi = q->q_n > lhi ? q->q_n : lhi;
+      }
+   }
+   g->c_nblocks = n;
+   g->c_blocks = (struct block *) oalloc(n * sizeof(struct block));
+   bmap = (int *) oalloc((bhi >= blo ? bhi - blo + 1 : 1) * sizeof(int));
+   lblock = (int *) oalloc((lhi >= llo ? lhi - llo + 1 : 1) * sizeof(int));
+
+   for (b = NULL, i = 0, q = f->f_quads; i < f->f_nquads; i++, q++) {
+      if (leader(f, i)) {
+         if (b)
+            b->b_last = i;
+         b = b ? b + 1 : g->c_blocks;
+         b->b_first = i;
+      }
+      if (q->q_op == Q_LABEL)
+         lblock[q->q_n - llo] = b - g->c_blocks;
+      else if (q->q_op == Q_BPATCH)
+         bmap[q->q_n - blo] = q->q_m;
+   }
+   if (b)
+      b->b_last = f->f_nquads;
+   for (b = g->c_blocks; b < &g->c_blocks[n]; b++)
+      b->b_idom = -1;
+
+   for (b = g->c_blocks; b < &g->c_blocks[n]; b++) {
+      q = &f->f_quads[b->b_last - 1];
+      l = 0;
+      if (q->q_op == Q_BT || q->q_op == Q_BR)
+         l = q->q_m ? q->q_m : bmap[q->q_n - blo];
+      else if (q->q_op == Q_GOTO)
+         for (i = 0; i < n; i++)
+            if (f->f_quads[g->c_blocks[i].b_first].q_op == Q_LABEL &&
+                f->f_quads[g->c_blocks[i].b_first].q_s == q->q_s)
+               l = f->f_quads[g->c_blocks[i].b_first].q_n;
+      if (l >= llo && l <= lhi)
+         b->b_succ[b->b_nsucc++] = lblock[l - llo];
+      if (q->q_op != Q_BR && q->q_op != Q_GOTO && q->q_op != Q_RET &&
+          b + 1 < &g->c_blocks[n] &&
+          (b->b_nsucc == 0 || b->b_succ[0] != b + 1 - g->c_blocks))
+         b->b_succ[b->b_nsucc++] = b + 1 - g->c_blocks;
+   }
+
+   /* predecessors, in a list per block */
+   for (l = 0, b = g->c_blocks; b < &g->c_blocks[n]; b++)
+      for (i = 0; i < b->b_nsucc; i++, l++)
+         g->c_blocks[b->b_succ[i]].b_npred++;
+   g->c_preds = (int *) oalloc(l * sizeof(int));
+   for (l = 0, b = g->c_blocks; b < &g->c_blocks[n]; b++) {
+      b->b_pred = &g->c_preds[l];
+      l += b->b_npred;
+      b->b_npred = 0;
+   }
+   for (b = g->c_blocks; b < &g->c_blocks[n]; b++)
+      for (i = 0; i < b->b_nsucc; i++) {
+         s = &g->c_blocks[b->b_succ[i]];
+         s->b_pred[s->b_npred++] = b - g->c_blocks;
+      }
+   free(bmap);
+   free(lblock);
+}
+
+/*
+ * cfgfree - release the storage of graph g
+ */
+void cfgfree(struct cfg *g)
+{
+   int i;
+
+   for (i = 0; i < g->c_nloops; i++)
+      free(g->c_loops[i].l_blocks);
+   for (i = 0; i < g->c_nblocks; i++)
+      free(g->c_blocks[i].b_df);
+   free(g->c_loops);
+   free(g->c_order);
+   free(g->c_blocks);
+   free(g->c_preds);
+   g->c_loops = NULL;
+   g->c_order = NULL;
+   g->c_blocks = NULL;
+   g->c_preds = NULL;
+   g->c_nloops = g->c_norder = g->c_nblocks = 0;
+}
+
+/*
+ * cfgdom - find the immediate dominator of every reachable block of g
+ *
+ * This is the iterative algorithm of Cooper, Harvey and Kennedy, over
+ * the blocks in reverse postorder.
+ */
+void cfgdom(struct cfg *g)
+{
+   struct block *bl = g->c_blocks;
+   int *stk, *next, *post, sp, np, b, i, a, c, d, changed;
+
+   if (g->c_nblocks == 0 || g->c_order)
+      return;
+   stk = (int *) oalloc(g->c_nblocks * sizeof(int));
+   next = (int *) oalloc(g->c_nblocks * sizeof(int));
+   post = (int *) oalloc(g->c_nblocks * sizeof(int));
+
+   /* depth-first from the entry, b_rpo marking the blocks seen */
+   for (b = 0; b < g->c_nblocks; b++)
+      bl[b].b_rpo = -1;
+   np = 0;
+   sp = 0;
+   stk[sp++] = 0;
+   bl[0].b_rpo = 0;
+   while (sp > 0) {
+      b = stk[sp - 1];
+      if (next[b] < bl[b].b_nsucc) {
+         c = bl[b].b_succ[next[b]++];
+         if (bl[c].b_rpo < 0) {
+            bl[c].b_rpo = 0;
+            stk[sp++] = c;
+         }
+      }
+      else
+         post[np++] = stk[--sp];
+   }
+   g->c_order = post;
+   g->c_norder = np;
+   for (i = 0; i < np / 2; i++) {
+      b = post[i];
+      post[i] = post[np - 1 - i];
+      post[np - 1 - i] = b;
+   }
+   for (i = 0; i < np; i++)
+      bl[post[i]].b_rpo = i;
+
+   bl[0].b_idom = 0;
+   do {
+      changed = 0;
+      for (i = 1; i < np; i++) {
+         b = post[i];
+         d = -1;
+         for (a = 0; a < bl[b].b_npred; a++) {
+            c = bl[b].b_pred[a];
+            if (bl[c].b_idom < 0)
+               continue;
+            if (d < 0) {
+               d = c;
+               continue;
+            }
+            while (c != d) {
+               while (bl[c].b_rpo > bl[d].b_rpo)
+                  c = bl[c].b_idom;
+               while (bl[d].b_rpo > bl[c].b_rpo)
+                  d = bl[d].b_idom;
+            }
+         }
+         if (bl[b].b_idom != d) {
+            bl[b].b_idom = d;
+            changed = 1;
+         }
+      }
+   } while (changed);
+   free(stk);
+   free(next);
+}
+
+/*
+ * cfgdominates - nonzero if block a dominates block b
+ */
+int cfgdominates(struct cfg *g, int a, int b)
+{
+   if (g->c_blocks[b].b_idom < 0)
+      return (0);
+   while (b != a && b != 0)
+      b = g->c_blocks[b].b_idom;
+   return (b == a);
+}
+
+/*
+ * cfgdf - find the dominance frontier of every reachable block of g
+ *
+ * A join b is in the frontier of each block from a predecessor of b up
+ * the dominator tree to, but not including, the immediate dominator of b
+ * (Cooper, Harvey and Kennedy again).
+ */
+void cfgdf(struct cfg *g)
+{
+   struct block *bl, *r;
+   int b, i, p, max;
+
+   cfgdom(g);
+   bl = g->c_blocks;
+   for (b = 0; b < g->c_nblocks; b++) {
+      if (bl[b].b_idom < 0 || bl[b].b_npred < 2)
+         continue;
+      for (i = 0; i < bl[b].b_npred; i++) {
+         for (p = bl[b].b_pred[i]; bl[p].b_idom >= 0 && p != bl[b].b_idom;
+              p = bl[p].b_idom) {
+            r = &bl[p];
+            if (r->b_ndf > 0 && r->b_df[r->b_ndf - 1] == b)
+               break;
+            if ((r->b_ndf & (r->b_ndf - 1)) == 0) {
+               max = r->b_ndf ? 2 * r->b_ndf : 1;
+               r->b_df = (int *) realloc(r->b_df, max * sizeof(int));
+               if (r->b_df == NULL) {
+                  fprintf(stderr, "csem: out of space\n");
+                  exit(1);
+               }
+            }
+            r->b_df[r->b_ndf++] = b;
+            if (p == 0)
+               break;
+         }
+      }
+   }
+}
+
+/*
+ * lcmp - order loops by size, so an inner loop comes before an outer one
+ */
+static int lcmp(const void *a, const void *b)
+{
+   const struct loop *la = a, *lb = b;
+
+   if (la->l_nblocks != lb->l_nblocks)
+      return (la->l_nblocks - lb->l_nblocks);
+   return (la->l_head - lb->l_head);
+}
+
+/*
+ * cfgloops - find the natural loops of g
+ *
+ * An edge from t to a block h dominating it is a back edge.  Its loop is
+ * h and the blocks that reach t without passing through h; back edges to
+ * one header make one loop.
+ */
+void cfgloops(struct cfg *g)
+{
+   struct block *bl;
+   struct loop *l;
+   char *in;
+   int *stk, sp, i, j, k, b, t, h;
+
+   cfgdom(g);
+   bl = g->c_blocks;
+   g->c_loops = (struct loop *) oalloc((g->c_nblocks + 1) * sizeof(struct loop));
+   g->c_nloops = 0;
+   in = oalloc(g->c_nblocks + 1);
+   stk = (int *) oalloc((g->c_nblocks + 1) * sizeof(int));
+   for (h = 0; h < g->c_nblocks; h++) {
+      sp = 0;
+      for (j = 0; j < bl[h].b_npred; j++) {
+         t = bl[h].b_pred[j];
+         if (cfgdominates(g, h, t) && !in[t]) {
+            in[t] = 1;
+            stk[sp++] = t;
+         }
+      }
+      if (sp == 0)
+         continue;
+      in[h] = 1;
+      while (sp > 0) {
+         b = stk[--sp];
+         if (b == h)
+            continue;
+         for (j = 0; j < bl[b].b_npred; j++) {
+            t = bl[b].b_pred[j];
+            if (!in[t] && bl[t].b_idom >= 0) {
+               in[t] = 1;
+               stk[sp++] = t;
+            }
+         }
+      }
+      l = &g->c_loops[g->c_nloops++];
+      l->l_head = h;
+      for (k = i = 0; i < g->c_nblocks; i++)
+         k += in[i];
+      l->l_blocks = (int *) oalloc(k * sizeof(int));
+      for (l->l_nblocks = i = 0; i < g->c_nblocks; i++)
+         if (in[i]) {
+            l->l_blocks[l->l_nblocks++] = i;
+            in[i] = 0;
+         }
+   }
+   qsort(g->c_loops, g->c_nloops, sizeof(struct loop), lcmp);
+   free(in);
+   free(stk);
+}
+
+/*
+ * cfgprint - print graph g on fp, a line per block
+ *
+ *    bn [first,last) Lm <- predecessors -> successors idom bk
+ *
+ * then a line per loop, if they have been found, with its header first.
+ */
+void cfgprint(FILE *fp, struct cfg *g)
+{
+   struct quad *q;
+   struct block *b;
+   struct loop *l;
+   int i;
+
+   q = g->c_f->f_quads;
+   fprintf(fp, "cfg %s: %d blocks\n",
+           g->c_f->f_nquads && q->q_op == Q_FUNC ? q->q_s : "?", g->c_nblocks);
+   for (b = g->c_blocks; b < &g->c_blocks[g->c_nblocks]; b++) {
+      fprintf(fp, "b%d [%d,%d)", (int) (b - g->c_blocks), b->b_first,
+              b->b_last);
+      if (q[b->b_first].q_op == Q_LABEL)
+         fprintf(fp, " L%d", q[b->b_first].q_n);
+      fprintf(fp, " <-");
+      for (i = 0; i < b->b_npred; i++)
+         fprintf(fp, " b%d", b->b_pred[i]);
+      fprintf(fp, " ->");
+      for (i = 0; i < b->b_nsucc; i++)
+         fprintf(fp, " b%d", b->b_succ[i]);
+      if (g->c_order && b->b_idom >= 0 && b != g->c_blocks)
+         fprintf(fp, " idom b%d", b->b_idom);
+      fprintf(fp, "\n");
+   }
+   for (l = g->c_loops; l < &g->c_loops[g->c_nloops]; l++) {
+      fprintf(fp, "loop b%d:", l->l_head);
+      for (i = 0; i < l->l_nblocks; i++)
+         fprintf(fp, " b%d", l->l_blocks[i]);
+      fprintf(fp, "\n");
+   }
+}
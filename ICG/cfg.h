@@ -0,0 +1,42 @@
+/* basic block, the quads b_first up to b_last of a function */
+struct block {
+   int b_first;			/* index of its first quad */
+   int b_last;			/* index one past its last quad */
+   int b_succ[2];		/* successor blocks */
+   int b_nsucc;			/* successors, none if it leaves the function */
+   int *b_pred;			/* predecessor blocks */
+   int b_npred;			/* predecessors */
+   int b_idom;			/* immediate dominator, -1 if unreachable */
+   int b_rpo;			/* place in reverse postorder */
+   int *b_df;			/* dominance frontier, once cfgdf has run */
+   int b_ndf;			/* blocks in b_df */
+};
+
+/* natural loop */
+struct loop {
+   int l_head;			/* header block */
+   int *l_blocks;		/* its blocks, in quad order */
+   int l_nblocks;		/* blocks in l_blocks */
+};
+
+/* control-flow graph of a function */
+struct cfg {
+   struct qfunc *c_f;		/* the function */
+   struct block *c_blocks;	/* its blocks, in quad order, entry first */
+   int c_nblocks;		/* blocks in c_blocks */
+   int *c_preds;		/* room for the b_pred lists */
+   int *c_order;		/* reachable blocks in reverse postorder */
+   int c_norder;		/* blocks in c_order */
+   struct loop *c_loops;	/* loops, inner before outer */
+   int c_nloops;		/* loops in c_loops */
+};
+
+extern int cfgdump;
+
+void cfgbuild(struct cfg *, struct qfunc *);
+void cfgfree(struct cfg *);
+void cfgdom(struct cfg *);
+int cfgdominates(struct cfg *, int, int);
+void cfgdf(struct cfg *);
+void cfgloops(struct cfg *);
+void cfgprint(FILE *, struct cfg *);
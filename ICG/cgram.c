@@ -1,22 +1,74 @@
-#ifndef lint
-static const char yysccsid[] = "@(#)yaccpar	1.9 (Berkeley) 02/21/93";
-#endif
+/* A Bison parser, made by GNU Bison 3.8.2.  */
+
+/* Bison implementation for Yacc-like parsers in C
+
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
+   Inc.
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
+
+/* As a special exception, you may create a larger work that contains
+   part or all of the Bison parser skeleton and distribute that work
+   under terms of your choice, so long as that work isn't itself a
+   parser generator using the skeleton or a modified version thereof
+   as a parser skeleton.  Alternatively, if you modify or redistribute
+   the parser skeleton itself, you may (at your option) remove this
+   special exception, which will cause the skeleton and the resulting
+   Bison output files to be licensed under the GNU General Public
+   License without this special exception.
+
+   This special exception was added by the Free Software Foundation in
+   version 2.2 of Bison.  */
+
+/* C LALR(1) parser skeleton written by Richard Stallman, by
+   simplifying the original so-called "semantic" parser.  */
+
+/* DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+   especially those whose name start with YY_ or yy_.  They are
+   private implementation details that can be changed or removed.  */
+
+/* All symbols defined below should begin with yy or YY, to avoid
+   infringing on user name space.  This should be done even for local
+   variables, as they might otherwise be expanded by user macros.
+   There are some unavoidable exceptions within include files to
+   define necessary library symbols; they are noted "INFRINGES ON
+   USER NAME SPACE" below.  */
+
+/* Identify Bison output, and Bison version.  */
+#define YYBISON 30802
+
+/* Bison version string.  */
+#define YYBISON_VERSION "3.8.2"
+
+/* Skeleton name.  */
+#define YYSKELETON_NAME "yacc.c"
+
+/* Pure parsers.  */
+#define YYPURE 2
+
+/* Push parsers.  */
+#define YYPUSH 0
 
-#define YYBYACC 1
-#define YYMAJOR 1
-#define YYMINOR 9
-#define YYPATCH 20111219
+/* Pull parsers.  */
+#define YYPULL 1
 
-#define YYEMPTY        (-1)
-#define yyclearin      (yychar = YYEMPTY)
-#define yyerrok        (yyerrflag = 0)
-#define YYRECOVERING() (yyerrflag != 0)
 
-#define YYPREFIX "yy"
 
-#define YYPURE 0
 
-#line 2 "cgram.y"
+/* First part of user prologue.  */
+#line 1 "cgram.y"
+
   /* grammar for subset of C. The grammar does not recognize all C syntax:
      For example:
      1. Character literals
@@ -32,1281 +84,2436 @@ static const char yysccsid[] = "@(#)yaccpar	1.9 (Berkeley) 02/21/93";
 # include "semutil.h"
 # include "sem.h"
 # include "sym.h"
-#line 19 "cgram.y"
-#ifdef YYSTYPE
-#undef  YYSTYPE_IS_DECLARED
-#define YYSTYPE_IS_DECLARED 1
+# include "quad.h"
+# include "opt.h"
+# include "cfg.h"
+# include "cache.h"
+# include "prof.h"
+# include "inline.h"
+# include "pool.h"
+# include "stats.h"
+# include "qbin.h"
+
+/* run semantic action a, timed as such for -p */
+# define SEM(a) do { int ph = tenter(PH_SEM); a; tenter(ph); } while (0)
+
+#line 101 "y.tab.c"
+
+# ifndef YY_CAST
+#  ifdef __cplusplus
+#   define YY_CAST(Type, Val) static_cast<Type> (Val)
+#   define YY_REINTERPRET_CAST(Type, Val) reinterpret_cast<Type> (Val)
+#  else
+#   define YY_CAST(Type, Val) ((Type) (Val))
+#   define YY_REINTERPRET_CAST(Type, Val) ((Type) (Val))
+#  endif
+# endif
+# ifndef YY_NULLPTR
+#  if defined __cplusplus
+#   if 201103L <= __cplusplus
+#    define YY_NULLPTR nullptr
+#   else
+#    define YY_NULLPTR 0
+#   endif
+#  else
+#   define YY_NULLPTR ((void*)0)
+#  endif
+# endif
+
+/* Use api.header.include to #include this header
+   instead of duplicating it here.  */
+#ifndef YY_YY_Y_TAB_H_INCLUDED
+# define YY_YY_Y_TAB_H_INCLUDED
+/* Debug traces.  */
+#ifndef YYDEBUG
+# define YYDEBUG 0
 #endif
-#ifndef YYSTYPE_IS_DECLARED
-#define YYSTYPE_IS_DECLARED 1
-typedef union {
+#if YYDEBUG
+extern int yydebug;
+#endif
+
+/* Token kinds.  */
+#ifndef YYTOKENTYPE
+# define YYTOKENTYPE
+  enum yytokentype
+  {
+    YYEMPTY = -2,
+    YYEOF = 0,                     /* "end of file"  */
+    YYerror = 256,                 /* error  */
+    YYUNDEF = 257,                 /* "invalid token"  */
+    ID = 258,                      /* ID  */
+    CON = 259,                     /* CON  */
+    STR = 260,                     /* STR  */
+    CHAR = 261,                    /* CHAR  */
+    ELSE = 262,                    /* ELSE  */
+    FLOAT = 263,                   /* FLOAT  */
+    DOUBLE = 264,                  /* DOUBLE  */
+    FOR = 265,                     /* FOR  */
+    IF = 266,                      /* IF  */
+    INT = 267,                     /* INT  */
+    RESERVED = 268,                /* RESERVED  */
+    RETURN = 269,                  /* RETURN  */
+    WHILE = 270,                   /* WHILE  */
+    DO = 271,                      /* DO  */
+    CONTINUE = 272,                /* CONTINUE  */
+    BREAK = 273,                   /* BREAK  */
+    GOTO = 274,                    /* GOTO  */
+    LVAL = 275,                    /* LVAL  */
+    SET = 276,                     /* SET  */
+    SETOR = 277,                   /* SETOR  */
+    SETXOR = 278,                  /* SETXOR  */
+    SETAND = 279,                  /* SETAND  */
+    SETLSH = 280,                  /* SETLSH  */
+    SETRSH = 281,                  /* SETRSH  */
+    SETADD = 282,                  /* SETADD  */
+    SETSUB = 283,                  /* SETSUB  */
+    SETMUL = 284,                  /* SETMUL  */
+    SETDIV = 285,                  /* SETDIV  */
+    SETMOD = 286,                  /* SETMOD  */
+    OR = 287,                      /* OR  */
+    AND = 288,                     /* AND  */
+    BITOR = 289,                   /* BITOR  */
+    BITXOR = 290,                  /* BITXOR  */
+    BITAND = 291,                  /* BITAND  */
+    EQ = 292,                      /* EQ  */
+    NE = 293,                      /* NE  */
+    GT = 294,                      /* GT  */
+    GE = 295,                      /* GE  */
+    LT = 296,                      /* LT  */
+    LE = 297,                      /* LE  */
+    LSH = 298,                     /* LSH  */
+    RSH = 299,                     /* RSH  */
+    ADD = 300,                     /* ADD  */
+    SUB = 301,                     /* SUB  */
+    MUL = 302,                     /* MUL  */
+    DIV = 303,                     /* DIV  */
+    MOD = 304,                     /* MOD  */
+    UNARY = 305,                   /* UNARY  */
+    NOT = 306,                     /* NOT  */
+    COM = 307                      /* COM  */
+  };
+  typedef enum yytokentype yytoken_kind_t;
+#endif
+/* Token kinds.  */
+#define YYEMPTY -2
+#define YYEOF 0
+#define YYerror 256
+#define YYUNDEF 257
+#define ID 258
+#define CON 259
+#define STR 260
+#define CHAR 261
+#define ELSE 262
+#define FLOAT 263
+#define DOUBLE 264
+#define FOR 265
+#define IF 266
+#define INT 267
+#define RESERVED 268
+#define RETURN 269
+#define WHILE 270
+#define DO 271
+#define CONTINUE 272
+#define BREAK 273
+#define GOTO 274
+#define LVAL 275
+#define SET 276
+#define SETOR 277
+#define SETXOR 278
+#define SETAND 279
+#define SETLSH 280
+#define SETRSH 281
+#define SETADD 282
+#define SETSUB 283
+#define SETMUL 284
+#define SETDIV 285
+#define SETMOD 286
+#define OR 287
+#define AND 288
+#define BITOR 289
+#define BITXOR 290
+#define BITAND 291
+#define EQ 292
+#define NE 293
+#define GT 294
+#define GE 295
+#define LT 296
+#define LE 297
+#define LSH 298
+#define RSH 299
+#define ADD 300
+#define SUB 301
+#define MUL 302
+#define DIV 303
+#define MOD 304
+#define UNARY 305
+#define NOT 306
+#define COM 307
+
+/* Value type.  */
+#if ! defined YYSTYPE && ! defined YYSTYPE_IS_DECLARED
+union YYSTYPE
+{
+#line 32 "cgram.y"
+
    int inttype;
    char *str_ptr;
    struct sem_rec *rec_ptr;
    struct id_entry *id_ptr;
-} YYSTYPE;
-#endif /* !YYSTYPE_IS_DECLARED */
-#line 49 "y.tab.c"
-
-/* compatibility with bison */
-#ifdef YYPARSE_PARAM
-/* compatibility with FreeBSD */
-# ifdef YYPARSE_PARAM_TYPE
-#  define YYPARSE_DECL() yyparse(YYPARSE_PARAM_TYPE YYPARSE_PARAM)
+
+#line 265 "y.tab.c"
+
+};
+typedef union YYSTYPE YYSTYPE;
+# define YYSTYPE_IS_TRIVIAL 1
+# define YYSTYPE_IS_DECLARED 1
+#endif
+
+
+
+
+int yyparse (void);
+
+
+#endif /* !YY_YY_Y_TAB_H_INCLUDED  */
+/* Symbol kind.  */
+enum yysymbol_kind_t
+{
+  YYSYMBOL_YYEMPTY = -2,
+  YYSYMBOL_YYEOF = 0,                      /* "end of file"  */
+  YYSYMBOL_YYerror = 1,                    /* error  */
+  YYSYMBOL_YYUNDEF = 2,                    /* "invalid token"  */
+  YYSYMBOL_ID = 3,                         /* ID  */
+  YYSYMBOL_CON = 4,                        /* CON  */
+  YYSYMBOL_STR = 5,                        /* STR  */
+  YYSYMBOL_CHAR = 6,                       /* CHAR  */
+  YYSYMBOL_ELSE = 7,                       /* ELSE  */
+  YYSYMBOL_FLOAT = 8,                      /* FLOAT  */
+  YYSYMBOL_DOUBLE = 9,                     /* DOUBLE  */
+  YYSYMBOL_FOR = 10,                       /* FOR  */
+  YYSYMBOL_IF = 11,                        /* IF  */
+  YYSYMBOL_INT = 12,                       /* INT  */
+  YYSYMBOL_RESERVED = 13,                  /* RESERVED  */
+  YYSYMBOL_RETURN = 14,                    /* RETURN  */
+  YYSYMBOL_WHILE = 15,                     /* WHILE  */
+  YYSYMBOL_DO = 16,                        /* DO  */
+  YYSYMBOL_CONTINUE = 17,                  /* CONTINUE  */
+  YYSYMBOL_BREAK = 18,                     /* BREAK  */
+  YYSYMBOL_GOTO = 19,                      /* GOTO  */
+  YYSYMBOL_LVAL = 20,                      /* LVAL  */
+  YYSYMBOL_SET = 21,                       /* SET  */
+  YYSYMBOL_SETOR = 22,                     /* SETOR  */
+  YYSYMBOL_SETXOR = 23,                    /* SETXOR  */
+  YYSYMBOL_SETAND = 24,                    /* SETAND  */
+  YYSYMBOL_SETLSH = 25,                    /* SETLSH  */
+  YYSYMBOL_SETRSH = 26,                    /* SETRSH  */
+  YYSYMBOL_SETADD = 27,                    /* SETADD  */
+  YYSYMBOL_SETSUB = 28,                    /* SETSUB  */
+  YYSYMBOL_SETMUL = 29,                    /* SETMUL  */
+  YYSYMBOL_SETDIV = 30,                    /* SETDIV  */
+  YYSYMBOL_SETMOD = 31,                    /* SETMOD  */
+  YYSYMBOL_OR = 32,                        /* OR  */
+  YYSYMBOL_AND = 33,                       /* AND  */
+  YYSYMBOL_BITOR = 34,                     /* BITOR  */
+  YYSYMBOL_BITXOR = 35,                    /* BITXOR  */
+  YYSYMBOL_BITAND = 36,                    /* BITAND  */
+  YYSYMBOL_EQ = 37,                        /* EQ  */
+  YYSYMBOL_NE = 38,                        /* NE  */
+  YYSYMBOL_GT = 39,                        /* GT  */
+  YYSYMBOL_GE = 40,                        /* GE  */
+  YYSYMBOL_LT = 41,                        /* LT  */
+  YYSYMBOL_LE = 42,                        /* LE  */
+  YYSYMBOL_LSH = 43,                       /* LSH  */
+  YYSYMBOL_RSH = 44,                       /* RSH  */
+  YYSYMBOL_ADD = 45,                       /* ADD  */
+  YYSYMBOL_SUB = 46,                       /* SUB  */
+  YYSYMBOL_MUL = 47,                       /* MUL  */
+  YYSYMBOL_DIV = 48,                       /* DIV  */
+  YYSYMBOL_MOD = 49,                       /* MOD  */
+  YYSYMBOL_UNARY = 50,                     /* UNARY  */
+  YYSYMBOL_NOT = 51,                       /* NOT  */
+  YYSYMBOL_COM = 52,                       /* COM  */
+  YYSYMBOL_53_ = 53,                       /* ';'  */
+  YYSYMBOL_54_ = 54,                       /* ','  */
+  YYSYMBOL_55_ = 55,                       /* '['  */
+  YYSYMBOL_56_ = 56,                       /* ']'  */
+  YYSYMBOL_57_ = 57,                       /* '}'  */
+  YYSYMBOL_58_ = 58,                       /* '{'  */
+  YYSYMBOL_59_ = 59,                       /* '('  */
+  YYSYMBOL_60_ = 60,                       /* ')'  */
+  YYSYMBOL_61_ = 61,                       /* ':'  */
+  YYSYMBOL_YYACCEPT = 62,                  /* $accept  */
+  YYSYMBOL_prog = 63,                      /* prog  */
+  YYSYMBOL_externs = 64,                   /* externs  */
+  YYSYMBOL_extern = 65,                    /* extern  */
+  YYSYMBOL_dcls = 66,                      /* dcls  */
+  YYSYMBOL_dcl = 67,                       /* dcl  */
+  YYSYMBOL_dclr = 68,                      /* dclr  */
+  YYSYMBOL_type = 69,                      /* type  */
+  YYSYMBOL_func = 70,                      /* func  */
+  YYSYMBOL_fhead = 71,                     /* fhead  */
+  YYSYMBOL_fname = 72,                     /* fname  */
+  YYSYMBOL_fargs = 73,                     /* fargs  */
+  YYSYMBOL_args = 74,                      /* args  */
+  YYSYMBOL_s = 75,                         /* s  */
+  YYSYMBOL_m = 76,                         /* m  */
+  YYSYMBOL_n = 77,                         /* n  */
+  YYSYMBOL_block = 78,                     /* block  */
+  YYSYMBOL_stmts = 79,                     /* stmts  */
+  YYSYMBOL_lblstmt = 80,                   /* lblstmt  */
+  YYSYMBOL_labels = 81,                    /* labels  */
+  YYSYMBOL_b = 82,                         /* b  */
+  YYSYMBOL_stmt = 83,                      /* stmt  */
+  YYSYMBOL_cexpro = 84,                    /* cexpro  */
+  YYSYMBOL_cexpr = 85,                     /* cexpr  */
+  YYSYMBOL_exprs = 86,                     /* exprs  */
+  YYSYMBOL_expro = 87,                     /* expro  */
+  YYSYMBOL_expr = 88,                      /* expr  */
+  YYSYMBOL_lval = 89                       /* lval  */
+};
+typedef enum yysymbol_kind_t yysymbol_kind_t;
+
+
+
+
+#ifdef short
+# undef short
+#endif
+
+/* On compilers that do not define __PTRDIFF_MAX__ etc., make sure
+   <limits.h> and (if available) <stdint.h> are included
+   so that the code can choose integer types of a good width.  */
+
+#ifndef __PTRDIFF_MAX__
+# include <limits.h> /* INFRINGES ON USER NAME SPACE */
+# if defined __STDC_VERSION__ && 199901 <= __STDC_VERSION__
+#  include <stdint.h> /* INFRINGES ON USER NAME SPACE */
+#  define YY_STDINT_H
+# endif
+#endif
+
+/* Narrow types that promote to a signed type and that can represent a
+   signed or unsigned integer of at least N bits.  In tables they can
+   save space and decrease cache pressure.  Promoting to a signed type
+   helps avoid bugs in integer arithmetic.  */
+
+#ifdef __INT_LEAST8_MAX__
+typedef __INT_LEAST8_TYPE__ yytype_int8;
+#elif defined YY_STDINT_H
+typedef int_least8_t yytype_int8;
+#else
+typedef signed char yytype_int8;
+#endif
+
+#ifdef __INT_LEAST16_MAX__
+typedef __INT_LEAST16_TYPE__ yytype_int16;
+#elif defined YY_STDINT_H
+typedef int_least16_t yytype_int16;
+#else
+typedef short yytype_int16;
+#endif
+
+/* Work around bug in HP-UX 11.23, which defines these macros
+   incorrectly for preprocessor constants.  This workaround can likely
+   be removed in 2023, as HPE has promised support for HP-UX 11.23
+   (aka HP-UX 11i v2) only through the end of 2022; see Table 2 of
+   <https://h20195.www2.hpe.com/V2/getpdf.aspx/4AA4-7673ENW.pdf>.  */
+#ifdef __hpux
+# undef UINT_LEAST8_MAX
+# undef UINT_LEAST16_MAX
+# define UINT_LEAST8_MAX 255
+# define UINT_LEAST16_MAX 65535
+#endif
+
+#if defined __UINT_LEAST8_MAX__ && __UINT_LEAST8_MAX__ <= __INT_MAX__
+typedef __UINT_LEAST8_TYPE__ yytype_uint8;
+#elif (!defined __UINT_LEAST8_MAX__ && defined YY_STDINT_H \
+       && UINT_LEAST8_MAX <= INT_MAX)
+typedef uint_least8_t yytype_uint8;
+#elif !defined __UINT_LEAST8_MAX__ && UCHAR_MAX <= INT_MAX
+typedef unsigned char yytype_uint8;
+#else
+typedef short yytype_uint8;
+#endif
+
+#if defined __UINT_LEAST16_MAX__ && __UINT_LEAST16_MAX__ <= __INT_MAX__
+typedef __UINT_LEAST16_TYPE__ yytype_uint16;
+#elif (!defined __UINT_LEAST16_MAX__ && defined YY_STDINT_H \
+       && UINT_LEAST16_MAX <= INT_MAX)
+typedef uint_least16_t yytype_uint16;
+#elif !defined __UINT_LEAST16_MAX__ && USHRT_MAX <= INT_MAX
+typedef unsigned short yytype_uint16;
+#else
+typedef int yytype_uint16;
+#endif
+
+#ifndef YYPTRDIFF_T
+# if defined __PTRDIFF_TYPE__ && defined __PTRDIFF_MAX__
+#  define YYPTRDIFF_T __PTRDIFF_TYPE__
+#  define YYPTRDIFF_MAXIMUM __PTRDIFF_MAX__
+# elif defined PTRDIFF_MAX
+#  ifndef ptrdiff_t
+#   include <stddef.h> /* INFRINGES ON USER NAME SPACE */
+#  endif
+#  define YYPTRDIFF_T ptrdiff_t
+#  define YYPTRDIFF_MAXIMUM PTRDIFF_MAX
+# else
+#  define YYPTRDIFF_T long
+#  define YYPTRDIFF_MAXIMUM LONG_MAX
+# endif
+#endif
+
+#ifndef YYSIZE_T
+# ifdef __SIZE_TYPE__
+#  define YYSIZE_T __SIZE_TYPE__
+# elif defined size_t
+#  define YYSIZE_T size_t
+# elif defined __STDC_VERSION__ && 199901 <= __STDC_VERSION__
+#  include <stddef.h> /* INFRINGES ON USER NAME SPACE */
+#  define YYSIZE_T size_t
 # else
-#  define YYPARSE_DECL() yyparse(void *YYPARSE_PARAM)
+#  define YYSIZE_T unsigned
 # endif
+#endif
+
+#define YYSIZE_MAXIMUM                                  \
+  YY_CAST (YYPTRDIFF_T,                                 \
+           (YYPTRDIFF_MAXIMUM < YY_CAST (YYSIZE_T, -1)  \
+            ? YYPTRDIFF_MAXIMUM                         \
+            : YY_CAST (YYSIZE_T, -1)))
+
+#define YYSIZEOF(X) YY_CAST (YYPTRDIFF_T, sizeof (X))
+
+
+/* Stored state numbers (used for stacks). */
+typedef yytype_uint8 yy_state_t;
+
+/* State numbers in computations.  */
+typedef int yy_state_fast_t;
+
+#ifndef YY_
+# if defined YYENABLE_NLS && YYENABLE_NLS
+#  if ENABLE_NLS
+#   include <libintl.h> /* INFRINGES ON USER NAME SPACE */
+#   define YY_(Msgid) dgettext ("bison-runtime", Msgid)
+#  endif
+# endif
+# ifndef YY_
+#  define YY_(Msgid) Msgid
+# endif
+#endif
+
+
+#ifndef YY_ATTRIBUTE_PURE
+# if defined __GNUC__ && 2 < __GNUC__ + (96 <= __GNUC_MINOR__)
+#  define YY_ATTRIBUTE_PURE __attribute__ ((__pure__))
+# else
+#  define YY_ATTRIBUTE_PURE
+# endif
+#endif
+
+#ifndef YY_ATTRIBUTE_UNUSED
+# if defined __GNUC__ && 2 < __GNUC__ + (7 <= __GNUC_MINOR__)
+#  define YY_ATTRIBUTE_UNUSED __attribute__ ((__unused__))
+# else
+#  define YY_ATTRIBUTE_UNUSED
+# endif
+#endif
+
+/* Suppress unused-variable warnings by "using" E.  */
+#if ! defined lint || defined __GNUC__
+# define YY_USE(E) ((void) (E))
 #else
-# define YYPARSE_DECL() yyparse(void)
+# define YY_USE(E) /* empty */
 #endif
 
-/* Parameters sent to lex. */
-#ifdef YYLEX_PARAM
-# define YYLEX_DECL() yylex(void *YYLEX_PARAM)
-# define YYLEX yylex(YYLEX_PARAM)
+/* Suppress an incorrect diagnostic about yylval being uninitialized.  */
+#if defined __GNUC__ && ! defined __ICC && 406 <= __GNUC__ * 100 + __GNUC_MINOR__
+# if __GNUC__ * 100 + __GNUC_MINOR__ < 407
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")
+# else
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")              \
+    _Pragma ("GCC diagnostic ignored \"-Wmaybe-uninitialized\"")
+# endif
+# define YY_IGNORE_MAYBE_UNINITIALIZED_END      \
+    _Pragma ("GCC diagnostic pop")
 #else
-# define YYLEX_DECL() yylex(void)
-# define YYLEX yylex()
+# define YY_INITIAL_VALUE(Value) Value
 #endif
+#ifndef YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+# define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+# define YY_IGNORE_MAYBE_UNINITIALIZED_END
+#endif
+#ifndef YY_INITIAL_VALUE
+# define YY_INITIAL_VALUE(Value) /* Nothing. */
+#endif
+
+#if defined __cplusplus && defined __GNUC__ && ! defined __ICC && 6 <= __GNUC__
+# define YY_IGNORE_USELESS_CAST_BEGIN                          \
+    _Pragma ("GCC diagnostic push")                            \
+    _Pragma ("GCC diagnostic ignored \"-Wuseless-cast\"")
+# define YY_IGNORE_USELESS_CAST_END            \
+    _Pragma ("GCC diagnostic pop")
+#endif
+#ifndef YY_IGNORE_USELESS_CAST_BEGIN
+# define YY_IGNORE_USELESS_CAST_BEGIN
+# define YY_IGNORE_USELESS_CAST_END
+#endif
+
+
+#define YY_ASSERT(E) ((void) (0 && (E)))
+
+#if !defined yyoverflow
+
+/* The parser invokes alloca or malloc; define the necessary symbols.  */
+
+# ifdef YYSTACK_USE_ALLOCA
+#  if YYSTACK_USE_ALLOCA
+#   ifdef __GNUC__
+#    define YYSTACK_ALLOC __builtin_alloca
+#   elif defined __BUILTIN_VA_ARG_INCR
+#    include <alloca.h> /* INFRINGES ON USER NAME SPACE */
+#   elif defined _AIX
+#    define YYSTACK_ALLOC __alloca
+#   elif defined _MSC_VER
+#    include <malloc.h> /* INFRINGES ON USER NAME SPACE */
+#    define alloca _alloca
+#   else
+#    define YYSTACK_ALLOC alloca
+#    if ! defined _ALLOCA_H && ! defined EXIT_SUCCESS
+#     include <stdlib.h> /* INFRINGES ON USER NAME SPACE */
+      /* Use EXIT_SUCCESS as a witness for stdlib.h.  */
+#     ifndef EXIT_SUCCESS
+#      define EXIT_SUCCESS 0
+#     endif
+#    endif
+#   endif
+#  endif
+# endif
+
+# ifdef YYSTACK_ALLOC
+   /* Pacify GCC's 'empty if-body' warning.  */
+#  define YYSTACK_FREE(Ptr) do { /* empty */; } while (0)
+#  ifndef YYSTACK_ALLOC_MAXIMUM
+    /* The OS might guarantee only one guard page at the bottom of the stack,
+       and a page size can be as small as 4096 bytes.  So we cannot safely
+       invoke alloca (N) if N exceeds 4096.  Use a slightly smaller number
+       to allow for a few compiler-allocated temporary stack slots.  */
+#   define YYSTACK_ALLOC_MAXIMUM 4032 /* reasonable circa 2006 */
+#  endif
+# else
+#  define YYSTACK_ALLOC YYMALLOC
+#  define YYSTACK_FREE YYFREE
+#  ifndef YYSTACK_ALLOC_MAXIMUM
+#   define YYSTACK_ALLOC_MAXIMUM YYSIZE_MAXIMUM
+#  endif
+#  if (defined __cplusplus && ! defined EXIT_SUCCESS \
+       && ! ((defined YYMALLOC || defined malloc) \
+             && (defined YYFREE || defined free)))
+#   include <stdlib.h> /* INFRINGES ON USER NAME SPACE */
+#   ifndef EXIT_SUCCESS
+#    define EXIT_SUCCESS 0
+#   endif
+#  endif
+#  ifndef YYMALLOC
+#   define YYMALLOC malloc
+#   if ! defined malloc && ! defined EXIT_SUCCESS
+void *malloc (YYSIZE_T); /* INFRINGES ON USER NAME SPACE */
+#   endif
+#  endif
+#  ifndef YYFREE
+#   define YYFREE free
+#   if ! defined free && ! defined EXIT_SUCCESS
+void free (void *); /* INFRINGES ON USER NAME SPACE */
+#   endif
+#  endif
+# endif
+#endif /* !defined yyoverflow */
+
+#if (! defined yyoverflow \
+     && (! defined __cplusplus \
+         || (defined YYSTYPE_IS_TRIVIAL && YYSTYPE_IS_TRIVIAL)))
+
+/* A type that is properly aligned for any stack member.  */
+union yyalloc
+{
+  yy_state_t yyss_alloc;
+  YYSTYPE yyvs_alloc;
+};
+
+/* The size of the maximum gap between one aligned stack and the next.  */
+# define YYSTACK_GAP_MAXIMUM (YYSIZEOF (union yyalloc) - 1)
+
+/* The size of an array large to enough to hold all stacks, each with
+   N elements.  */
+# define YYSTACK_BYTES(N) \
+     ((N) * (YYSIZEOF (yy_state_t) + YYSIZEOF (YYSTYPE)) \
+      + YYSTACK_GAP_MAXIMUM)
+
+# define YYCOPY_NEEDED 1
+
+/* Relocate STACK from its old location to the new one.  The
+   local variables YYSIZE and YYSTACKSIZE give the old and new number of
+   elements in the stack, and YYPTR gives the new location of the
+   stack.  Advance YYPTR to a properly aligned location for the next
+   stack.  */
+# define YYSTACK_RELOCATE(Stack_alloc, Stack)                           \
+    do                                                                  \
+      {                                                                 \
+        YYPTRDIFF_T yynewbytes;                                         \
+        YYCOPY (&yyptr->Stack_alloc, Stack, yysize);                    \
+        Stack = &yyptr->Stack_alloc;                                    \
+        yynewbytes = yystacksize * YYSIZEOF (*Stack) + YYSTACK_GAP_MAXIMUM; \
+        yyptr += yynewbytes / YYSIZEOF (*yyptr);                        \
+      }                                                                 \
+    while (0)
+
+#endif
+
+#if defined YYCOPY_NEEDED && YYCOPY_NEEDED
+/* Copy COUNT objects from SRC to DST.  The source and destination do
+   not overlap.  */
+# ifndef YYCOPY
+#  if defined __GNUC__ && 1 < __GNUC__
+#   define YYCOPY(Dst, Src, Count) \
+      __builtin_memcpy (Dst, Src, YY_CAST (YYSIZE_T, (Count)) * sizeof (*(Src)))
+#  else
+#   define YYCOPY(Dst, Src, Count)              \
+      do                                        \
+        {                                       \
+          YYPTRDIFF_T yyi;                      \
+          for (yyi = 0; yyi < (Count); yyi++)   \
+            (Dst)[yyi] = (Src)[yyi];            \
+        }                                       \
+      while (0)
+#  endif
+# endif
+#endif /* !YYCOPY_NEEDED */
+
+/* YYFINAL -- State number of the termination state.  */
+#define YYFINAL  3
+/* YYLAST -- Last index in YYTABLE.  */
+#define YYLAST   393
+
+/* YYNTOKENS -- Number of terminals.  */
+#define YYNTOKENS  62
+/* YYNNTS -- Number of nonterminals.  */
+#define YYNNTS  28
+/* YYNRULES -- Number of rules.  */
+#define YYNRULES  97
+/* YYNSTATES -- Number of states.  */
+#define YYNSTATES  207
+
+/* YYMAXUTOK -- Last valid token kind.  */
+#define YYMAXUTOK   307
+
+
+/* YYTRANSLATE(TOKEN-NUM) -- Symbol number corresponding to TOKEN-NUM
+   as returned by yylex, with out-of-bounds checking.  */
+#define YYTRANSLATE(YYX)                                \
+  (0 <= (YYX) && (YYX) <= YYMAXUTOK                     \
+   ? YY_CAST (yysymbol_kind_t, yytranslate[YYX])        \
+   : YYSYMBOL_YYUNDEF)
 
-/* Parameters sent to yyerror. */
-#define YYERROR_DECL() yyerror(const char *s)
-#define YYERROR_CALL(msg) yyerror(msg)
-
-extern int YYPARSE_DECL();
-
-#define ID 257
-#define CON 258
-#define STR 259
-#define CHAR 260
-#define ELSE 261
-#define FLOAT 262
-#define DOUBLE 263
-#define FOR 264
-#define IF 265
-#define INT 266
-#define RESERVED 267
-#define RETURN 268
-#define WHILE 269
-#define DO 270
-#define CONTINUE 271
-#define BREAK 272
-#define GOTO 273
-#define LVAL 274
-#define SET 275
-#define SETOR 276
-#define SETXOR 277
-#define SETAND 278
-#define SETLSH 279
-#define SETRSH 280
-#define SETADD 281
-#define SETSUB 282
-#define SETMUL 283
-#define SETDIV 284
-#define SETMOD 285
-#define OR 286
-#define AND 287
-#define BITOR 288
-#define BITXOR 289
-#define BITAND 290
-#define EQ 291
-#define NE 292
-#define GT 293
-#define GE 294
-#define LT 295
-#define LE 296
-#define LSH 297
-#define RSH 298
-#define ADD 299
-#define SUB 300
-#define MUL 301
-#define DIV 302
-#define MOD 303
-#define UNARY 304
-#define NOT 305
-#define COM 306
-#define YYERRCODE 256
-static const short yylhs[] = {                           -1,
-    0,   12,   12,   13,   13,   15,   15,    7,    7,    8,
-    8,    8,   10,   10,   10,   10,   14,   16,    9,    9,
-   18,   18,   19,   19,   20,   11,    5,   21,   17,   17,
-   22,   22,   25,   25,   23,   24,   24,   24,   24,   24,
-   24,   24,   24,   24,   24,   24,   24,   24,    6,    6,
-    4,    4,    4,    4,    4,    4,    4,    4,    4,    4,
-    3,    3,   26,   26,    2,    2,    2,    2,    2,    2,
-    2,    2,    2,    2,    2,    2,    2,    2,    2,    2,
-    2,    2,    2,    2,    2,    2,    2,    2,    2,    2,
-    2,    2,    2,    2,    1,    1,
+/* YYTRANSLATE[TOKEN-NUM] -- Symbol number corresponding to TOKEN-NUM
+   as returned by yylex.  */
+static const yytype_int8 yytranslate[] =
+{
+       0,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+      59,    60,     2,     2,    54,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,    61,    53,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,    55,     2,    56,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,    58,     2,    57,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     1,     2,     3,     4,
+       5,     6,     7,     8,     9,    10,    11,    12,    13,    14,
+      15,    16,    17,    18,    19,    20,    21,    22,    23,    24,
+      25,    26,    27,    28,    29,    30,    31,    32,    33,    34,
+      35,    36,    37,    38,    39,    40,    41,    42,    43,    44,
+      45,    46,    47,    48,    49,    50,    51,    52
 };
-static const short yylen[] = {                            2,
-    1,    0,    2,    2,    1,    0,    3,    2,    3,    1,
-    3,    4,    1,    1,    1,    1,    3,    4,    2,    1,
-    2,    3,    2,    4,    0,    0,    0,    3,    0,    2,
-    2,    3,    2,    3,    0,    2,    7,   11,   10,   11,
-   16,    2,    2,    3,    2,    3,    1,    1,    0,    1,
-    3,    3,    3,    3,    3,    3,    4,    4,    2,    1,
-    1,    3,    0,    1,    3,    3,    3,    3,    3,    3,
-    3,    3,    3,    3,    3,    3,    3,    3,    3,    3,
-    3,    3,    3,    3,    3,    2,    2,    2,    1,    3,
-    4,    3,    1,    1,    1,    4,
+
+#if YYDEBUG
+/* YYRLINE[YYN] -- Source line where rule number YYN was defined.  */
+static const yytype_uint8 yyrline[] =
+{
+       0,    58,    58,    61,    62,    65,    66,    69,    70,    73,
+      74,    77,    78,    79,    82,    83,    84,    85,    88,    91,
+      94,    95,    98,    99,   102,   103,   106,   109,   112,   115,
+     118,   119,   122,   123,   126,   127,   130,   133,   135,   137,
+     139,   141,   143,   145,   147,   149,   151,   153,   155,   157,
+     161,   162,   165,   166,   167,   168,   169,   170,   171,   172,
+     173,   174,   177,   178,   181,   182,   185,   186,   187,   188,
+     189,   190,   191,   192,   193,   194,   195,   196,   197,   198,
+     199,   200,   201,   202,   203,   204,   205,   206,   208,   209,
+     210,   211,   212,   213,   214,   215,   218,   219
 };
-static const short yydefred[] = {                         2,
-    0,    0,   20,   13,   14,   15,   16,    0,    0,    0,
-    3,    5,   29,    4,    0,    0,    0,    0,    8,    0,
-    0,    9,   21,    0,    0,    6,    0,   17,   30,    0,
-   23,    0,   22,    0,    0,   11,    0,   93,   94,    0,
-    0,    0,    0,   26,    0,    0,    0,    0,    0,    0,
-   48,   29,    0,    0,    0,   47,   31,    0,    0,    0,
-    0,   12,    0,    0,   33,    0,    0,    0,   45,    0,
-   26,   25,   42,   43,    0,    0,   86,   87,   88,    0,
-    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
-    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
-    0,    0,   36,    0,   32,   24,    7,    0,   90,    0,
-    0,    0,    0,    0,    0,    0,   46,    0,   35,   44,
-   28,   92,    0,    0,    0,    0,    0,    0,    0,    0,
-    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
-   83,   84,   85,   34,   96,    0,   91,   26,   59,    0,
-    0,    0,    0,    0,    0,   26,   26,   26,    0,    0,
-    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
-   35,   26,    0,    0,    0,    0,   57,    0,   25,   26,
-   26,   27,   37,   35,    0,    0,   26,   27,    0,   27,
-   35,   26,    0,    0,   26,   39,   26,   26,   38,   40,
-   25,   35,   27,   26,   41,
+#endif
+
+/** Accessing symbol of state STATE.  */
+#define YY_ACCESSING_SYMBOL(State) YY_CAST (yysymbol_kind_t, yystos[State])
+
+#if YYDEBUG || 0
+/* The user-facing name of the symbol whose (internal) number is
+   YYSYMBOL.  No bounds checking.  */
+static const char *yysymbol_name (yysymbol_kind_t yysymbol) YY_ATTRIBUTE_UNUSED;
+
+/* YYTNAME[SYMBOL-NUM] -- String name of the symbol SYMBOL-NUM.
+   First, the terminals, then, starting at YYNTOKENS, nonterminals.  */
+static const char *const yytname[] =
+{
+  "\"end of file\"", "error", "\"invalid token\"", "ID", "CON", "STR",
+  "CHAR", "ELSE", "FLOAT", "DOUBLE", "FOR", "IF", "INT", "RESERVED",
+  "RETURN", "WHILE", "DO", "CONTINUE", "BREAK", "GOTO", "LVAL", "SET",
+  "SETOR", "SETXOR", "SETAND", "SETLSH", "SETRSH", "SETADD", "SETSUB",
+  "SETMUL", "SETDIV", "SETMOD", "OR", "AND", "BITOR", "BITXOR", "BITAND",
+  "EQ", "NE", "GT", "GE", "LT", "LE", "LSH", "RSH", "ADD", "SUB", "MUL",
+  "DIV", "MOD", "UNARY", "NOT", "COM", "';'", "','", "'['", "']'", "'}'",
+  "'{'", "'('", "')'", "':'", "$accept", "prog", "externs", "extern",
+  "dcls", "dcl", "dclr", "type", "func", "fhead", "fname", "fargs", "args",
+  "s", "m", "n", "block", "stmts", "lblstmt", "labels", "b", "stmt",
+  "cexpro", "cexpr", "exprs", "expro", "expr", "lval", YY_NULLPTR
 };
-static const short yydgoto[] = {                          1,
-   54,  115,  111,  116,  187,  175,    8,   19,    9,   10,
-   72,    2,   11,   12,   34,   13,   20,   17,   25,  119,
-   56,   29,   30,   57,   58,  113,
+
+static const char *
+yysymbol_name (yysymbol_kind_t yysymbol)
+{
+  return yytname[yysymbol];
+}
+#endif
+
+#define YYPACT_NINF (-177)
+
+#define yypact_value_is_default(Yyn) \
+  ((Yyn) == YYPACT_NINF)
+
+#define YYTABLE_NINF (-21)
+
+#define yytable_value_is_error(Yyn) \
+  0
+
+/* YYPACT[STATE-NUM] -- Index in YYTABLE of the portion describing
+   STATE-NUM.  */
+static const yytype_int16 yypact[] =
+{
+    -177,    21,   113,  -177,  -177,  -177,  -177,  -177,  -177,  -177,
+      41,    36,  -177,  -177,   -17,  -177,    43,   -52,  -177,    -4,
+      32,    23,    30,  -177,    -2,  -177,  -177,   158,  -177,    43,
+     -44,  -177,    52,  -177,   -37,  -177,  -177,    38,    51,   177,
+      56,  -177,    73,    82,   135,   149,   185,   185,  -177,  -177,
+     185,  -177,   182,  -177,   245,   355,  -177,   128,  -177,   128,
+    -177,   185,    44,  -177,   185,    47,   -29,  -177,   261,  -177,
+    -177,  -177,  -177,   101,   100,  -177,  -177,  -177,   107,   211,
+      46,  -177,   185,   185,   185,   185,   185,   185,   185,   185,
+     185,   185,  -177,   185,   185,   185,   185,   185,   185,   185,
+     185,   185,   185,   185,    43,    64,    43,   229,  -177,    28,
+     297,   104,   297,    47,   -28,   281,  -177,    47,  -177,  -177,
+    -177,  -177,  -177,   312,   326,   344,    98,    98,   102,   102,
+    -177,  -177,  -177,   297,   297,   297,   297,   297,   297,   297,
+     297,   297,   297,   297,  -177,  -177,  -177,   185,  -177,  -177,
+    -177,  -177,  -177,  -177,   185,   185,   185,   185,   185,   185,
+     -24,   151,   297,    47,    47,    47,  -177,   297,   297,   297,
+     297,   297,   297,  -177,   108,   117,    91,   138,  -177,   171,
+    -177,  -177,  -177,  -177,  -177,  -177,    47,   185,  -177,  -177,
+      54,  -177,  -177,  -177,   126,   123,  -177,  -177,  -177,  -177,
+    -177,  -177,  -177,  -177,  -177,  -177,  -177
 };
-static const short yysindex[] = {                         0,
-    0, -173,    0,    0,    0,    0,    0,   -7,   -9, -219,
-    0,    0,    0,    0, -210,  221,  -73,  -21,    0,  -53,
-  -21,    0,    0, -210,   10,    0,  -92,    0,    0,    6,
-    0, -189,    0, -189,  -14,    0,  -31,    0,    0,   67,
-   72,   56,   76,    0,   38,   40, -156, -139,   80,   80,
-    0,    0,   80,  705,  644,    0,    0,   29, -210,    5,
- -210,    0,   80,   69,    0,   80,   73,  -35,    0,  660,
-    0,    0,    0,    0,   58,   28,    0,    0,    0,    3,
-  168,   80,   80,   80,   80,   80,   80,   80,   80,   80,
-   80,   80,   80,   80,   80,   80,   80,   80,   80,   80,
-   80,   80,    0,  -30,    0,    0,    0,  443,    0, -140,
-   37, -140,   87,   73, -158,   54,    0,   73,    0,    0,
-    0,    0, -140, -140, -140, -140, -140, -140, -140, -140,
- -140, -140, -140, -117, -176, -100, -112, -112, -295, -295,
-    0,    0,    0,    0,    0,   80,    0,    0,    0,   80,
-   80,   80,   80,   80,   80,    0,    0,    0,   57, -122,
- -140,   73, -140, -140, -140, -140, -140, -140,   73,   73,
-    0,    0,  111, -182,   95, -132,    0,  -97,    0,    0,
-    0,    0,    0,    0,   73,   80,    0,    0,   61,    0,
-    0,    0,  106,  126,    0,    0,    0,    0,    0,    0,
-    0,    0,    0,    0,    0,
+
+/* YYDEFACT[STATE-NUM] -- Default reduction number in state STATE-NUM.
+   Performed when YYTABLE does not specify something else to do.  Zero
+   means the default is an error.  */
+static const yytype_int8 yydefact[] =
+{
+       3,     0,     2,     1,    21,    14,    15,    16,    17,     4,
+       0,     0,     6,    30,     0,     5,     0,    11,     9,    36,
+       0,     0,    11,    10,     0,    18,    31,     0,    22,     0,
+       0,     7,     0,    12,    96,    94,    95,     0,     0,     0,
+       0,    27,     0,     0,     0,     0,     0,     0,    49,    30,
+       0,    48,     0,    32,     0,    90,    24,     0,    23,    19,
+      13,     0,     0,    34,    64,     0,    96,    46,     0,    27,
+      26,    43,    44,     0,    96,    87,    88,    89,    36,     0,
+      96,    33,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,    37,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,    91,     0,
+      62,     0,    65,     0,     0,    61,    47,     0,    36,    45,
+      29,    93,    35,    77,    78,    79,    80,    81,    82,    83,
+      84,    85,    86,    66,    67,    68,    69,    70,    71,    72,
+      73,    74,    75,    76,    25,     8,    97,     0,    92,    27,
+      60,    27,    27,    27,     0,     0,     0,     0,     0,     0,
+       0,     0,    63,    50,     0,     0,    36,    52,    53,    57,
+      55,    56,    54,    27,     0,     0,    51,    59,    58,    27,
+      26,    27,    27,    28,    38,    36,     0,    64,    27,    28,
+       0,    28,    36,    27,     0,     0,    27,    40,    27,    27,
+      39,    41,    26,    36,    28,    27,    42
 };
-static const short yyrindex[] = {                         0,
-    0,  169,    0,    0,    0,    0,    0,    0,    0,    0,
-    0,    0,    0,    0,    0,    0,    0,  -23,    0,   52,
-  -15,    0,    0,    0,    0,    0,    0,    0,    0,    0,
-    0,    0,    0,  -40,    0,    0,  540,    0,    0,    0,
-    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
-    0,    0,    0,  133,    0,    0,    0,    0,    0,    0,
-    0,    0,    0,    0,    0,  109,    0,  112,    0,    0,
-    0,    0,    0,    0,    0,  152,    0,    0,    0,   52,
-    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
-    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
-    0,    0,    0,  540,    0,    0,    0,    0,    0,   50,
-    0,  -25,    0,    0,  -29,    0,    0,    0,    0,    0,
-    0,    0,  500,  512,  563,  582,  593,  604,  624,  635,
-  680,  741,  768,  484,  473,  462,  323,  418,  202,  292,
-    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
-    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
-   59,  117,  -19,   -6,   -2,    4,   17,   21,    0,    0,
-    0,    0,    0,  119,    0,  -27,    0,  -17,    0,    0,
-    0,    0,    0,    0,    0,  129,    0,    0,    0,    0,
-    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
-    0,    0,    0,    0,    0,
+
+/* YYPGOTO[NTERM-NUM].  */
+static const yytype_int16 yypgoto[] =
+{
+    -177,  -177,  -177,  -177,  -177,   125,   -15,   -14,  -177,  -177,
+    -177,  -177,  -177,  -169,   -40,  -176,  -177,   142,  -101,  -177,
+    -177,   143,  -177,   -86,  -177,    15,   -27,   160
 };
-static const short yygindex[] = {                         0,
-  131, 1016,    0, -103, -170,    0,  160,  -11,    0,    9,
-  821,    0,    0,    0,    0,    0,  143,    0,    0, -177,
-    0, -116,    0,  146,    0,   20,
+
+/* YYDEFGOTO[NTERM-NUM].  */
+static const yytype_uint8 yydefgoto[] =
+{
+       0,     1,     2,     9,    59,    10,    18,    11,    12,    13,
+      14,    21,    30,   118,    70,   188,    51,    19,    26,    52,
+      27,    53,   175,   114,   109,   111,   115,    55
 };
-#define YYTABLESIZE 1202
-static const short yytable[] = {                         18,
-   36,  184,  160,   22,   64,  100,  101,  102,   64,   64,
-  149,   60,   31,   58,  159,   64,   19,  192,   18,  194,
-   10,   51,   26,  202,   24,   10,   65,  144,   10,   60,
-   16,   58,  204,   64,   52,   10,   15,   18,   56,   51,
-   59,   26,   61,   10,   54,   53,   21,  106,   15,   26,
-   33,   14,   52,   32,  178,   63,   56,   55,  174,   63,
-   63,   53,   54,  107,   51,  176,  177,  188,   53,   27,
-    4,   28,    5,    6,  195,   55,    7,  147,   62,   53,
-  146,  189,   18,    3,   18,  203,    4,   51,    5,    6,
-   61,   35,    7,   61,  158,   53,   73,  172,   74,   62,
-   75,  193,   62,  156,  157,   26,   66,   26,   53,  109,
-   35,   67,   53,   95,   69,   71,  120,   76,   63,   53,
-   96,   97,   98,   99,  100,  101,  102,  121,   52,   93,
-   94,   95,  150,  151,  152,  153,  154,  155,   96,   97,
-   98,   99,  100,  101,  102,  148,  173,   93,   94,   95,
-  180,   52,   95,  181,  157,   95,   96,   97,   98,   99,
-  100,  101,  102,  182,  197,   35,  198,   63,    1,   63,
-   95,   94,   95,   89,   35,   49,   89,   50,   77,   96,
-   97,   98,   99,  100,  101,  102,   98,   99,  100,  101,
-  102,   89,   95,   60,   80,   95,   96,   97,   98,   99,
-  100,  101,  102,  105,   95,  190,    0,    0,  122,    0,
-   95,    0,    0,    0,    0,    0,   18,   18,   18,    0,
-    0,    0,    0,   18,   18,   89,    0,   18,   18,   18,
-   18,   18,   18,    0,    0,    0,    0,    0,    0,   26,
-   26,   26,   81,    0,   95,   81,   26,   26,    0,   18,
-   26,   26,   26,   26,   26,   26,   60,   60,   58,   18,
-   81,   23,   37,   38,   39,   18,   51,   51,    0,   40,
-   41,    0,   26,   42,   43,   44,   45,   46,   47,   52,
-   52,    0,   26,   56,   56,  104,   38,   39,   26,   54,
-   54,    0,   40,   41,   81,   48,   42,   43,   44,   45,
-   46,   47,   55,   55,    0,   49,   53,   53,   35,   35,
-   35,   50,   68,   38,   39,   35,   35,    0,   48,   35,
-   35,   35,   35,   35,   35,   68,   38,   39,   49,   68,
-   38,   39,   82,    0,   50,   82,   68,   38,   39,  156,
-  157,   35,  156,  157,    0,   48,  156,  157,    0,    0,
-   82,   35,    0,    0,    0,   49,    0,   35,   48,    0,
-    0,   50,   48,   79,    0,    0,   79,    0,   49,   48,
-    0,    0,   49,    0,   50,    0,    0,  114,   50,   49,
-    0,   79,    0,    0,   82,   50,   95,   95,   95,   95,
-   95,   95,   95,   95,   95,   95,   95,   95,   95,   95,
-   95,   95,   95,   95,   95,   95,   95,   95,   95,   95,
-   95,   95,   95,   95,   95,   79,    0,    0,   89,   89,
-   89,   89,   89,   89,   89,   89,   89,   89,   89,   89,
-   89,   89,   89,   89,   89,   89,    0,   95,   95,   95,
-   95,   95,   95,   95,   95,   95,   95,   95,   95,   95,
-   95,   95,   95,   95,   95,   93,   94,   95,   80,    0,
-    0,   80,    0,    0,   96,   97,   98,   99,  100,  101,
-  102,    0,    0,    0,    0,    0,   80,    0,    0,    0,
-    4,    0,    5,    6,    0,    0,    7,   81,   81,   81,
-   81,   81,   81,   81,   81,   81,   81,   81,   81,   81,
-   81,   81,   78,    0,    0,   78,    0,    0,    0,    0,
-   80,    0,    0,   77,    0,    0,   77,    0,    0,    0,
-   78,    0,    0,    0,   76,    0,    0,   76,    0,    0,
-    0,   77,    0,    0,    0,  145,    0,    0,    0,    0,
-   65,    0,   76,   65,    0,    0,    0,    0,    0,    0,
-    0,    0,   66,    0,   78,   66,    0,    0,   65,    0,
-    0,    0,    0,    0,    0,   77,    0,    0,    0,    0,
-   66,    0,    0,    0,    0,    0,   76,   82,   82,   82,
-   82,   82,   82,   82,   82,   82,   82,   82,   82,   82,
-   82,   82,   65,    0,    0,    0,    0,    0,   95,    0,
-    0,    0,    0,   67,   66,    0,   67,    0,   79,   79,
-   79,   79,   79,   79,   79,   79,   79,   79,   79,   79,
-   79,   67,   68,    0,    0,   68,    0,    0,    0,    0,
-    0,    0,    0,   69,    0,    0,   69,    0,    0,    0,
-   68,    0,    0,    0,   70,    0,    0,   70,    0,    0,
-    0,   69,    0,    0,    0,   67,    0,    0,    0,    0,
-    0,    0,   70,    0,   71,    0,    0,   71,    0,    0,
-    0,    0,    0,    0,   68,   72,    0,    0,   72,    0,
-    0,    0,   71,    0,    0,   69,    0,    0,    0,    0,
-    0,    0,    0,   72,    0,    0,   70,    0,    0,    0,
-    0,    0,  103,   80,   80,   80,   80,   80,   80,   80,
-   80,   80,   80,   80,   80,   80,   71,    0,  117,    0,
-   73,    0,    0,   73,    0,    0,    0,   72,    0,    0,
-   93,   94,   95,    0,    0,    0,    0,    0,   73,   96,
-   97,   98,   99,  100,  101,  102,    0,   78,   78,   78,
-   78,   78,   78,   78,   78,   78,   78,   78,   77,   77,
-   77,   77,    0,   77,   77,   77,   77,   77,   77,   76,
-   76,   76,   73,    0,   76,   76,   76,   76,   76,   76,
-    0,   74,    0,    0,   74,   65,   65,    0,    0,    0,
-   65,   65,   65,   65,   65,   65,    0,   66,   66,   74,
-    0,    0,   66,   66,   66,   66,   66,   66,   75,    0,
-    0,   75,    0,    0,   95,   95,   95,   95,   95,   95,
-   95,   95,   95,   95,   95,    0,   75,   95,   95,   95,
-    0,    0,    0,   74,    0,    0,   95,   95,   95,   95,
-   95,   95,   95,    0,    0,    0,    0,    0,   67,   67,
-    0,    0,    0,   67,   67,   67,   67,   67,   67,    0,
-   75,    0,    0,    0,    0,    0,    0,   68,   68,    0,
-    0,    0,   68,   68,   68,   68,   68,   68,   69,   69,
-    0,    0,    0,   69,   69,   69,   69,   69,   69,   70,
-   70,  118,    0,    0,   70,   70,   70,   70,   70,   70,
-    0,    0,    0,    0,    0,    0,    0,    0,    0,   71,
-   71,    0,    0,    0,   71,   71,   71,   71,   71,   71,
-   72,   72,    0,    0,    0,   72,   72,   72,   72,   72,
-   72,   93,   94,   95,    0,    0,    0,    0,    0,    0,
-   96,   97,   98,   99,  100,  101,  102,   93,   94,   95,
-    0,    0,    0,    0,    0,    0,   96,   97,   98,   99,
-  100,  101,  102,    0,    0,   73,   73,    0,  162,    0,
-   73,   73,   73,   73,   73,   73,  169,  170,  171,   82,
-   83,   84,   85,   86,   87,   88,   89,   90,   91,   92,
-    0,    0,  179,    0,    0,    0,    0,    0,  183,    0,
-  185,  186,    0,    0,    0,    0,    0,  191,    0,    0,
-    0,    0,  196,    0,    0,  199,    0,  200,  201,    0,
-    0,    0,    0,    0,  205,    0,   74,   74,    0,    0,
-    0,   74,   74,   74,   74,   74,   74,    0,    0,    0,
-    0,    0,    0,    0,    0,   55,    0,    0,    0,    0,
-    0,    0,    0,   75,   75,    0,    0,   70,   75,   75,
-   75,   75,   75,   75,   78,   79,    0,    0,   81,    0,
-    0,    0,    0,   55,    0,    0,    0,    0,  108,  110,
-    0,  112,    0,    0,    0,    0,    0,    0,    0,    0,
-    0,    0,    0,    0,    0,    0,    0,  123,  124,  125,
-  126,  127,  128,  129,  130,  131,  132,  133,  134,  135,
-  136,  137,  138,  139,  140,  141,  142,  143,    0,    0,
-    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
-    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
-    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
-    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
-    0,  161,    0,    0,    0,  163,  164,  165,  166,  167,
-  168,    0,    0,    0,    0,    0,    0,    0,    0,    0,
-    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
-    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
-    0,  112,
+
+/* YYTABLE[YYPACT[STATE-NUM]] -- What to do in state STATE-NUM.  If
+   positive, shift that token.  If negative, reduce the rule whose
+   number is the opposite.  If YYTABLE_NINF, syntax error.  */
+static const yytype_int16 yytable[] =
+{
+      54,    23,    32,    24,   151,   152,    29,   -20,   151,   152,
+      57,   185,    68,   193,    56,   195,    58,   161,    61,    76,
+      77,     3,    62,    79,    63,    54,    61,   150,   205,   117,
+      62,   160,   153,   203,   107,   110,   173,   112,     5,    17,
+       6,     7,    20,   104,     8,   106,    22,    66,    35,    36,
+      66,    35,    36,    25,    33,   123,   124,   125,   126,   127,
+     128,   129,   130,   131,   132,   179,   133,   134,   135,   136,
+     137,   138,   139,   140,   141,   142,   143,   176,   177,   178,
+      45,    31,   147,    45,   189,    24,   151,   152,   148,   144,
+      46,   196,    28,    46,    15,    16,    47,    64,   113,    47,
+     190,    61,   204,    50,   108,    62,    50,   122,    60,   163,
+      65,   164,   165,   166,   194,    69,     4,   145,    16,     5,
+     162,     6,     7,   151,   152,     8,    71,   167,   168,   169,
+     170,   171,   172,   180,     5,    72,     6,     7,    73,   184,
+       8,   186,   187,    87,    88,    89,    90,    91,   192,    89,
+      90,    91,    74,   197,   119,    61,   200,   149,   201,   202,
+     112,    34,    35,    36,   120,   206,   174,   181,    37,    38,
+     182,   152,    39,    40,    41,    42,    43,    44,   183,   198,
+      66,    35,    36,   199,   105,    80,    35,    36,    66,    35,
+      36,    78,    37,    38,    45,    81,    39,    40,    41,    42,
+      43,    44,   191,     0,    46,    75,     0,     0,     0,     0,
+      47,    48,     0,    45,     0,     0,    49,    50,    45,     0,
+       0,    45,     0,    46,     0,     0,     0,     0,    46,    47,
+      67,    46,     0,     0,    47,    48,    50,    47,     0,     0,
+      49,    50,     0,     0,    50,    82,    83,    84,     0,     0,
+       0,     0,     0,     0,    85,    86,    87,    88,    89,    90,
+      91,     0,     0,    82,    83,    84,     0,     0,     0,     0,
+       0,   121,    85,    86,    87,    88,    89,    90,    91,    82,
+      83,    84,     0,     0,     0,   146,     0,     0,    85,    86,
+      87,    88,    89,    90,    91,    82,    83,    84,    92,     0,
+       0,     0,     0,     0,    85,    86,    87,    88,    89,    90,
+      91,     0,     0,     0,   116,    82,    83,    84,   154,   155,
+     156,   157,   158,   159,    85,    86,    87,    88,    89,    90,
+      91,    82,    83,    84,     0,     0,     0,     0,     0,     0,
+      85,    86,    87,    88,    89,    90,    91,    83,    84,     0,
+       0,     0,     0,     0,     0,    85,    86,    87,    88,    89,
+      90,    91,    84,     0,     0,     0,     0,     0,     0,    85,
+      86,    87,    88,    89,    90,    91,    93,    94,    95,    96,
+      97,    98,    99,   100,   101,   102,   103,    85,    86,    87,
+      88,    89,    90,    91
 };
-static const short yycheck[] = {                         40,
-   93,  179,  119,   15,   40,  301,  302,  303,   40,   40,
-  114,   41,   24,   41,  118,   41,   40,  188,   59,  190,
-   44,   41,   40,  201,   16,   41,   58,   58,   44,   59,
-   40,   59,  203,   59,   41,   59,   44,  257,   41,   59,
-   32,   59,   34,   59,   41,   40,  257,   59,   44,  123,
-   41,   59,   59,   44,  171,   91,   59,   41,  162,   91,
-   91,   41,   59,   59,   59,  169,  170,  184,   40,   91,
-  260,  125,  262,  263,  191,   59,  266,   41,   93,   59,
-   44,  185,  123,  257,  125,  202,  260,   59,  262,  263,
-   41,   40,  266,   44,   41,   40,   59,   41,   59,   41,
-  257,   41,   44,  286,  287,  123,   40,  125,   40,   41,
-   59,   40,   40,  290,   59,   40,   59,  257,   91,   40,
-  297,  298,  299,  300,  301,  302,  303,  125,  123,  288,
-  289,  290,  291,  292,  293,  294,  295,  296,  297,  298,
-  299,  300,  301,  302,  303,   59,  269,  288,  289,  290,
-   40,  123,   41,   59,  287,   44,  297,  298,  299,  300,
-  301,  302,  303,  261,   59,  258,   41,   59,    0,   41,
-   59,  289,  290,   41,  123,   59,   44,   59,   48,  297,
-  298,  299,  300,  301,  302,  303,  299,  300,  301,  302,
-  303,   59,   41,   34,   52,   44,  297,  298,  299,  300,
-  301,  302,  303,   58,   93,  186,   -1,   -1,   41,   -1,
-   59,   -1,   -1,   -1,   -1,   -1,  257,  258,  259,   -1,
-   -1,   -1,   -1,  264,  265,   93,   -1,  268,  269,  270,
-  271,  272,  273,   -1,   -1,   -1,   -1,   -1,   -1,  257,
-  258,  259,   41,   -1,   93,   44,  264,  265,   -1,  290,
-  268,  269,  270,  271,  272,  273,  286,  287,  286,  300,
-   59,   41,  257,  258,  259,  306,  286,  287,   -1,  264,
-  265,   -1,  290,  268,  269,  270,  271,  272,  273,  286,
-  287,   -1,  300,  286,  287,  257,  258,  259,  306,  286,
-  287,   -1,  264,  265,   93,  290,  268,  269,  270,  271,
-  272,  273,  286,  287,   -1,  300,  286,  287,  257,  258,
-  259,  306,  257,  258,  259,  264,  265,   -1,  290,  268,
-  269,  270,  271,  272,  273,  257,  258,  259,  300,  257,
-  258,  259,   41,   -1,  306,   44,  257,  258,  259,  286,
-  287,  290,  286,  287,   -1,  290,  286,  287,   -1,   -1,
-   59,  300,   -1,   -1,   -1,  300,   -1,  306,  290,   -1,
-   -1,  306,  290,   41,   -1,   -1,   44,   -1,  300,  290,
-   -1,   -1,  300,   -1,  306,   -1,   -1,  305,  306,  300,
-   -1,   59,   -1,   -1,   93,  306,  275,  276,  277,  278,
-  279,  280,  281,  282,  283,  284,  285,  286,  287,  288,
-  289,  290,  291,  292,  293,  294,  295,  296,  297,  298,
-  299,  300,  301,  302,  303,   93,   -1,   -1,  286,  287,
-  288,  289,  290,  291,  292,  293,  294,  295,  296,  297,
-  298,  299,  300,  301,  302,  303,   -1,  286,  287,  288,
-  289,  290,  291,  292,  293,  294,  295,  296,  297,  298,
-  299,  300,  301,  302,  303,  288,  289,  290,   41,   -1,
-   -1,   44,   -1,   -1,  297,  298,  299,  300,  301,  302,
-  303,   -1,   -1,   -1,   -1,   -1,   59,   -1,   -1,   -1,
-  260,   -1,  262,  263,   -1,   -1,  266,  286,  287,  288,
-  289,  290,  291,  292,  293,  294,  295,  296,  297,  298,
-  299,  300,   41,   -1,   -1,   44,   -1,   -1,   -1,   -1,
-   93,   -1,   -1,   41,   -1,   -1,   44,   -1,   -1,   -1,
-   59,   -1,   -1,   -1,   41,   -1,   -1,   44,   -1,   -1,
-   -1,   59,   -1,   -1,   -1,   93,   -1,   -1,   -1,   -1,
-   41,   -1,   59,   44,   -1,   -1,   -1,   -1,   -1,   -1,
-   -1,   -1,   41,   -1,   93,   44,   -1,   -1,   59,   -1,
-   -1,   -1,   -1,   -1,   -1,   93,   -1,   -1,   -1,   -1,
-   59,   -1,   -1,   -1,   -1,   -1,   93,  286,  287,  288,
-  289,  290,  291,  292,  293,  294,  295,  296,  297,  298,
-  299,  300,   93,   -1,   -1,   -1,   -1,   -1,   59,   -1,
-   -1,   -1,   -1,   41,   93,   -1,   44,   -1,  286,  287,
-  288,  289,  290,  291,  292,  293,  294,  295,  296,  297,
-  298,   59,   41,   -1,   -1,   44,   -1,   -1,   -1,   -1,
-   -1,   -1,   -1,   41,   -1,   -1,   44,   -1,   -1,   -1,
-   59,   -1,   -1,   -1,   41,   -1,   -1,   44,   -1,   -1,
-   -1,   59,   -1,   -1,   -1,   93,   -1,   -1,   -1,   -1,
-   -1,   -1,   59,   -1,   41,   -1,   -1,   44,   -1,   -1,
-   -1,   -1,   -1,   -1,   93,   41,   -1,   -1,   44,   -1,
-   -1,   -1,   59,   -1,   -1,   93,   -1,   -1,   -1,   -1,
-   -1,   -1,   -1,   59,   -1,   -1,   93,   -1,   -1,   -1,
-   -1,   -1,   59,  286,  287,  288,  289,  290,  291,  292,
-  293,  294,  295,  296,  297,  298,   93,   -1,   59,   -1,
-   41,   -1,   -1,   44,   -1,   -1,   -1,   93,   -1,   -1,
-  288,  289,  290,   -1,   -1,   -1,   -1,   -1,   59,  297,
-  298,  299,  300,  301,  302,  303,   -1,  286,  287,  288,
-  289,  290,  291,  292,  293,  294,  295,  296,  286,  287,
-  288,  289,   -1,  291,  292,  293,  294,  295,  296,  286,
-  287,  288,   93,   -1,  291,  292,  293,  294,  295,  296,
-   -1,   41,   -1,   -1,   44,  286,  287,   -1,   -1,   -1,
-  291,  292,  293,  294,  295,  296,   -1,  286,  287,   59,
-   -1,   -1,  291,  292,  293,  294,  295,  296,   41,   -1,
-   -1,   44,   -1,   -1,  275,  276,  277,  278,  279,  280,
-  281,  282,  283,  284,  285,   -1,   59,  288,  289,  290,
-   -1,   -1,   -1,   93,   -1,   -1,  297,  298,  299,  300,
-  301,  302,  303,   -1,   -1,   -1,   -1,   -1,  286,  287,
-   -1,   -1,   -1,  291,  292,  293,  294,  295,  296,   -1,
-   93,   -1,   -1,   -1,   -1,   -1,   -1,  286,  287,   -1,
-   -1,   -1,  291,  292,  293,  294,  295,  296,  286,  287,
-   -1,   -1,   -1,  291,  292,  293,  294,  295,  296,  286,
-  287,   71,   -1,   -1,  291,  292,  293,  294,  295,  296,
-   -1,   -1,   -1,   -1,   -1,   -1,   -1,   -1,   -1,  286,
-  287,   -1,   -1,   -1,  291,  292,  293,  294,  295,  296,
-  286,  287,   -1,   -1,   -1,  291,  292,  293,  294,  295,
-  296,  288,  289,  290,   -1,   -1,   -1,   -1,   -1,   -1,
-  297,  298,  299,  300,  301,  302,  303,  288,  289,  290,
-   -1,   -1,   -1,   -1,   -1,   -1,  297,  298,  299,  300,
-  301,  302,  303,   -1,   -1,  286,  287,   -1,  148,   -1,
-  291,  292,  293,  294,  295,  296,  156,  157,  158,  275,
-  276,  277,  278,  279,  280,  281,  282,  283,  284,  285,
-   -1,   -1,  172,   -1,   -1,   -1,   -1,   -1,  178,   -1,
-  180,  181,   -1,   -1,   -1,   -1,   -1,  187,   -1,   -1,
-   -1,   -1,  192,   -1,   -1,  195,   -1,  197,  198,   -1,
-   -1,   -1,   -1,   -1,  204,   -1,  286,  287,   -1,   -1,
-   -1,  291,  292,  293,  294,  295,  296,   -1,   -1,   -1,
-   -1,   -1,   -1,   -1,   -1,   30,   -1,   -1,   -1,   -1,
-   -1,   -1,   -1,  286,  287,   -1,   -1,   42,  291,  292,
-  293,  294,  295,  296,   49,   50,   -1,   -1,   53,   -1,
-   -1,   -1,   -1,   58,   -1,   -1,   -1,   -1,   63,   64,
-   -1,   66,   -1,   -1,   -1,   -1,   -1,   -1,   -1,   -1,
-   -1,   -1,   -1,   -1,   -1,   -1,   -1,   82,   83,   84,
-   85,   86,   87,   88,   89,   90,   91,   92,   93,   94,
-   95,   96,   97,   98,   99,  100,  101,  102,   -1,   -1,
-   -1,   -1,   -1,   -1,   -1,   -1,   -1,   -1,   -1,   -1,
-   -1,   -1,   -1,   -1,   -1,   -1,   -1,   -1,   -1,   -1,
-   -1,   -1,   -1,   -1,   -1,   -1,   -1,   -1,   -1,   -1,
-   -1,   -1,   -1,   -1,   -1,   -1,   -1,   -1,   -1,   -1,
-   -1,  146,   -1,   -1,   -1,  150,  151,  152,  153,  154,
-  155,   -1,   -1,   -1,   -1,   -1,   -1,   -1,   -1,   -1,
-   -1,   -1,   -1,   -1,   -1,   -1,   -1,   -1,   -1,   -1,
-   -1,   -1,   -1,   -1,   -1,   -1,   -1,   -1,   -1,   -1,
-   -1,  186,
+
+static const yytype_int16 yycheck[] =
+{
+      27,    16,     4,    55,    32,    33,    20,    59,    32,    33,
+      54,   180,    39,   189,    29,   191,    60,   118,    55,    46,
+      47,     0,    59,    50,    61,    52,    55,   113,   204,    69,
+      59,   117,    60,   202,    61,    62,    60,    64,     6,     3,
+       8,     9,    59,    57,    12,    59,     3,     3,     4,     5,
+       3,     4,     5,    57,    56,    82,    83,    84,    85,    86,
+      87,    88,    89,    90,    91,   166,    93,    94,    95,    96,
+      97,    98,    99,   100,   101,   102,   103,   163,   164,   165,
+      36,    58,    54,    36,   185,    55,    32,    33,    60,   104,
+      46,   192,    60,    46,    53,    54,    52,    59,    51,    52,
+     186,    55,   203,    59,    60,    59,    59,    61,    56,   149,
+      59,   151,   152,   153,    60,    59,     3,    53,    54,     6,
+     147,     8,     9,    32,    33,    12,    53,   154,   155,   156,
+     157,   158,   159,   173,     6,    53,     8,     9,     3,   179,
+      12,   181,   182,    45,    46,    47,    48,    49,   188,    47,
+      48,    49,     3,   193,    53,    55,   196,    53,   198,   199,
+     187,     3,     4,     5,    57,   205,    15,    59,    10,    11,
+      53,    33,    14,    15,    16,    17,    18,    19,     7,    53,
+       3,     4,     5,    60,    59,     3,     4,     5,     3,     4,
+       5,    49,    10,    11,    36,    52,    14,    15,    16,    17,
+      18,    19,   187,    -1,    46,    45,    -1,    -1,    -1,    -1,
+      52,    53,    -1,    36,    -1,    -1,    58,    59,    36,    -1,
+      -1,    36,    -1,    46,    -1,    -1,    -1,    -1,    46,    52,
+      53,    46,    -1,    -1,    52,    53,    59,    52,    -1,    -1,
+      58,    59,    -1,    -1,    59,    34,    35,    36,    -1,    -1,
+      -1,    -1,    -1,    -1,    43,    44,    45,    46,    47,    48,
+      49,    -1,    -1,    34,    35,    36,    -1,    -1,    -1,    -1,
+      -1,    60,    43,    44,    45,    46,    47,    48,    49,    34,
+      35,    36,    -1,    -1,    -1,    56,    -1,    -1,    43,    44,
+      45,    46,    47,    48,    49,    34,    35,    36,    53,    -1,
+      -1,    -1,    -1,    -1,    43,    44,    45,    46,    47,    48,
+      49,    -1,    -1,    -1,    53,    34,    35,    36,    37,    38,
+      39,    40,    41,    42,    43,    44,    45,    46,    47,    48,
+      49,    34,    35,    36,    -1,    -1,    -1,    -1,    -1,    -1,
+      43,    44,    45,    46,    47,    48,    49,    35,    36,    -1,
+      -1,    -1,    -1,    -1,    -1,    43,    44,    45,    46,    47,
+      48,    49,    36,    -1,    -1,    -1,    -1,    -1,    -1,    43,
+      44,    45,    46,    47,    48,    49,    21,    22,    23,    24,
+      25,    26,    27,    28,    29,    30,    31,    43,    44,    45,
+      46,    47,    48,    49
 };
-#define YYFINAL 1
-#ifndef YYDEBUG
-#define YYDEBUG 0
-#endif
-#define YYMAXTOKEN 306
-#if YYDEBUG
-static const char *yyname[] = {
-
-"end-of-file",0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-0,0,0,0,0,0,"'('","')'",0,0,"','",0,0,0,0,0,0,0,0,0,0,0,0,0,"':'","';'",0,0,0,0,
-0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,"'['",0,"']'",0,0,0,0,0,0,
-0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,"'{'",0,"'}'",0,0,0,0,0,0,0,0,0,0,
-0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-0,"ID","CON","STR","CHAR","ELSE","FLOAT","DOUBLE","FOR","IF","INT","RESERVED",
-"RETURN","WHILE","DO","CONTINUE","BREAK","GOTO","LVAL","SET","SETOR","SETXOR",
-"SETAND","SETLSH","SETRSH","SETADD","SETSUB","SETMUL","SETDIV","SETMOD","OR",
-"AND","BITOR","BITXOR","BITAND","EQ","NE","GT","GE","LT","LE","LSH","RSH","ADD",
-"SUB","MUL","DIV","MOD","UNARY","NOT","COM",
+
+/* YYSTOS[STATE-NUM] -- The symbol kind of the accessing symbol of
+   state STATE-NUM.  */
+static const yytype_int8 yystos[] =
+{
+       0,    63,    64,     0,     3,     6,     8,     9,    12,    65,
+      67,    69,    70,    71,    72,    53,    54,     3,    68,    79,
+      59,    73,     3,    68,    55,    57,    80,    82,    60,    69,
+      74,    58,     4,    56,     3,     4,     5,    10,    11,    14,
+      15,    16,    17,    18,    19,    36,    46,    52,    53,    58,
+      59,    78,    81,    83,    88,    89,    68,    54,    60,    66,
+      56,    55,    59,    61,    59,    59,     3,    53,    88,    59,
+      76,    53,    53,     3,     3,    89,    88,    88,    79,    88,
+       3,    83,    34,    35,    36,    43,    44,    45,    46,    47,
+      48,    49,    53,    21,    22,    23,    24,    25,    26,    27,
+      28,    29,    30,    31,    69,    67,    69,    88,    60,    86,
+      88,    87,    88,    51,    85,    88,    53,    76,    75,    53,
+      57,    60,    61,    88,    88,    88,    88,    88,    88,    88,
+      88,    88,    88,    88,    88,    88,    88,    88,    88,    88,
+      88,    88,    88,    88,    68,    53,    56,    54,    60,    53,
+      85,    32,    33,    60,    37,    38,    39,    40,    41,    42,
+      85,    80,    88,    76,    76,    76,    76,    88,    88,    88,
+      88,    88,    88,    60,    15,    84,    85,    85,    85,    80,
+      76,    59,    53,     7,    76,    75,    76,    76,    77,    80,
+      85,    87,    76,    77,    60,    77,    80,    76,    53,    60,
+      76,    76,    76,    75,    80,    77,    76
 };
-static const char *yyrule[] = {
-"$accept : prog",
-"prog : externs",
-"externs :",
-"externs : externs extern",
-"extern : dcl ';'",
-"extern : func",
-"dcls :",
-"dcls : dcls dcl ';'",
-"dcl : type dclr",
-"dcl : dcl ',' dclr",
-"dclr : ID",
-"dclr : ID '[' ']'",
-"dclr : ID '[' CON ']'",
-"type : CHAR",
-"type : FLOAT",
-"type : DOUBLE",
-"type : INT",
-"func : fhead stmts '}'",
-"fhead : fname fargs '{' dcls",
-"fname : type ID",
-"fname : ID",
-"fargs : '(' ')'",
-"fargs : '(' args ')'",
-"args : type dclr",
-"args : args ',' type dclr",
-"s :",
-"m :",
-"n :",
-"block : '{' stmts '}'",
-"stmts :",
-"stmts : stmts lblstmt",
-"lblstmt : b stmt",
-"lblstmt : b labels stmt",
-"labels : ID ':'",
-"labels : labels ID ':'",
-"b :",
-"stmt : expr ';'",
-"stmt : IF '(' cexpr ')' m lblstmt m",
-"stmt : IF '(' cexpr ')' m lblstmt ELSE n m lblstmt m",
-"stmt : WHILE '(' m cexpr ')' m s lblstmt n m",
-"stmt : DO m s lblstmt WHILE '(' m cexpr ')' ';' m",
-"stmt : FOR '(' expro ';' m cexpro ';' m expro n ')' m s lblstmt n m",
-"stmt : CONTINUE ';'",
-"stmt : BREAK ';'",
-"stmt : GOTO ID ';'",
-"stmt : RETURN ';'",
-"stmt : RETURN expr ';'",
-"stmt : block",
-"stmt : ';'",
-"cexpro :",
-"cexpro : cexpr",
-"cexpr : expr EQ expr",
-"cexpr : expr NE expr",
-"cexpr : expr LE expr",
-"cexpr : expr GE expr",
-"cexpr : expr LT expr",
-"cexpr : expr GT expr",
-"cexpr : cexpr AND m cexpr",
-"cexpr : cexpr OR m cexpr",
-"cexpr : NOT cexpr",
-"cexpr : expr",
-"exprs : expr",
-"exprs : exprs ',' expr",
-"expro :",
-"expro : expr",
-"expr : lval SET expr",
-"expr : lval SETOR expr",
-"expr : lval SETXOR expr",
-"expr : lval SETAND expr",
-"expr : lval SETLSH expr",
-"expr : lval SETRSH expr",
-"expr : lval SETADD expr",
-"expr : lval SETSUB expr",
-"expr : lval SETMUL expr",
-"expr : lval SETDIV expr",
-"expr : lval SETMOD expr",
-"expr : expr BITOR expr",
-"expr : expr BITXOR expr",
-"expr : expr BITAND expr",
-"expr : expr LSH expr",
-"expr : expr RSH expr",
-"expr : expr ADD expr",
-"expr : expr SUB expr",
-"expr : expr MUL expr",
-"expr : expr DIV expr",
-"expr : expr MOD expr",
-"expr : BITAND lval",
-"expr : SUB expr",
-"expr : COM expr",
-"expr : lval",
-"expr : ID '(' ')'",
-"expr : ID '(' exprs ')'",
-"expr : '(' expr ')'",
-"expr : CON",
-"expr : STR",
-"lval : ID",
-"lval : ID '[' expr ']'",
 
+/* YYR1[RULE-NUM] -- Symbol kind of the left-hand side of rule RULE-NUM.  */
+static const yytype_int8 yyr1[] =
+{
+       0,    62,    63,    64,    64,    65,    65,    66,    66,    67,
+      67,    68,    68,    68,    69,    69,    69,    69,    70,    71,
+      72,    72,    73,    73,    74,    74,    75,    76,    77,    78,
+      79,    79,    80,    80,    81,    81,    82,    83,    83,    83,
+      83,    83,    83,    83,    83,    83,    83,    83,    83,    83,
+      84,    84,    85,    85,    85,    85,    85,    85,    85,    85,
+      85,    85,    86,    86,    87,    87,    88,    88,    88,    88,
+      88,    88,    88,    88,    88,    88,    88,    88,    88,    88,
+      88,    88,    88,    88,    88,    88,    88,    88,    88,    88,
+      88,    88,    88,    88,    88,    88,    89,    89
 };
-#endif
 
-int      yydebug;
-int      yynerrs;
+/* YYR2[RULE-NUM] -- Number of symbols on the right-hand side of rule RULE-NUM.  */
+static const yytype_int8 yyr2[] =
+{
+       0,     2,     1,     0,     2,     2,     1,     0,     3,     2,
+       3,     1,     3,     4,     1,     1,     1,     1,     3,     4,
+       2,     1,     2,     3,     2,     4,     0,     0,     0,     3,
+       0,     2,     2,     3,     2,     3,     0,     2,     7,    11,
+      10,    11,    16,     2,     2,     3,     2,     3,     1,     1,
+       0,     1,     3,     3,     3,     3,     3,     3,     4,     4,
+       2,     1,     1,     3,     0,     1,     3,     3,     3,     3,
+       3,     3,     3,     3,     3,     3,     3,     3,     3,     3,
+       3,     3,     3,     3,     3,     3,     3,     2,     2,     2,
+       1,     3,     4,     3,     1,     1,     1,     4
+};
 
-int      yyerrflag;
-int      yychar;
-YYSTYPE  yyval;
-YYSTYPE  yylval;
 
-/* define the initial stack-sizes */
-#ifdef YYSTACKSIZE
-#undef YYMAXDEPTH
-#define YYMAXDEPTH  YYSTACKSIZE
-#else
-#ifdef YYMAXDEPTH
-#define YYSTACKSIZE YYMAXDEPTH
-#else
-#define YYSTACKSIZE 10000
-#define YYMAXDEPTH  500
-#endif
-#endif
+enum { YYENOMEM = -2 };
 
-#define YYINITSTACKSIZE 500
-
-typedef struct {
-    unsigned stacksize;
-    short    *s_base;
-    short    *s_mark;
-    short    *s_last;
-    YYSTYPE  *l_base;
-    YYSTYPE  *l_mark;
-} YYSTACKDATA;
-/* variables for the parser stack */
-static YYSTACKDATA yystack;
-#line 209 "cgram.y"
-# include <stdio.h>
+#define yyerrok         (yyerrstatus = 0)
+#define yyclearin       (yychar = YYEMPTY)
 
-extern int lineno;
+#define YYACCEPT        goto yyacceptlab
+#define YYABORT         goto yyabortlab
+#define YYERROR         goto yyerrorlab
+#define YYNOMEM         goto yyexhaustedlab
 
-/* 
- * main - read a program, and parse it
- */
-main(int argc, char *argv)
+
+#define YYRECOVERING()  (!!yyerrstatus)
+
+#define YYBACKUP(Token, Value)                                    \
+  do                                                              \
+    if (yychar == YYEMPTY)                                        \
+      {                                                           \
+        yychar = (Token);                                         \
+        yylval = (Value);                                         \
+        YYPOPSTACK (yylen);                                       \
+        yystate = *yyssp;                                         \
+        goto yybackup;                                            \
+      }                                                           \
+    else                                                          \
+      {                                                           \
+        yyerror (YY_("syntax error: cannot back up")); \
+        YYERROR;                                                  \
+      }                                                           \
+  while (0)
+
+/* Backward compatibility with an undocumented macro.
+   Use YYerror or YYUNDEF. */
+#define YYERRCODE YYUNDEF
+
+
+/* Enable debugging if requested.  */
+#if YYDEBUG
+
+# ifndef YYFPRINTF
+#  include <stdio.h> /* INFRINGES ON USER NAME SPACE */
+#  define YYFPRINTF fprintf
+# endif
+
+# define YYDPRINTF(Args)                        \
+do {                                            \
+  if (yydebug)                                  \
+    YYFPRINTF Args;                             \
+} while (0)
+
+
+
+
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)                    \
+do {                                                                      \
+  if (yydebug)                                                            \
+    {                                                                     \
+      YYFPRINTF (stderr, "%s ", Title);                                   \
+      yy_symbol_print (stderr,                                            \
+                  Kind, Value); \
+      YYFPRINTF (stderr, "\n");                                           \
+    }                                                                     \
+} while (0)
+
+
+/*-----------------------------------.
+| Print this symbol's value on YYO.  |
+`-----------------------------------*/
+
+static void
+yy_symbol_value_print (FILE *yyo,
+                       yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep)
 {
+  FILE *yyoutput = yyo;
+  YY_USE (yyoutput);
+  if (!yyvaluep)
+    return;
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  YY_USE (yykind);
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
+}
 
-   enterblock();
-   initlex();
-   enterblock();
-   if (yyparse())
-      yyerror("syntax error");
-   exit(0);
+
+/*---------------------------.
+| Print this symbol on YYO.  |
+`---------------------------*/
+
+static void
+yy_symbol_print (FILE *yyo,
+                 yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep)
+{
+  YYFPRINTF (yyo, "%s %s (",
+             yykind < YYNTOKENS ? "token" : "nterm", yysymbol_name (yykind));
+
+  yy_symbol_value_print (yyo, yykind, yyvaluep);
+  YYFPRINTF (yyo, ")");
 }
 
-/*
- * yyerror - issue error message
- */
-yyerror(char msg[])
+/*------------------------------------------------------------------.
+| yy_stack_print -- Print the state stack from its BOTTOM up to its |
+| TOP (included).                                                   |
+`------------------------------------------------------------------*/
+
+static void
+yy_stack_print (yy_state_t *yybottom, yy_state_t *yytop)
 {
-   fprintf(stderr, " %s.  Line %d\n", msg, lineno);
+  YYFPRINTF (stderr, "Stack now");
+  for (; yybottom <= yytop; yybottom++)
+    {
+      int yybot = *yybottom;
+      YYFPRINTF (stderr, " %d", yybot);
+    }
+  YYFPRINTF (stderr, "\n");
 }
-#line 661 "y.tab.c"
 
-#if YYDEBUG
-#include <stdio.h>		/* needed for printf */
-#endif
+# define YY_STACK_PRINT(Bottom, Top)                            \
+do {                                                            \
+  if (yydebug)                                                  \
+    yy_stack_print ((Bottom), (Top));                           \
+} while (0)
+
 
-#include <stdlib.h>	/* needed for malloc, etc */
-#include <string.h>	/* needed for memset */
+/*------------------------------------------------.
+| Report that the YYRULE is going to be reduced.  |
+`------------------------------------------------*/
 
-/* allocate initial stack or double stack size, up to YYMAXDEPTH */
-static int yygrowstack(YYSTACKDATA *data)
+static void
+yy_reduce_print (yy_state_t *yyssp, YYSTYPE *yyvsp,
+                 int yyrule)
 {
-    int i;
-    unsigned newsize;
-    short *newss;
-    YYSTYPE *newvs;
-
-    if ((newsize = data->stacksize) == 0)
-        newsize = YYINITSTACKSIZE;
-    else if (newsize >= YYMAXDEPTH)
-        return -1;
-    else if ((newsize *= 2) > YYMAXDEPTH)
-        newsize = YYMAXDEPTH;
-
-    i = data->s_mark - data->s_base;
-    newss = (short *)realloc(data->s_base, newsize * sizeof(*newss));
-    if (newss == 0)
-        return -1;
-
-    data->s_base = newss;
-    data->s_mark = newss + i;
-
-    newvs = (YYSTYPE *)realloc(data->l_base, newsize * sizeof(*newvs));
-    if (newvs == 0)
-        return -1;
-
-    data->l_base = newvs;
-    data->l_mark = newvs + i;
-
-    data->stacksize = newsize;
-    data->s_last = data->s_base + newsize - 1;
-    return 0;
+  int yylno = yyrline[yyrule];
+  int yynrhs = yyr2[yyrule];
+  int yyi;
+  YYFPRINTF (stderr, "Reducing stack by rule %d (line %d):\n",
+             yyrule - 1, yylno);
+  /* The symbols being reduced.  */
+  for (yyi = 0; yyi < yynrhs; yyi++)
+    {
+      YYFPRINTF (stderr, "   $%d = ", yyi + 1);
+      yy_symbol_print (stderr,
+                       YY_ACCESSING_SYMBOL (+yyssp[yyi + 1 - yynrhs]),
+                       &yyvsp[(yyi + 1) - (yynrhs)]);
+      YYFPRINTF (stderr, "\n");
+    }
 }
 
-#if YYPURE || defined(YY_NO_LEAKS)
-static void yyfreestack(YYSTACKDATA *data)
+# define YY_REDUCE_PRINT(Rule)          \
+do {                                    \
+  if (yydebug)                          \
+    yy_reduce_print (yyssp, yyvsp, Rule); \
+} while (0)
+
+/* Nonzero means print parse trace.  It is left uninitialized so that
+   multiple parsers can coexist.  */
+int yydebug;
+#else /* !YYDEBUG */
+# define YYDPRINTF(Args) ((void) 0)
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)
+# define YY_STACK_PRINT(Bottom, Top)
+# define YY_REDUCE_PRINT(Rule)
+#endif /* !YYDEBUG */
+
+
+/* YYINITDEPTH -- initial size of the parser's stacks.  */
+#ifndef YYINITDEPTH
+# define YYINITDEPTH 200
+#endif
+
+/* YYMAXDEPTH -- maximum size the stacks can grow to (effective only
+   if the built-in stack extension method is used).
+
+   Do not make this value too large; the results are undefined if
+   YYSTACK_ALLOC_MAXIMUM < YYSTACK_BYTES (YYMAXDEPTH)
+   evaluated with infinite-precision integer arithmetic.  */
+
+#ifndef YYMAXDEPTH
+# define YYMAXDEPTH 10000
+#endif
+
+
+
+
+
+
+/*-----------------------------------------------.
+| Release the memory associated to this symbol.  |
+`-----------------------------------------------*/
+
+static void
+yydestruct (const char *yymsg,
+            yysymbol_kind_t yykind, YYSTYPE *yyvaluep)
 {
-    free(data->s_base);
-    free(data->l_base);
-    memset(data, 0, sizeof(*data));
+  YY_USE (yyvaluep);
+  if (!yymsg)
+    yymsg = "Deleting";
+  YY_SYMBOL_PRINT (yymsg, yykind, yyvaluep, yylocationp);
+
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  YY_USE (yykind);
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
 }
-#else
-#define yyfreestack(data) /* nothing */
-#endif
 
-#define YYABORT  goto yyabort
-#define YYREJECT goto yyabort
-#define YYACCEPT goto yyaccept
-#define YYERROR  goto yyerrlab
+
+
+
+
+
+/*----------.
+| yyparse.  |
+`----------*/
 
 int
-YYPARSE_DECL()
+yyparse (void)
 {
-    int yym, yyn, yystate;
-#if YYDEBUG
-    const char *yys;
+/* Lookahead token kind.  */
+int yychar;
+
+
+/* The semantic value of the lookahead symbol.  */
+/* Default value used for initialization, for pacifying older GCCs
+   or non-GCC compilers.  */
+YY_INITIAL_VALUE (static YYSTYPE yyval_default;)
+YYSTYPE yylval YY_INITIAL_VALUE (= yyval_default);
+
+    /* Number of syntax errors so far.  */
+    int yynerrs = 0;
+
+    yy_state_fast_t yystate = 0;
+    /* Number of tokens to shift before error messages enabled.  */
+    int yyerrstatus = 0;
+
+    /* Refer to the stacks through separate pointers, to allow yyoverflow
+       to reallocate them elsewhere.  */
+
+    /* Their size.  */
+    YYPTRDIFF_T yystacksize = YYINITDEPTH;
+
+    /* The state stack: array, bottom, top.  */
+    yy_state_t yyssa[YYINITDEPTH];
+    yy_state_t *yyss = yyssa;
+    yy_state_t *yyssp = yyss;
+
+    /* The semantic value stack: array, bottom, top.  */
+    YYSTYPE yyvsa[YYINITDEPTH];
+    YYSTYPE *yyvs = yyvsa;
+    YYSTYPE *yyvsp = yyvs;
+
+  int yyn;
+  /* The return value of yyparse.  */
+  int yyresult;
+  /* Lookahead symbol kind.  */
+  yysymbol_kind_t yytoken = YYSYMBOL_YYEMPTY;
+  /* The variables used to return semantic value and location from the
+     action routines.  */
+  YYSTYPE yyval;
+
+
+
+#define YYPOPSTACK(N)   (yyvsp -= (N), yyssp -= (N))
+
+  /* The number of symbols on the RHS of the reduced rule.
+     Keep to zero when no symbol should be popped.  */
+  int yylen = 0;
+
+  YYDPRINTF ((stderr, "Starting parse\n"));
+
+  yychar = YYEMPTY; /* Cause a token to be read.  */
+
+  goto yysetstate;
 
-    if ((yys = getenv("YYDEBUG")) != 0)
+
+/*------------------------------------------------------------.
+| yynewstate -- push a new state, which is found in yystate.  |
+`------------------------------------------------------------*/
+yynewstate:
+  /* In all cases, when you get here, the value and location stacks
+     have just been pushed.  So pushing a state here evens the stacks.  */
+  yyssp++;
+
+
+/*--------------------------------------------------------------------.
+| yysetstate -- set current state (the top of the stack) to yystate.  |
+`--------------------------------------------------------------------*/
+yysetstate:
+  YYDPRINTF ((stderr, "Entering state %d\n", yystate));
+  YY_ASSERT (0 <= yystate && yystate < YYNSTATES);
+  YY_IGNORE_USELESS_CAST_BEGIN
+  *yyssp = YY_CAST (yy_state_t, yystate);
+  YY_IGNORE_USELESS_CAST_END
+  YY_STACK_PRINT (yyss, yyssp);
+
+  if (yyss + yystacksize - 1 <= yyssp)
+#if !defined yyoverflow && !defined YYSTACK_RELOCATE
+    YYNOMEM;
+#else
     {
-        yyn = *yys;
-        if (yyn >= '0' && yyn <= '9')
-            yydebug = yyn - '0';
+      /* Get the current used size of the three stacks, in elements.  */
+      YYPTRDIFF_T yysize = yyssp - yyss + 1;
+
+# if defined yyoverflow
+      {
+        /* Give user a chance to reallocate the stack.  Use copies of
+           these so that the &'s don't force the real ones into
+           memory.  */
+        yy_state_t *yyss1 = yyss;
+        YYSTYPE *yyvs1 = yyvs;
+
+        /* Each stack pointer address is followed by the size of the
+           data in use in that stack, in bytes.  This used to be a
+           conditional around just the two extra args, but that might
+           be undefined if yyoverflow is a macro.  */
+        yyoverflow (YY_("memory exhausted"),
+                    &yyss1, yysize * YYSIZEOF (*yyssp),
+                    &yyvs1, yysize * YYSIZEOF (*yyvsp),
+                    &yystacksize);
+        yyss = yyss1;
+        yyvs = yyvs1;
+      }
+# else /* defined YYSTACK_RELOCATE */
+      /* Extend the stack our own way.  */
+      if (YYMAXDEPTH <= yystacksize)
+        YYNOMEM;
+      yystacksize *= 2;
+      if (YYMAXDEPTH < yystacksize)
+        yystacksize = YYMAXDEPTH;
+
+      {
+        yy_state_t *yyss1 = yyss;
+        union yyalloc *yyptr =
+          YY_CAST (union yyalloc *,
+                   YYSTACK_ALLOC (YY_CAST (YYSIZE_T, YYSTACK_BYTES (yystacksize))));
+        if (! yyptr)
+          YYNOMEM;
+        YYSTACK_RELOCATE (yyss_alloc, yyss);
+        YYSTACK_RELOCATE (yyvs_alloc, yyvs);
+#  undef YYSTACK_RELOCATE
+        if (yyss1 != yyssa)
+          YYSTACK_FREE (yyss1);
+      }
+# endif
+
+      yyssp = yyss + yysize - 1;
+      yyvsp = yyvs + yysize - 1;
+
+      YY_IGNORE_USELESS_CAST_BEGIN
+      YYDPRINTF ((stderr, "Stack size increased to %ld\n",
+                  YY_CAST (long, yystacksize)));
+      YY_IGNORE_USELESS_CAST_END
+
+      if (yyss + yystacksize - 1 <= yyssp)
+        YYABORT;
     }
-#endif
+#endif /* !defined yyoverflow && !defined YYSTACK_RELOCATE */
 
-    yynerrs = 0;
-    yyerrflag = 0;
-    yychar = YYEMPTY;
-    yystate = 0;
 
-#if YYPURE
-    memset(&yystack, 0, sizeof(yystack));
-#endif
+  if (yystate == YYFINAL)
+    YYACCEPT;
+
+  goto yybackup;
+
 
-    if (yystack.s_base == NULL && yygrowstack(&yystack)) goto yyoverflow;
-    yystack.s_mark = yystack.s_base;
-    yystack.l_mark = yystack.l_base;
-    yystate = 0;
-    *yystack.s_mark = 0;
+/*-----------.
+| yybackup.  |
+`-----------*/
+yybackup:
+  /* Do appropriate processing given the current state.  Read a
+     lookahead token if we need one and don't already have one.  */
 
-yyloop:
-    if ((yyn = yydefred[yystate]) != 0) goto yyreduce;
-    if (yychar < 0)
+  /* First try to decide what to do without reference to lookahead token.  */
+  yyn = yypact[yystate];
+  if (yypact_value_is_default (yyn))
+    goto yydefault;
+
+  /* Not known => get a lookahead token if don't already have one.  */
+
+  /* YYCHAR is either empty, or end-of-input, or a valid lookahead.  */
+  if (yychar == YYEMPTY)
     {
-        if ((yychar = YYLEX) < 0) yychar = 0;
-#if YYDEBUG
-        if (yydebug)
-        {
-            yys = 0;
-            if (yychar <= YYMAXTOKEN) yys = yyname[yychar];
-            if (!yys) yys = "illegal-symbol";
-            printf("%sdebug: state %d, reading %d (%s)\n",
-                    YYPREFIX, yystate, yychar, yys);
-        }
-#endif
+      YYDPRINTF ((stderr, "Reading a token\n"));
+      yychar = yylex (&yylval);
     }
-    if ((yyn = yysindex[yystate]) && (yyn += yychar) >= 0 &&
-            yyn <= YYTABLESIZE && yycheck[yyn] == yychar)
+
+  if (yychar <= YYEOF)
     {
-#if YYDEBUG
-        if (yydebug)
-            printf("%sdebug: state %d, shifting to state %d\n",
-                    YYPREFIX, yystate, yytable[yyn]);
-#endif
-        if (yystack.s_mark >= yystack.s_last && yygrowstack(&yystack))
-        {
-            goto yyoverflow;
-        }
-        yystate = yytable[yyn];
-        *++yystack.s_mark = yytable[yyn];
-        *++yystack.l_mark = yylval;
-        yychar = YYEMPTY;
-        if (yyerrflag > 0)  --yyerrflag;
-        goto yyloop;
+      yychar = YYEOF;
+      yytoken = YYSYMBOL_YYEOF;
+      YYDPRINTF ((stderr, "Now at end of input.\n"));
     }
-    if ((yyn = yyrindex[yystate]) && (yyn += yychar) >= 0 &&
-            yyn <= YYTABLESIZE && yycheck[yyn] == yychar)
+  else if (yychar == YYerror)
     {
-        yyn = yytable[yyn];
-        goto yyreduce;
+      /* The scanner already issued an error message, process directly
+         to error recovery.  But do not keep the error token as
+         lookahead, it is too special and may lead us to an endless
+         loop in error recovery. */
+      yychar = YYUNDEF;
+      yytoken = YYSYMBOL_YYerror;
+      goto yyerrlab1;
     }
-    if (yyerrflag) goto yyinrecovery;
-
-    yyerror("syntax error");
-
-    goto yyerrlab;
-
-yyerrlab:
-    ++yynerrs;
-
-yyinrecovery:
-    if (yyerrflag < 3)
+  else
     {
-        yyerrflag = 3;
-        for (;;)
-        {
-            if ((yyn = yysindex[*yystack.s_mark]) && (yyn += YYERRCODE) >= 0 &&
-                    yyn <= YYTABLESIZE && yycheck[yyn] == YYERRCODE)
-            {
-#if YYDEBUG
-                if (yydebug)
-                    printf("%sdebug: state %d, error recovery shifting\
- to state %d\n", YYPREFIX, *yystack.s_mark, yytable[yyn]);
-#endif
-                if (yystack.s_mark >= yystack.s_last && yygrowstack(&yystack))
-                {
-                    goto yyoverflow;
-                }
-                yystate = yytable[yyn];
-                *++yystack.s_mark = yytable[yyn];
-                *++yystack.l_mark = yylval;
-                goto yyloop;
-            }
-            else
-            {
-#if YYDEBUG
-                if (yydebug)
-                    printf("%sdebug: error recovery discarding state %d\n",
-                            YYPREFIX, *yystack.s_mark);
-#endif
-                if (yystack.s_mark <= yystack.s_base) goto yyabort;
-                --yystack.s_mark;
-                --yystack.l_mark;
-            }
-        }
+      yytoken = YYTRANSLATE (yychar);
+      YY_SYMBOL_PRINT ("Next token is", yytoken, &yylval, &yylloc);
     }
-    else
+
+  /* If the proper action on seeing token YYTOKEN is to reduce or to
+     detect an error, take that action.  */
+  yyn += yytoken;
+  if (yyn < 0 || YYLAST < yyn || yycheck[yyn] != yytoken)
+    goto yydefault;
+  yyn = yytable[yyn];
+  if (yyn <= 0)
     {
-        if (yychar == 0) goto yyabort;
-#if YYDEBUG
-        if (yydebug)
-        {
-            yys = 0;
-            if (yychar <= YYMAXTOKEN) yys = yyname[yychar];
-            if (!yys) yys = "illegal-symbol";
-            printf("%sdebug: state %d, error recovery discards token %d (%s)\n",
-                    YYPREFIX, yystate, yychar, yys);
-        }
-#endif
-        yychar = YYEMPTY;
-        goto yyloop;
+      if (yytable_value_is_error (yyn))
+        goto yyerrlab;
+      yyn = -yyn;
+      goto yyreduce;
     }
 
+  /* Count tokens shifted since error; after three, turn off error
+     status.  */
+  if (yyerrstatus)
+    yyerrstatus--;
+
+  /* Shift the lookahead token.  */
+  YY_SYMBOL_PRINT ("Shifting", yytoken, &yylval, &yylloc);
+  yystate = yyn;
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  *++yyvsp = yylval;
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
+
+  /* Discard the shifted token.  */
+  yychar = YYEMPTY;
+  goto yynewstate;
+
+
+/*-----------------------------------------------------------.
+| yydefault -- do the default action for the current state.  |
+`-----------------------------------------------------------*/
+yydefault:
+  yyn = yydefact[yystate];
+  if (yyn == 0)
+    goto yyerrlab;
+  goto yyreduce;
+
+
+/*-----------------------------.
+| yyreduce -- do a reduction.  |
+`-----------------------------*/
 yyreduce:
-#if YYDEBUG
-    if (yydebug)
-        printf("%sdebug: state %d, reducing by rule %d (%s)\n",
-                YYPREFIX, yystate, yyn, yyrule[yyn]);
-#endif
-    yym = yylen[yyn];
-    if (yym)
-        yyval = yystack.l_mark[1-yym];
-    else
-        memset(&yyval, 0, sizeof yyval);
-    switch (yyn)
+  /* yyn is the number of a rule to reduce with.  */
+  yylen = yyr2[yyn];
+
+  /* If YYLEN is nonzero, implement the default value of the action:
+     '$$ = $1'.
+
+     Otherwise, the following line sets YYVAL to garbage.
+     This behavior is undocumented and Bison
+     users should not rely upon it.  Assigning to YYVAL
+     unconditionally makes the parser a bit smaller, and it avoids a
+     GCC warning that YYVAL may be used uninitialized.  */
+  yyval = yyvsp[1-yylen];
+
+
+  YY_REDUCE_PRINT (yyn);
+  switch (yyn)
     {
-case 1:
-#line 45 "cgram.y"
-	{}
-break;
-case 2:
-#line 48 "cgram.y"
-	{}
-break;
-case 3:
-#line 49 "cgram.y"
-	{}
-break;
-case 4:
-#line 52 "cgram.y"
-	{}
-break;
-case 5:
-#line 53 "cgram.y"
-	{}
-break;
-case 6:
-#line 56 "cgram.y"
-	{}
-break;
-case 7:
-#line 57 "cgram.y"
-	{}
-break;
-case 8:
-#line 60 "cgram.y"
-	{ yyval.id_ptr = dcl(yystack.l_mark[0].id_ptr, yystack.l_mark[-1].inttype, 0); }
-break;
-case 9:
+  case 2: /* prog: externs  */
+#line 58 "cgram.y"
+                                {}
+#line 1507 "y.tab.c"
+    break;
+
+  case 3: /* externs: %empty  */
 #line 61 "cgram.y"
-	{ yyval.id_ptr = dcl(yystack.l_mark[0].id_ptr, yystack.l_mark[-2].id_ptr->i_type&~T_ARRAY, 0); }
-break;
-case 10:
-#line 64 "cgram.y"
-	{ yyval.id_ptr = dclr(yystack.l_mark[0].str_ptr, 0, 1); }
-break;
-case 11:
+                                {}
+#line 1513 "y.tab.c"
+    break;
+
+  case 4: /* externs: externs extern  */
+#line 62 "cgram.y"
+                                {}
+#line 1519 "y.tab.c"
+    break;
+
+  case 5: /* extern: dcl ';'  */
 #line 65 "cgram.y"
-	{ yyval.id_ptr = dclr(yystack.l_mark[-2].str_ptr, T_ARRAY, 1); }
-break;
-case 12:
+                                {}
+#line 1525 "y.tab.c"
+    break;
+
+  case 6: /* extern: func  */
 #line 66 "cgram.y"
-	{ yyval.id_ptr = dclr(yystack.l_mark[-3].str_ptr, T_ARRAY, atoi(yystack.l_mark[-1].str_ptr)); }
-break;
-case 13:
+                                {}
+#line 1531 "y.tab.c"
+    break;
+
+  case 7: /* dcls: %empty  */
 #line 69 "cgram.y"
-	{ yyval.inttype = T_INT; }
-break;
-case 14:
+                                {}
+#line 1537 "y.tab.c"
+    break;
+
+  case 8: /* dcls: dcls dcl ';'  */
 #line 70 "cgram.y"
-	{ yyval.inttype = T_DOUBLE; }
-break;
-case 15:
-#line 71 "cgram.y"
-	{ yyval.inttype = T_DOUBLE; }
-break;
-case 16:
-#line 72 "cgram.y"
-	{ yyval.inttype = T_INT; }
-break;
-case 17:
-#line 75 "cgram.y"
-	{ ftail(); }
-break;
-case 18:
+                                {}
+#line 1543 "y.tab.c"
+    break;
+
+  case 9: /* dcl: type dclr  */
+#line 73 "cgram.y"
+                                { SEM(dcl((yyvsp[0].id_ptr), (yyvsp[-1].inttype), 0)); (yyval.inttype) = (yyvsp[-1].inttype); }
+#line 1549 "y.tab.c"
+    break;
+
+  case 10: /* dcl: dcl ',' dclr  */
+#line 74 "cgram.y"
+                                { SEM(dcl((yyvsp[0].id_ptr), (yyvsp[-2].inttype), 0)); (yyval.inttype) = (yyvsp[-2].inttype); }
+#line 1555 "y.tab.c"
+    break;
+
+  case 11: /* dclr: ID  */
+#line 77 "cgram.y"
+                                { SEM((yyval.id_ptr) = dclr((yyvsp[0].str_ptr), 0, 1)); }
+#line 1561 "y.tab.c"
+    break;
+
+  case 12: /* dclr: ID '[' ']'  */
 #line 78 "cgram.y"
-	{ fhead(yystack.l_mark[-3].id_ptr); }
-break;
-case 19:
-#line 81 "cgram.y"
-	{ yyval.id_ptr = fname(yystack.l_mark[-1].inttype, yystack.l_mark[0].str_ptr); }
-break;
-case 20:
+                                { SEM((yyval.id_ptr) = dclr((yyvsp[-2].str_ptr), T_ARRAY, 1)); }
+#line 1567 "y.tab.c"
+    break;
+
+  case 13: /* dclr: ID '[' CON ']'  */
+#line 79 "cgram.y"
+                                { SEM((yyval.id_ptr) = dclr((yyvsp[-3].str_ptr), T_ARRAY, atoi((yyvsp[-1].str_ptr)))); }
+#line 1573 "y.tab.c"
+    break;
+
+  case 14: /* type: CHAR  */
 #line 82 "cgram.y"
-	{ yyval.id_ptr = fname(T_INT, yystack.l_mark[0].str_ptr); }
-break;
-case 21:
+                                { (yyval.inttype) = T_INT; }
+#line 1579 "y.tab.c"
+    break;
+
+  case 15: /* type: FLOAT  */
+#line 83 "cgram.y"
+                                { (yyval.inttype) = T_DOUBLE; }
+#line 1585 "y.tab.c"
+    break;
+
+  case 16: /* type: DOUBLE  */
+#line 84 "cgram.y"
+                                { (yyval.inttype) = T_DOUBLE; }
+#line 1591 "y.tab.c"
+    break;
+
+  case 17: /* type: INT  */
 #line 85 "cgram.y"
-	{ enterblock(); }
-break;
-case 22:
-#line 86 "cgram.y"
-	{ enterblock(); }
-break;
-case 23:
-#line 89 "cgram.y"
-	{ dcl(yystack.l_mark[0].id_ptr, yystack.l_mark[-1].inttype, PARAM); }
-break;
-case 24:
-#line 90 "cgram.y"
-	{ dcl(yystack.l_mark[0].id_ptr, yystack.l_mark[-1].inttype, PARAM); }
-break;
-case 25:
-#line 93 "cgram.y"
-	{ startloopscope(); }
-break;
-case 26:
-#line 96 "cgram.y"
-	{ yyval.inttype = m(); }
-break;
-case 27:
+                                { (yyval.inttype) = T_INT; }
+#line 1597 "y.tab.c"
+    break;
+
+  case 18: /* func: fhead stmts '}'  */
+#line 88 "cgram.y"
+                                { SEM(ftail()); }
+#line 1603 "y.tab.c"
+    break;
+
+  case 19: /* fhead: fname fargs '{' dcls  */
+#line 91 "cgram.y"
+                                { SEM(fhead((yyvsp[-3].id_ptr))); }
+#line 1609 "y.tab.c"
+    break;
+
+  case 20: /* fname: type ID  */
+#line 94 "cgram.y"
+                                { SEM((yyval.id_ptr) = fname((yyvsp[-1].inttype), (yyvsp[0].str_ptr))); }
+#line 1615 "y.tab.c"
+    break;
+
+  case 21: /* fname: ID  */
+#line 95 "cgram.y"
+                                { SEM((yyval.id_ptr) = fname(T_INT, (yyvsp[0].str_ptr))); }
+#line 1621 "y.tab.c"
+    break;
+
+  case 22: /* fargs: '(' ')'  */
+#line 98 "cgram.y"
+                                { SEM(enterblock()); }
+#line 1627 "y.tab.c"
+    break;
+
+  case 23: /* fargs: '(' args ')'  */
 #line 99 "cgram.y"
-	{ yyval.rec_ptr = n(); }
-break;
-case 28:
+                                { SEM(enterblock()); }
+#line 1633 "y.tab.c"
+    break;
+
+  case 24: /* args: type dclr  */
 #line 102 "cgram.y"
-	{ }
-break;
-case 29:
-#line 105 "cgram.y"
-	{ }
-break;
-case 30:
+                                { SEM(dcl((yyvsp[0].id_ptr), (yyvsp[-1].inttype), PARAM)); }
+#line 1639 "y.tab.c"
+    break;
+
+  case 25: /* args: args ',' type dclr  */
+#line 103 "cgram.y"
+                                { SEM(dcl((yyvsp[0].id_ptr), (yyvsp[-1].inttype), PARAM)); }
+#line 1645 "y.tab.c"
+    break;
+
+  case 26: /* s: %empty  */
 #line 106 "cgram.y"
-	{ }
-break;
-case 31:
+                                { SEM(startloopscope()); }
+#line 1651 "y.tab.c"
+    break;
+
+  case 27: /* m: %empty  */
 #line 109 "cgram.y"
-	{ }
-break;
-case 32:
-#line 110 "cgram.y"
-	{ }
-break;
-case 33:
-#line 113 "cgram.y"
-	{ labeldcl(yystack.l_mark[-1].str_ptr); }
-break;
-case 34:
-#line 114 "cgram.y"
-	{ labeldcl(yystack.l_mark[-1].str_ptr); }
-break;
-case 35:
-#line 117 "cgram.y"
-	{ bgnstmt(); }
-break;
-case 36:
-#line 121 "cgram.y"
-	{ }
-break;
-case 37:
+                                { SEM((yyval.inttype) = m()); }
+#line 1657 "y.tab.c"
+    break;
+
+  case 28: /* n: %empty  */
+#line 112 "cgram.y"
+                                { SEM((yyval.rec_ptr) = n()); }
+#line 1663 "y.tab.c"
+    break;
+
+  case 29: /* block: '{' stmts '}'  */
+#line 115 "cgram.y"
+                                { }
+#line 1669 "y.tab.c"
+    break;
+
+  case 30: /* stmts: %empty  */
+#line 118 "cgram.y"
+                                { }
+#line 1675 "y.tab.c"
+    break;
+
+  case 31: /* stmts: stmts lblstmt  */
+#line 119 "cgram.y"
+                                { }
+#line 1681 "y.tab.c"
+    break;
+
+  case 32: /* lblstmt: b stmt  */
+#line 122 "cgram.y"
+                                { }
+#line 1687 "y.tab.c"
+    break;
+
+  case 33: /* lblstmt: b labels stmt  */
 #line 123 "cgram.y"
-	{ doif(yystack.l_mark[-4].rec_ptr, yystack.l_mark[-2].inttype, yystack.l_mark[0].inttype); }
-break;
-case 38:
-#line 125 "cgram.y"
-	{ doifelse(yystack.l_mark[-8].rec_ptr, yystack.l_mark[-6].inttype, yystack.l_mark[-3].rec_ptr, yystack.l_mark[-2].inttype, yystack.l_mark[0].inttype); }
-break;
-case 39:
+                                { }
+#line 1693 "y.tab.c"
+    break;
+
+  case 34: /* labels: ID ':'  */
+#line 126 "cgram.y"
+                                { SEM(labeldcl((yyvsp[-1].str_ptr))); }
+#line 1699 "y.tab.c"
+    break;
+
+  case 35: /* labels: labels ID ':'  */
 #line 127 "cgram.y"
-	{ dowhile(yystack.l_mark[-7].inttype, yystack.l_mark[-6].rec_ptr, yystack.l_mark[-4].inttype, yystack.l_mark[-1].rec_ptr, yystack.l_mark[0].inttype); }
-break;
-case 40:
-#line 129 "cgram.y"
-	{ dodo(yystack.l_mark[-9].inttype, yystack.l_mark[-4].inttype, yystack.l_mark[-3].rec_ptr, yystack.l_mark[0].inttype); }
-break;
-case 41:
-#line 131 "cgram.y"
-	{ dofor(yystack.l_mark[-11].inttype, yystack.l_mark[-10].rec_ptr, yystack.l_mark[-8].inttype, yystack.l_mark[-6].rec_ptr, yystack.l_mark[-4].inttype, yystack.l_mark[-1].rec_ptr, yystack.l_mark[0].inttype); }
-break;
-case 42:
-#line 133 "cgram.y"
-	{ docontinue(); }
-break;
-case 43:
-#line 135 "cgram.y"
-	{ dobreak(); }
-break;
-case 44:
-#line 137 "cgram.y"
-	{ dogoto(yystack.l_mark[-1].str_ptr); }
-break;
-case 45:
-#line 139 "cgram.y"
-	{ doret((struct sem_rec *) NULL); }
-break;
-case 46:
-#line 141 "cgram.y"
-	{ doret(yystack.l_mark[-1].rec_ptr); }
-break;
-case 47:
-#line 143 "cgram.y"
-	{ }
-break;
-case 48:
-#line 145 "cgram.y"
-	{ }
-break;
-case 49:
+                                { SEM(labeldcl((yyvsp[-1].str_ptr))); }
+#line 1705 "y.tab.c"
+    break;
+
+  case 36: /* b: %empty  */
+#line 130 "cgram.y"
+                                { SEM(bgnstmt()); }
+#line 1711 "y.tab.c"
+    break;
+
+  case 37: /* stmt: expr ';'  */
+#line 134 "cgram.y"
+                { }
+#line 1717 "y.tab.c"
+    break;
+
+  case 38: /* stmt: IF '(' cexpr ')' m lblstmt m  */
+#line 136 "cgram.y"
+                { SEM(doif((yyvsp[-4].rec_ptr), (yyvsp[-2].inttype), (yyvsp[0].inttype))); }
+#line 1723 "y.tab.c"
+    break;
+
+  case 39: /* stmt: IF '(' cexpr ')' m lblstmt ELSE n m lblstmt m  */
+#line 138 "cgram.y"
+                { SEM(doifelse((yyvsp[-8].rec_ptr), (yyvsp[-6].inttype), (yyvsp[-3].rec_ptr), (yyvsp[-2].inttype), (yyvsp[0].inttype))); }
+#line 1729 "y.tab.c"
+    break;
+
+  case 40: /* stmt: WHILE '(' m cexpr ')' m s lblstmt n m  */
+#line 140 "cgram.y"
+                { SEM(dowhile((yyvsp[-7].inttype), (yyvsp[-6].rec_ptr), (yyvsp[-4].inttype), (yyvsp[-1].rec_ptr), (yyvsp[0].inttype))); }
+#line 1735 "y.tab.c"
+    break;
+
+  case 41: /* stmt: DO m s lblstmt WHILE '(' m cexpr ')' ';' m  */
+#line 142 "cgram.y"
+                { SEM(dodo((yyvsp[-9].inttype), (yyvsp[-4].inttype), (yyvsp[-3].rec_ptr), (yyvsp[0].inttype))); }
+#line 1741 "y.tab.c"
+    break;
+
+  case 42: /* stmt: FOR '(' expro ';' m cexpro ';' m expro n ')' m s lblstmt n m  */
+#line 144 "cgram.y"
+                { SEM(dofor((yyvsp[-11].inttype), (yyvsp[-10].rec_ptr), (yyvsp[-8].inttype), (yyvsp[-6].rec_ptr), (yyvsp[-4].inttype), (yyvsp[-1].rec_ptr), (yyvsp[0].inttype))); }
+#line 1747 "y.tab.c"
+    break;
+
+  case 43: /* stmt: CONTINUE ';'  */
+#line 146 "cgram.y"
+                { SEM(docontinue()); }
+#line 1753 "y.tab.c"
+    break;
+
+  case 44: /* stmt: BREAK ';'  */
 #line 148 "cgram.y"
-	{ yyval.rec_ptr = node(0, 0, n(), 0); }
-break;
-case 50:
-#line 149 "cgram.y"
-	{}
-break;
-case 51:
+                { SEM(dobreak()); }
+#line 1759 "y.tab.c"
+    break;
+
+  case 45: /* stmt: GOTO ID ';'  */
+#line 150 "cgram.y"
+                { SEM(dogoto((yyvsp[-1].str_ptr))); }
+#line 1765 "y.tab.c"
+    break;
+
+  case 46: /* stmt: RETURN ';'  */
 #line 152 "cgram.y"
-	{ yyval.rec_ptr = rel("==", yystack.l_mark[-2].rec_ptr, yystack.l_mark[0].rec_ptr); }
-break;
-case 52:
-#line 153 "cgram.y"
-	{ yyval.rec_ptr = rel("!=", yystack.l_mark[-2].rec_ptr, yystack.l_mark[0].rec_ptr); }
-break;
-case 53:
+                { SEM(doret((struct sem_rec *) NULL)); }
+#line 1771 "y.tab.c"
+    break;
+
+  case 47: /* stmt: RETURN expr ';'  */
 #line 154 "cgram.y"
-	{ yyval.rec_ptr = rel("<=", yystack.l_mark[-2].rec_ptr, yystack.l_mark[0].rec_ptr); }
-break;
-case 54:
-#line 155 "cgram.y"
-	{ yyval.rec_ptr = rel(">=", yystack.l_mark[-2].rec_ptr, yystack.l_mark[0].rec_ptr); }
-break;
-case 55:
+                { SEM(doret((yyvsp[-1].rec_ptr))); }
+#line 1777 "y.tab.c"
+    break;
+
+  case 48: /* stmt: block  */
 #line 156 "cgram.y"
-	{ yyval.rec_ptr = rel("<",  yystack.l_mark[-2].rec_ptr, yystack.l_mark[0].rec_ptr); }
-break;
-case 56:
-#line 157 "cgram.y"
-	{ yyval.rec_ptr = rel(">",  yystack.l_mark[-2].rec_ptr, yystack.l_mark[0].rec_ptr); }
-break;
-case 57:
+                { }
+#line 1783 "y.tab.c"
+    break;
+
+  case 49: /* stmt: ';'  */
 #line 158 "cgram.y"
-	{ yyval.rec_ptr = ccand(yystack.l_mark[-3].rec_ptr, yystack.l_mark[-1].inttype, yystack.l_mark[0].rec_ptr); }
-break;
-case 58:
-#line 159 "cgram.y"
-	{ yyval.rec_ptr = ccor(yystack.l_mark[-3].rec_ptr, yystack.l_mark[-1].inttype, yystack.l_mark[0].rec_ptr); }
-break;
-case 59:
-#line 160 "cgram.y"
-	{ yyval.rec_ptr = ccnot(yystack.l_mark[0].rec_ptr); }
-break;
-case 60:
+                { }
+#line 1789 "y.tab.c"
+    break;
+
+  case 50: /* cexpro: %empty  */
 #line 161 "cgram.y"
-	{ yyval.rec_ptr = ccexpr(yystack.l_mark[0].rec_ptr); }
-break;
-case 61:
-#line 164 "cgram.y"
-	{ yyval.rec_ptr = yystack.l_mark[0].rec_ptr; }
-break;
-case 62:
+                                { SEM((yyval.rec_ptr) = node(0, 0, n(), 0)); }
+#line 1795 "y.tab.c"
+    break;
+
+  case 51: /* cexpro: cexpr  */
+#line 162 "cgram.y"
+                                {}
+#line 1801 "y.tab.c"
+    break;
+
+  case 52: /* cexpr: expr EQ expr  */
 #line 165 "cgram.y"
-	{ yyval.rec_ptr = exprs(yystack.l_mark[-2].rec_ptr, yystack.l_mark[0].rec_ptr); }
-break;
-case 63:
+                                { SEM((yyval.rec_ptr) = rel(Q_EQ,     (yyvsp[-2].rec_ptr), (yyvsp[0].rec_ptr))); }
+#line 1807 "y.tab.c"
+    break;
+
+  case 53: /* cexpr: expr NE expr  */
+#line 166 "cgram.y"
+                                { SEM((yyval.rec_ptr) = rel(Q_NE,     (yyvsp[-2].rec_ptr), (yyvsp[0].rec_ptr))); }
+#line 1813 "y.tab.c"
+    break;
+
+  case 54: /* cexpr: expr LE expr  */
+#line 167 "cgram.y"
+                                { SEM((yyval.rec_ptr) = rel(Q_LE,     (yyvsp[-2].rec_ptr), (yyvsp[0].rec_ptr))); }
+#line 1819 "y.tab.c"
+    break;
+
+  case 55: /* cexpr: expr GE expr  */
 #line 168 "cgram.y"
-	{}
-break;
-case 64:
+                                { SEM((yyval.rec_ptr) = rel(Q_GE,     (yyvsp[-2].rec_ptr), (yyvsp[0].rec_ptr))); }
+#line 1825 "y.tab.c"
+    break;
+
+  case 56: /* cexpr: expr LT expr  */
 #line 169 "cgram.y"
-	{}
-break;
-case 65:
+                                { SEM((yyval.rec_ptr) = rel(Q_LT,     (yyvsp[-2].rec_ptr), (yyvsp[0].rec_ptr))); }
+#line 1831 "y.tab.c"
+    break;
+
+  case 57: /* cexpr: expr GT expr  */
+#line 170 "cgram.y"
+                                { SEM((yyval.rec_ptr) = rel(Q_GT,     (yyvsp[-2].rec_ptr), (yyvsp[0].rec_ptr))); }
+#line 1837 "y.tab.c"
+    break;
+
+  case 58: /* cexpr: cexpr AND m cexpr  */
+#line 171 "cgram.y"
+                                { SEM((yyval.rec_ptr) = ccand((yyvsp[-3].rec_ptr), (yyvsp[-1].inttype), (yyvsp[0].rec_ptr))); }
+#line 1843 "y.tab.c"
+    break;
+
+  case 59: /* cexpr: cexpr OR m cexpr  */
 #line 172 "cgram.y"
-	{ yyval.rec_ptr = set("",   yystack.l_mark[-2].rec_ptr, yystack.l_mark[0].rec_ptr); }
-break;
-case 66:
+                                { SEM((yyval.rec_ptr) = ccor((yyvsp[-3].rec_ptr), (yyvsp[-1].inttype), (yyvsp[0].rec_ptr))); }
+#line 1849 "y.tab.c"
+    break;
+
+  case 60: /* cexpr: NOT cexpr  */
 #line 173 "cgram.y"
-	{ yyval.rec_ptr = set("|",  yystack.l_mark[-2].rec_ptr, yystack.l_mark[0].rec_ptr); }
-break;
-case 67:
+                                { SEM((yyval.rec_ptr) = ccnot((yyvsp[0].rec_ptr))); }
+#line 1855 "y.tab.c"
+    break;
+
+  case 61: /* cexpr: expr  */
 #line 174 "cgram.y"
-	{ yyval.rec_ptr = set("^",  yystack.l_mark[-2].rec_ptr, yystack.l_mark[0].rec_ptr); }
-break;
-case 68:
-#line 175 "cgram.y"
-	{ yyval.rec_ptr = set("&",  yystack.l_mark[-2].rec_ptr, yystack.l_mark[0].rec_ptr); }
-break;
-case 69:
-#line 176 "cgram.y"
-	{ yyval.rec_ptr = set("<<", yystack.l_mark[-2].rec_ptr, yystack.l_mark[0].rec_ptr); }
-break;
-case 70:
+                                { SEM((yyval.rec_ptr) = ccexpr((yyvsp[0].rec_ptr))); }
+#line 1861 "y.tab.c"
+    break;
+
+  case 62: /* exprs: expr  */
 #line 177 "cgram.y"
-	{ yyval.rec_ptr = set(">>", yystack.l_mark[-2].rec_ptr, yystack.l_mark[0].rec_ptr); }
-break;
-case 71:
+                                { (yyval.rec_ptr) = (yyvsp[0].rec_ptr); }
+#line 1867 "y.tab.c"
+    break;
+
+  case 63: /* exprs: exprs ',' expr  */
 #line 178 "cgram.y"
-	{ yyval.rec_ptr = set("+",  yystack.l_mark[-2].rec_ptr, yystack.l_mark[0].rec_ptr); }
-break;
-case 72:
-#line 179 "cgram.y"
-	{ yyval.rec_ptr = set("-",  yystack.l_mark[-2].rec_ptr, yystack.l_mark[0].rec_ptr); }
-break;
-case 73:
-#line 180 "cgram.y"
-	{ yyval.rec_ptr = set("*",  yystack.l_mark[-2].rec_ptr, yystack.l_mark[0].rec_ptr); }
-break;
-case 74:
+                                { SEM((yyval.rec_ptr) = exprs((yyvsp[-2].rec_ptr), (yyvsp[0].rec_ptr))); }
+#line 1873 "y.tab.c"
+    break;
+
+  case 64: /* expro: %empty  */
 #line 181 "cgram.y"
-	{ yyval.rec_ptr = set("/",  yystack.l_mark[-2].rec_ptr, yystack.l_mark[0].rec_ptr); }
-break;
-case 75:
+                                {}
+#line 1879 "y.tab.c"
+    break;
+
+  case 65: /* expro: expr  */
 #line 182 "cgram.y"
-	{ yyval.rec_ptr = set("%",  yystack.l_mark[-2].rec_ptr, yystack.l_mark[0].rec_ptr); }
-break;
-case 76:
-#line 183 "cgram.y"
-	{ yyval.rec_ptr = opb("|",  yystack.l_mark[-2].rec_ptr, yystack.l_mark[0].rec_ptr); }
-break;
-case 77:
-#line 184 "cgram.y"
-	{ yyval.rec_ptr = opb("^",  yystack.l_mark[-2].rec_ptr, yystack.l_mark[0].rec_ptr); }
-break;
-case 78:
+                                {}
+#line 1885 "y.tab.c"
+    break;
+
+  case 66: /* expr: lval SET expr  */
 #line 185 "cgram.y"
-	{ yyval.rec_ptr = opb("&",  yystack.l_mark[-2].rec_ptr, yystack.l_mark[0].rec_ptr); }
-break;
-case 79:
+                                { SEM((yyval.rec_ptr) = set(Q_ASSIGN, (yyvsp[-2].rec_ptr), (yyvsp[0].rec_ptr))); }
+#line 1891 "y.tab.c"
+    break;
+
+  case 67: /* expr: lval SETOR expr  */
 #line 186 "cgram.y"
-	{ yyval.rec_ptr = opb("<<", yystack.l_mark[-2].rec_ptr, yystack.l_mark[0].rec_ptr); }
-break;
-case 80:
+                                { SEM((yyval.rec_ptr) = set(Q_OR,     (yyvsp[-2].rec_ptr), (yyvsp[0].rec_ptr))); }
+#line 1897 "y.tab.c"
+    break;
+
+  case 68: /* expr: lval SETXOR expr  */
 #line 187 "cgram.y"
-	{ yyval.rec_ptr = opb(">>", yystack.l_mark[-2].rec_ptr, yystack.l_mark[0].rec_ptr); }
-break;
-case 81:
+                                { SEM((yyval.rec_ptr) = set(Q_XOR,    (yyvsp[-2].rec_ptr), (yyvsp[0].rec_ptr))); }
+#line 1903 "y.tab.c"
+    break;
+
+  case 69: /* expr: lval SETAND expr  */
 #line 188 "cgram.y"
-	{ yyval.rec_ptr = op2("+",  yystack.l_mark[-2].rec_ptr, yystack.l_mark[0].rec_ptr); }
-break;
-case 82:
+                                { SEM((yyval.rec_ptr) = set(Q_AND,    (yyvsp[-2].rec_ptr), (yyvsp[0].rec_ptr))); }
+#line 1909 "y.tab.c"
+    break;
+
+  case 70: /* expr: lval SETLSH expr  */
 #line 189 "cgram.y"
-	{ yyval.rec_ptr = op2("-",  yystack.l_mark[-2].rec_ptr, yystack.l_mark[0].rec_ptr); }
-break;
-case 83:
+                                { SEM((yyval.rec_ptr) = set(Q_LSH,    (yyvsp[-2].rec_ptr), (yyvsp[0].rec_ptr))); }
+#line 1915 "y.tab.c"
+    break;
+
+  case 71: /* expr: lval SETRSH expr  */
 #line 190 "cgram.y"
-	{ yyval.rec_ptr = op2("*",  yystack.l_mark[-2].rec_ptr, yystack.l_mark[0].rec_ptr); }
-break;
-case 84:
+                                { SEM((yyval.rec_ptr) = set(Q_RSH,    (yyvsp[-2].rec_ptr), (yyvsp[0].rec_ptr))); }
+#line 1921 "y.tab.c"
+    break;
+
+  case 72: /* expr: lval SETADD expr  */
 #line 191 "cgram.y"
-	{ yyval.rec_ptr = op2("/",  yystack.l_mark[-2].rec_ptr, yystack.l_mark[0].rec_ptr); }
-break;
-case 85:
+                                { SEM((yyval.rec_ptr) = set(Q_ADD,    (yyvsp[-2].rec_ptr), (yyvsp[0].rec_ptr))); }
+#line 1927 "y.tab.c"
+    break;
+
+  case 73: /* expr: lval SETSUB expr  */
 #line 192 "cgram.y"
-	{ yyval.rec_ptr = op2("%",  yystack.l_mark[-2].rec_ptr, yystack.l_mark[0].rec_ptr); }
-break;
-case 86:
+                                { SEM((yyval.rec_ptr) = set(Q_SUB,    (yyvsp[-2].rec_ptr), (yyvsp[0].rec_ptr))); }
+#line 1933 "y.tab.c"
+    break;
+
+  case 74: /* expr: lval SETMUL expr  */
+#line 193 "cgram.y"
+                                { SEM((yyval.rec_ptr) = set(Q_MUL,    (yyvsp[-2].rec_ptr), (yyvsp[0].rec_ptr))); }
+#line 1939 "y.tab.c"
+    break;
+
+  case 75: /* expr: lval SETDIV expr  */
 #line 194 "cgram.y"
-	{ yyval.rec_ptr = yystack.l_mark[0].rec_ptr; }
-break;
-case 87:
+                                { SEM((yyval.rec_ptr) = set(Q_DIV,    (yyvsp[-2].rec_ptr), (yyvsp[0].rec_ptr))); }
+#line 1945 "y.tab.c"
+    break;
+
+  case 76: /* expr: lval SETMOD expr  */
 #line 195 "cgram.y"
-	{ yyval.rec_ptr = op1("-",      yystack.l_mark[0].rec_ptr); }
-break;
-case 88:
+                                { SEM((yyval.rec_ptr) = set(Q_MOD,    (yyvsp[-2].rec_ptr), (yyvsp[0].rec_ptr))); }
+#line 1951 "y.tab.c"
+    break;
+
+  case 77: /* expr: expr BITOR expr  */
 #line 196 "cgram.y"
-	{ yyval.rec_ptr = op1("~",      yystack.l_mark[0].rec_ptr); }
-break;
-case 89:
+                                { SEM((yyval.rec_ptr) = opb(Q_OR,     (yyvsp[-2].rec_ptr), (yyvsp[0].rec_ptr))); }
+#line 1957 "y.tab.c"
+    break;
+
+  case 78: /* expr: expr BITXOR expr  */
 #line 197 "cgram.y"
-	{ yyval.rec_ptr = op1("@",      yystack.l_mark[0].rec_ptr); }
-break;
-case 90:
+                                { SEM((yyval.rec_ptr) = opb(Q_XOR,    (yyvsp[-2].rec_ptr), (yyvsp[0].rec_ptr))); }
+#line 1963 "y.tab.c"
+    break;
+
+  case 79: /* expr: expr BITAND expr  */
 #line 198 "cgram.y"
-	{ yyval.rec_ptr = call(yystack.l_mark[-2].str_ptr, (struct sem_rec *) NULL); }
-break;
-case 91:
+                                { SEM((yyval.rec_ptr) = opb(Q_AND,    (yyvsp[-2].rec_ptr), (yyvsp[0].rec_ptr))); }
+#line 1969 "y.tab.c"
+    break;
+
+  case 80: /* expr: expr LSH expr  */
 #line 199 "cgram.y"
-	{ yyval.rec_ptr = call(yystack.l_mark[-3].str_ptr, yystack.l_mark[-1].rec_ptr); }
-break;
-case 92:
+                                { SEM((yyval.rec_ptr) = opb(Q_LSH,    (yyvsp[-2].rec_ptr), (yyvsp[0].rec_ptr))); }
+#line 1975 "y.tab.c"
+    break;
+
+  case 81: /* expr: expr RSH expr  */
 #line 200 "cgram.y"
-	{ yyval.rec_ptr = yystack.l_mark[-1].rec_ptr; }
-break;
-case 93:
+                                { SEM((yyval.rec_ptr) = opb(Q_RSH,    (yyvsp[-2].rec_ptr), (yyvsp[0].rec_ptr))); }
+#line 1981 "y.tab.c"
+    break;
+
+  case 82: /* expr: expr ADD expr  */
 #line 201 "cgram.y"
-	{ yyval.rec_ptr = con(yystack.l_mark[0].str_ptr); }
-break;
-case 94:
+                                { SEM((yyval.rec_ptr) = op2(Q_ADD,    (yyvsp[-2].rec_ptr), (yyvsp[0].rec_ptr))); }
+#line 1987 "y.tab.c"
+    break;
+
+  case 83: /* expr: expr SUB expr  */
 #line 202 "cgram.y"
-	{ yyval.rec_ptr = string(yystack.l_mark[0].str_ptr); }
-break;
-case 95:
+                                { SEM((yyval.rec_ptr) = op2(Q_SUB,    (yyvsp[-2].rec_ptr), (yyvsp[0].rec_ptr))); }
+#line 1993 "y.tab.c"
+    break;
+
+  case 84: /* expr: expr MUL expr  */
+#line 203 "cgram.y"
+                                { SEM((yyval.rec_ptr) = op2(Q_MUL,    (yyvsp[-2].rec_ptr), (yyvsp[0].rec_ptr))); }
+#line 1999 "y.tab.c"
+    break;
+
+  case 85: /* expr: expr DIV expr  */
+#line 204 "cgram.y"
+                                { SEM((yyval.rec_ptr) = op2(Q_DIV,    (yyvsp[-2].rec_ptr), (yyvsp[0].rec_ptr))); }
+#line 2005 "y.tab.c"
+    break;
+
+  case 86: /* expr: expr MOD expr  */
 #line 205 "cgram.y"
-	{ yyval.rec_ptr = id(yystack.l_mark[0].str_ptr); }
-break;
-case 96:
-#line 206 "cgram.y"
-	{ yyval.rec_ptr = tom_index(id(yystack.l_mark[-3].str_ptr), yystack.l_mark[-1].rec_ptr); }
-break;
-#line 1251 "y.tab.c"
+                                { SEM((yyval.rec_ptr) = op2(Q_MOD,    (yyvsp[-2].rec_ptr), (yyvsp[0].rec_ptr))); }
+#line 2011 "y.tab.c"
+    break;
+
+  case 87: /* expr: BITAND lval  */
+#line 207 "cgram.y"
+                                { (yyval.rec_ptr) = (yyvsp[0].rec_ptr); }
+#line 2017 "y.tab.c"
+    break;
+
+  case 88: /* expr: SUB expr  */
+#line 208 "cgram.y"
+                                { SEM((yyval.rec_ptr) = op1(Q_NEG,    (yyvsp[0].rec_ptr))); }
+#line 2023 "y.tab.c"
+    break;
+
+  case 89: /* expr: COM expr  */
+#line 209 "cgram.y"
+                                { SEM((yyval.rec_ptr) = op1(Q_COM,    (yyvsp[0].rec_ptr))); }
+#line 2029 "y.tab.c"
+    break;
+
+  case 90: /* expr: lval  */
+#line 210 "cgram.y"
+                                { SEM((yyval.rec_ptr) = op1(Q_DEREF,  (yyvsp[0].rec_ptr))); }
+#line 2035 "y.tab.c"
+    break;
+
+  case 91: /* expr: ID '(' ')'  */
+#line 211 "cgram.y"
+                                { SEM((yyval.rec_ptr) = call((yyvsp[-2].str_ptr), (struct sem_rec *) NULL)); }
+#line 2041 "y.tab.c"
+    break;
+
+  case 92: /* expr: ID '(' exprs ')'  */
+#line 212 "cgram.y"
+                                { SEM((yyval.rec_ptr) = call((yyvsp[-3].str_ptr), (yyvsp[-1].rec_ptr))); }
+#line 2047 "y.tab.c"
+    break;
+
+  case 93: /* expr: '(' expr ')'  */
+#line 213 "cgram.y"
+                                { (yyval.rec_ptr) = (yyvsp[-1].rec_ptr); }
+#line 2053 "y.tab.c"
+    break;
+
+  case 94: /* expr: CON  */
+#line 214 "cgram.y"
+                                { SEM((yyval.rec_ptr) = con((yyvsp[0].str_ptr))); }
+#line 2059 "y.tab.c"
+    break;
+
+  case 95: /* expr: STR  */
+#line 215 "cgram.y"
+                                { SEM((yyval.rec_ptr) = string((yyvsp[0].str_ptr))); }
+#line 2065 "y.tab.c"
+    break;
+
+  case 96: /* lval: ID  */
+#line 218 "cgram.y"
+                                { SEM((yyval.rec_ptr) = id((yyvsp[0].str_ptr))); }
+#line 2071 "y.tab.c"
+    break;
+
+  case 97: /* lval: ID '[' expr ']'  */
+#line 219 "cgram.y"
+                                { SEM((yyval.rec_ptr) = tom_index(id((yyvsp[-3].str_ptr)), (yyvsp[-1].rec_ptr))); }
+#line 2077 "y.tab.c"
+    break;
+
+
+#line 2081 "y.tab.c"
+
+      default: break;
+    }
+  /* User semantic actions sometimes alter yychar, and that requires
+     that yytoken be updated with the new translation.  We take the
+     approach of translating immediately before every use of yytoken.
+     One alternative is translating here after every semantic action,
+     but that translation would be missed if the semantic action invokes
+     YYABORT, YYACCEPT, or YYERROR immediately after altering yychar or
+     if it invokes YYBACKUP.  In the case of YYABORT or YYACCEPT, an
+     incorrect destructor might then be invoked immediately.  In the
+     case of YYERROR or YYBACKUP, subsequent parser actions might lead
+     to an incorrect destructor call or verbose syntax error message
+     before the lookahead is translated.  */
+  YY_SYMBOL_PRINT ("-> $$ =", YY_CAST (yysymbol_kind_t, yyr1[yyn]), &yyval, &yyloc);
+
+  YYPOPSTACK (yylen);
+  yylen = 0;
+
+  *++yyvsp = yyval;
+
+  /* Now 'shift' the result of the reduction.  Determine what state
+     that goes to, based on the state we popped back to and the rule
+     number reduced by.  */
+  {
+    const int yylhs = yyr1[yyn] - YYNTOKENS;
+    const int yyi = yypgoto[yylhs] + *yyssp;
+    yystate = (0 <= yyi && yyi <= YYLAST && yycheck[yyi] == *yyssp
+               ? yytable[yyi]
+               : yydefgoto[yylhs]);
+  }
+
+  goto yynewstate;
+
+
+/*--------------------------------------.
+| yyerrlab -- here on detecting error.  |
+`--------------------------------------*/
+yyerrlab:
+  /* Make sure we have latest lookahead translation.  See comments at
+     user semantic actions for why this is necessary.  */
+  yytoken = yychar == YYEMPTY ? YYSYMBOL_YYEMPTY : YYTRANSLATE (yychar);
+  /* If not already recovering from an error, report this error.  */
+  if (!yyerrstatus)
+    {
+      ++yynerrs;
+      yyerror (YY_("syntax error"));
     }
-    yystack.s_mark -= yym;
-    yystate = *yystack.s_mark;
-    yystack.l_mark -= yym;
-    yym = yylhs[yyn];
-    if (yystate == 0 && yym == 0)
+
+  if (yyerrstatus == 3)
     {
-#if YYDEBUG
-        if (yydebug)
-            printf("%sdebug: after reduction, shifting from state 0 to\
- state %d\n", YYPREFIX, YYFINAL);
-#endif
-        yystate = YYFINAL;
-        *++yystack.s_mark = YYFINAL;
-        *++yystack.l_mark = yyval;
-        if (yychar < 0)
+      /* If just tried and failed to reuse lookahead token after an
+         error, discard it.  */
+
+      if (yychar <= YYEOF)
         {
-            if ((yychar = YYLEX) < 0) yychar = 0;
-#if YYDEBUG
-            if (yydebug)
+          /* Return failure if at end of input.  */
+          if (yychar == YYEOF)
+            YYABORT;
+        }
+      else
+        {
+          yydestruct ("Error: discarding",
+                      yytoken, &yylval);
+          yychar = YYEMPTY;
+        }
+    }
+
+  /* Else will try to reuse lookahead token after shifting the error
+     token.  */
+  goto yyerrlab1;
+
+
+/*---------------------------------------------------.
+| yyerrorlab -- error raised explicitly by YYERROR.  |
+`---------------------------------------------------*/
+yyerrorlab:
+  /* Pacify compilers when the user code never invokes YYERROR and the
+     label yyerrorlab therefore never appears in user code.  */
+  if (0)
+    YYERROR;
+  ++yynerrs;
+
+  /* Do not reclaim the symbols of the rule whose action triggered
+     this YYERROR.  */
+  YYPOPSTACK (yylen);
+  yylen = 0;
+  YY_STACK_PRINT (yyss, yyssp);
+  yystate = *yyssp;
+  goto yyerrlab1;
+
+
+/*-------------------------------------------------------------.
+| yyerrlab1 -- common code for both syntax error and YYERROR.  |
+`-------------------------------------------------------------*/
+yyerrlab1:
+  yyerrstatus = 3;      /* Each real token shifted decrements this.  */
+
+  /* Pop stack until we find a state that shifts the error token.  */
+  for (;;)
+    {
+      yyn = yypact[yystate];
+      if (!yypact_value_is_default (yyn))
+        {
+          yyn += YYSYMBOL_YYerror;
+          if (0 <= yyn && yyn <= YYLAST && yycheck[yyn] == YYSYMBOL_YYerror)
             {
-                yys = 0;
-                if (yychar <= YYMAXTOKEN) yys = yyname[yychar];
-                if (!yys) yys = "illegal-symbol";
-                printf("%sdebug: state %d, reading %d (%s)\n",
-                        YYPREFIX, YYFINAL, yychar, yys);
+              yyn = yytable[yyn];
+              if (0 < yyn)
+                break;
             }
-#endif
         }
-        if (yychar == 0) goto yyaccept;
-        goto yyloop;
+
+      /* Pop the current state because it cannot handle the error token.  */
+      if (yyssp == yyss)
+        YYABORT;
+
+
+      yydestruct ("Error: popping",
+                  YY_ACCESSING_SYMBOL (yystate), yyvsp);
+      YYPOPSTACK (1);
+      yystate = *yyssp;
+      YY_STACK_PRINT (yyss, yyssp);
     }
-    if ((yyn = yygindex[yym]) && (yyn += yystate) >= 0 &&
-            yyn <= YYTABLESIZE && yycheck[yyn] == yystate)
-        yystate = yytable[yyn];
-    else
-        yystate = yydgoto[yym];
-#if YYDEBUG
-    if (yydebug)
-        printf("%sdebug: after reduction, shifting from state %d \
-to state %d\n", YYPREFIX, *yystack.s_mark, yystate);
-#endif
-    if (yystack.s_mark >= yystack.s_last && yygrowstack(&yystack))
+
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  *++yyvsp = yylval;
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
+
+
+  /* Shift the error token.  */
+  YY_SYMBOL_PRINT ("Shifting", YY_ACCESSING_SYMBOL (yyn), yyvsp, yylsp);
+
+  yystate = yyn;
+  goto yynewstate;
+
+
+/*-------------------------------------.
+| yyacceptlab -- YYACCEPT comes here.  |
+`-------------------------------------*/
+yyacceptlab:
+  yyresult = 0;
+  goto yyreturnlab;
+
+
+/*-----------------------------------.
+| yyabortlab -- YYABORT comes here.  |
+`-----------------------------------*/
+yyabortlab:
+  yyresult = 1;
+  goto yyreturnlab;
+
+
+/*-----------------------------------------------------------.
+| yyexhaustedlab -- YYNOMEM (memory exhaustion) comes here.  |
+`-----------------------------------------------------------*/
+yyexhaustedlab:
+  yyerror (YY_("memory exhausted"));
+  yyresult = 2;
+  goto yyreturnlab;
+
+
+/*----------------------------------------------------------.
+| yyreturnlab -- parsing is finished, clean up and return.  |
+`----------------------------------------------------------*/
+yyreturnlab:
+  if (yychar != YYEMPTY)
+    {
+      /* Make sure we have latest lookahead translation.  See comments at
+         user semantic actions for why this is necessary.  */
+      yytoken = YYTRANSLATE (yychar);
+      yydestruct ("Cleanup: discarding lookahead",
+                  yytoken, &yylval);
+    }
+  /* Do not reclaim the symbols of the rule whose action triggered
+     this YYABORT or YYACCEPT.  */
+  YYPOPSTACK (yylen);
+  YY_STACK_PRINT (yyss, yyssp);
+  while (yyssp != yyss)
     {
-        goto yyoverflow;
+      yydestruct ("Cleanup: popping",
+                  YY_ACCESSING_SYMBOL (+*yyssp), yyvsp);
+      YYPOPSTACK (1);
     }
-    *++yystack.s_mark = (short) yystate;
-    *++yystack.l_mark = yyval;
-    goto yyloop;
+#ifndef yyoverflow
+  if (yyss != yyssa)
+    YYSTACK_FREE (yyss);
+#endif
+
+  return yyresult;
+}
+
+#line 221 "cgram.y"
+
+# include <stdio.h>
+# include <string.h>
+# include <unistd.h>
+# include <pthread.h>
+# include <sys/stat.h>
+
+extern UNIT int lineno;
+
+static UNIT char *srcname;	/* file being compiled, NULL for stdin */
+
+static char **files;		/* files named on the command line */
+static int nfiles;		/* files in files */
+static int nextfile;		/* next of them to compile */
+static int failed;		/* nonzero if any of them failed */
+static pthread_mutex_t flock = PTHREAD_MUTEX_INITIALIZER; /* guards the above */
+
+/*
+ * compile - translate the program on fp, write the quads on out, return
+ *           nonzero if it had a syntax error
+ *
+ * Everything but the interned strings is started over, so a thread may
+ * compile one file after another.
+ */
+int compile(FILE *fp, FILE *out)
+{
+   int err, ph;
+
+   qout = out;
+   tsource(srcname);
+   ph = tenter(PH_READ);
+   readin(fp);
+   tenter(PH_PARSE);
+   enterblock();
+   enterblock();
+   if ((err = yyparse()) != 0)
+      yyerror("syntax error");
+   tenter(PH_WRITE);
+   pwait();
+   tenter(ph);
+   if (sstat)
+      symstats();
+   tflush();
+   symreset();
+   semreset();
+   return (err);
+}
+
+/*
+ * outname - name of the file the quads of file name go to: name with its
+ *           suffix, if any, replaced by .q, or .qb with -b
+ */
+char *outname(char *name)
+{
+   char *o, *dot, *slash;
+
+   o = alloc(strlen(name) + 4);
+   strcpy(o, name);
+   dot = strrchr(o, '.');
+   slash = strrchr(o, '/');
+   if (dot && (slash == NULL || dot > slash))
+      *dot = '\0';
+   strcat(o, qbinary ? ".qb" : ".q");
+   return (o);
+}
 
-yyoverflow:
-    yyerror("yacc stack overflow");
+/*
+ * worker - compile files until none are left
+ */
+void *worker(void *arg)
+{
+   FILE *fp, *out;
+   char *o;
+   int i, err;
 
-yyabort:
-    yyfreestack(&yystack);
-    return (1);
+   for (;;) {
+      pthread_mutex_lock(&flock);
+      i = nextfile++;
+      pthread_mutex_unlock(&flock);
+      if (i >= nfiles)
+         break;
+      srcname = files[i];
+      o = outname(files[i]);
+      err = 1;
+      if ((fp = fopen(files[i], "r")) == NULL)
+         fprintf(stderr, "csem: cannot open %s\n", files[i]);
+      else if ((out = fopen(o, "w")) == NULL) {
+         fprintf(stderr, "csem: cannot create %s\n", o);
+         fclose(fp);
+      }
+      else {
+         err = compile(fp, out);
+         fclose(fp);
+         if (fclose(out) != 0) {
+            fprintf(stderr, "csem: cannot write %s\n", o);
+            err = 1;
+         }
+      }
+      free(o);
+      if (err) {
+         pthread_mutex_lock(&flock);
+         failed = 1;
+         pthread_mutex_unlock(&flock);
+      }
+   }
+   if (sstat) {
+      strstats();
+      tflush();
+   }
+   return (NULL);
+}
 
-yyaccept:
-    yyfreestack(&yystack);
-    return (0);
+/* 
+ * main - read a program, and parse it
+ *
+ *    -B   leave branches on backpatch labels and emit the Bn=Lm lines
+ *    -b   write the quads in the binary form of qbin.h, for a back end
+ *         to read with qbread.c
+ *    -Cdir  keep the optimized quads of each function in directory dir,
+ *         and take a function unchanged since from there; the output is
+ *         the same
+ *    -G   print the basic blocks and control-flow graph of each function
+ *         on stderr
+ *    -jn  compile the files named on n threads (default one per processor)
+ *    -On  optimize at level n (-O alone is -O1)
+ *           1  local value numbering, constant folding and pooling,
+ *              copy propagation, dead temporary elimination, jump
+ *              threading and deletion of unreachable code
+ *           2  and loop-invariant code motion, strength reduction of
+ *              array subscripts by induction variables
+ *           3  and scalar variables kept in temporaries in static single
+ *              assignment form, sparse conditional constant propagation
+ *              and global value numbering over it, and calls to small
+ *              functions defined before them that call none expanded
+ *              in place
+ *    -Pfile  lay out the blocks of each function by the profile in file,
+ *         those that never ran after the rest
+ *    -p   print statistics of the optimization passes, and the time
+ *         spent reading, scanning, parsing, in the semantic actions,
+ *         optimizing and writing, on stderr
+ *    -profile  count the runs of each basic block, printing the counts
+ *         as a profile when the program exits
+ *    -stats  print the lengths of the chains of the identifier and
+ *         string tables, the most semantic records held at once, the
+ *         bytes allocated, the time spent in each phase as with -p, and
+ *         the temporaries and labels of each function, on stderr;
+ *         -stats=json prints them as JSON
+ *    -tn  optimize the functions of a file on n threads while it is
+ *         parsed; the output is the same.  Not with -G, which keeps the
+ *         graphs in order.
+ *
+ * With no files the program is read from stdin and its quads written on
+ * stdout; otherwise the quads of each file x.c go to x.q, or x.qb.
+ */
+main(int argc, char *argv[])
+{
+   pthread_t *tid;
+   int i, nthreads = 0;
+
+   for (i = 1; i < argc && argv[i][0] == '-'; i++)
+      if (strcmp(argv[i], "-B") == 0)
+         qbpatch = 1;
+      else if (strcmp(argv[i], "-b") == 0)
+         qbinary = 1;
+      else if (strncmp(argv[i], "-C", 2) == 0 && argv[i][2])
+         cachedir = &argv[i][2];
+      else if (strcmp(argv[i], "-G") == 0)
+         cfgdump = 1;
+      else if (strncmp(argv[i], "-j", 2) == 0 && atoi(&argv[i][2]) > 0)
+         nthreads = atoi(&argv[i][2]);
+      else if (strncmp(argv[i], "-O", 2) == 0)
+         optlevel = argv[i][2] ? atoi(&argv[i][2]) : 1;
+      else if (strncmp(argv[i], "-P", 2) == 0 && argv[i][2])
+         proffile = &argv[i][2];
+      else if (strcmp(argv[i], "-p") == 0)
+         ostat = 1;
+      else if (strcmp(argv[i], "-profile") == 0)
+         profgen = 1;
+      else if (strcmp(argv[i], "-stats") == 0)
+         sstat = ST_TEXT;
+      else if (strcmp(argv[i], "-stats=json") == 0)
+         sstat = ST_JSON;
+      else if (strncmp(argv[i], "-t", 2) == 0 && atoi(&argv[i][2]) > 0)
+         pthreads = atoi(&argv[i][2]);
+      else {
+         fprintf(stderr,
+                 "usage: csem [-B] [-b] [-Cdir] [-G] [-jn] [-On] [-Pfile] "
+                 "[-p] [-profile] [-stats[=json]] [-tn] [file ...]\n");
+         exit(1);
+      }
+
+   if (cfgdump)
+      pthreads = 0;
+   if (cachedir)
+      mkdir(cachedir, 0777);
+   if (proffile)
+      prload(proffile);
+   pstart();
+   initlex();
+   if (i == argc) {
+      compile(stdin, stdout);
+      if (sstat) {
+         strstats();
+         tflush();
+      }
+   }
+   else {
+      files = &argv[i];
+      nfiles = argc - i;
+      if (nthreads == 0 && (nthreads = sysconf(_SC_NPROCESSORS_ONLN)) < 1)
+         nthreads = 1;
+      if (nthreads > nfiles)
+         nthreads = nfiles;
+      tid = (pthread_t *) alloc(nthreads * sizeof(pthread_t));
+      for (i = 1; i < nthreads; i++)
+         if (pthread_create(&tid[i], NULL, worker, NULL) != 0) {
+            fprintf(stderr, "csem: cannot start a thread\n");
+            exit(1);
+         }
+      worker(NULL);
+      for (i = 1; i < nthreads; i++)
+         pthread_join(tid[i], NULL);
+      free(tid);
+   }
+   if (ostat) {
+      ostats(stderr);
+      tstats(stderr);
+      if (optlevel >= 3)
+         istats(stderr);
+      if (cachedir)
+         cstats(stderr);
+   }
+   if (sstat)
+      sstats(stderr);
+   exit(failed);
+}
+
+/*
+ * yyerror - issue error message
+ */
+yyerror(char msg[])
+{
+   if (srcname)
+      fprintf(stderr, "%s:", srcname);
+   fprintf(stderr, " %s.  Line %d\n", msg, lineno);
 }
@@ -14,8 +14,21 @@
 # include "semutil.h"
 # include "sem.h"
 # include "sym.h"
+# include "quad.h"
+# include "opt.h"
+# include "cfg.h"
+# include "cache.h"
+# include "prof.h"
+# include "inline.h"
+# include "pool.h"
+# include "stats.h"
+# include "qbin.h"
+
+/* run semantic action a, timed as such for -p */
+# define SEM(a) do { int ph = tenter(PH_SEM); a; tenter(ph); } while (0)
 %}
 
+%define api.pure full
 %union {
    int inttype;
    char *str_ptr;
@@ -39,8 +52,8 @@
 %right UNARY NOT COM
 %type <rec_ptr> lval expr exprs cexpr n
 %type <rec_ptr> cexpro prog
-%type <id_ptr> dcl dclr fname
-%type <inttype> type m
+%type <id_ptr> dclr fname
+%type <inttype> dcl type m
 %%
 prog    : externs		{}
         ;
@@ -57,13 +70,13 @@ dcls    :			{}
         | dcls dcl ';'		{}
         ;
 
-dcl     : type dclr             { $$ = dcl($2, $1, 0); }
-        | dcl ',' dclr          { $$ = dcl($3, $1->i_type&~T_ARRAY, 0); }
+dcl     : type dclr             { SEM(dcl($2, $1, 0)); $$ = $1; }
+        | dcl ',' dclr          { SEM(dcl($3, $1, 0)); $$ = $1; }
         ;
 
-dclr    : ID                    { $$ = dclr($1, 0, 1); }
-        | ID '[' ']'            { $$ = dclr($1, T_ARRAY, 1); }
-        | ID '[' CON ']'        { $$ = dclr($1, T_ARRAY, atoi($3)); }
+dclr    : ID                    { SEM($$ = dclr($1, 0, 1)); }
+        | ID '[' ']'            { SEM($$ = dclr($1, T_ARRAY, 1)); }
+        | ID '[' CON ']'        { SEM($$ = dclr($1, T_ARRAY, atoi($3))); }
         ;
 
 type    : CHAR                  { $$ = T_INT; }
@@ -72,31 +85,31 @@ type    : CHAR                  { $$ = T_INT; }
         | INT                   { $$ = T_INT; }
         ;
 
-func    : fhead stmts '}'	{ ftail(); }
+func    : fhead stmts '}'	{ SEM(ftail()); }
         ;
 
-fhead   : fname fargs '{' dcls  { fhead($1); }
+fhead   : fname fargs '{' dcls  { SEM(fhead($1)); }
         ;
 
-fname   : type ID               { $$ = fname($1, $2); }
-        | ID                    { $$ = fname(T_INT, $1); }
+fname   : type ID               { SEM($$ = fname($1, $2)); }
+        | ID                    { SEM($$ = fname(T_INT, $1)); }
         ;
 
-fargs   : '(' ')' 		{ enterblock(); }
-        | '(' args ')' 		{ enterblock(); }
+fargs   : '(' ')' 		{ SEM(enterblock()); }
+        | '(' args ')' 		{ SEM(enterblock()); }
         ;
 
-args    : type dclr		{ dcl($2, $1, PARAM); }
-        | args ',' type dclr	{ dcl($4, $3, PARAM); }
+args    : type dclr		{ SEM(dcl($2, $1, PARAM)); }
+        | args ',' type dclr	{ SEM(dcl($4, $3, PARAM)); }
         ;
 
-s	:			{ startloopscope(); }
+s	:			{ SEM(startloopscope()); }
 	;
 
-m       :                       { $$ = m(); }
+m       :                       { SEM($$ = m()); }
         ;
 
-n       :                       { $$ = n(); }
+n       :                       { SEM($$ = n()); }
         ;
 
 block   : '{' stmts '}'         { }
@@ -110,118 +123,336 @@ lblstmt	: b stmt		{ }
 	| b labels stmt		{ }
 	;
 
-labels	: ID ':'		{ labeldcl($1); }
-	| labels ID ':'		{ labeldcl($2); }
+labels	: ID ':'		{ SEM(labeldcl($1)); }
+	| labels ID ':'		{ SEM(labeldcl($2)); }
 	;
 
-b	: 			{ bgnstmt(); }
+b	: 			{ SEM(bgnstmt()); }
 	;
 
 stmt    : expr ';'
                 { }
         | IF '(' cexpr ')' m lblstmt m
-                { doif($3, $5, $7); }
+                { SEM(doif($3, $5, $7)); }
         | IF '(' cexpr ')' m lblstmt ELSE n m lblstmt m
-                { doifelse($3, $5, $8, $9, $11); }
+                { SEM(doifelse($3, $5, $8, $9, $11)); }
         | WHILE '(' m cexpr ')' m s lblstmt n m
-                { dowhile($3, $4, $6, $9, $10); }
+                { SEM(dowhile($3, $4, $6, $9, $10)); }
         | DO m s lblstmt WHILE '(' m cexpr ')' ';' m
-                { dodo($2, $7, $8, $11); }
+                { SEM(dodo($2, $7, $8, $11)); }
         | FOR '(' expro ';' m cexpro ';' m expro n ')' m s lblstmt n m
-                { dofor($5, $6, $8, $10, $12, $15, $16); }
+                { SEM(dofor($5, $6, $8, $10, $12, $15, $16)); }
 	| CONTINUE ';'
-		{ docontinue(); }
+		{ SEM(docontinue()); }
 	| BREAK ';'
-		{ dobreak(); }
+		{ SEM(dobreak()); }
 	| GOTO ID ';'
-		{ dogoto($2); }
+		{ SEM(dogoto($2)); }
         | RETURN ';'
-                { doret((struct sem_rec *) NULL); }
+                { SEM(doret((struct sem_rec *) NULL)); }
         | RETURN expr ';'
-                { doret($2); }
+                { SEM(doret($2)); }
 	| block
 		{ }
         | ';'
                 { }
         ;
 
-cexpro  :			{ $$ = node(0, 0, n(), 0); }
+cexpro  :			{ SEM($$ = node(0, 0, n(), 0)); }
         | cexpr			{}
         ;
 
-cexpr   : expr EQ expr          { $$ = rel("==", $1, $3); }
-        | expr NE expr          { $$ = rel("!=", $1, $3); }
-        | expr LE expr          { $$ = rel("<=", $1, $3); }
-        | expr GE expr          { $$ = rel(">=", $1, $3); }
-        | expr LT expr          { $$ = rel("<",  $1, $3); }
-        | expr GT expr          { $$ = rel(">",  $1, $3); }
-        | cexpr AND m cexpr     { $$ = ccand($1, $3, $4); }
-        | cexpr OR m cexpr      { $$ = ccor($1, $3, $4); }
-        | NOT cexpr             { $$ = ccnot($2); }
-        | expr                  { $$ = ccexpr($1); }
+cexpr   : expr EQ expr          { SEM($$ = rel(Q_EQ,     $1, $3)); }
+        | expr NE expr          { SEM($$ = rel(Q_NE,     $1, $3)); }
+        | expr LE expr          { SEM($$ = rel(Q_LE,     $1, $3)); }
+        | expr GE expr          { SEM($$ = rel(Q_GE,     $1, $3)); }
+        | expr LT expr          { SEM($$ = rel(Q_LT,     $1, $3)); }
+        | expr GT expr          { SEM($$ = rel(Q_GT,     $1, $3)); }
+        | cexpr AND m cexpr     { SEM($$ = ccand($1, $3, $4)); }
+        | cexpr OR m cexpr      { SEM($$ = ccor($1, $3, $4)); }
+        | NOT cexpr             { SEM($$ = ccnot($2)); }
+        | expr                  { SEM($$ = ccexpr($1)); }
         ;
 
 exprs   : expr                  { $$ = $1; }
-        | exprs ',' expr        { $$ = exprs($1, $3); }
+        | exprs ',' expr        { SEM($$ = exprs($1, $3)); }
         ;
 
 expro   :			{}
         | expr			{}
         ;
 
-expr    : lval SET expr		{ $$ = set("",   $1, $3); }
-        | lval SETOR expr	{ $$ = set("|",  $1, $3); }
-        | lval SETXOR expr	{ $$ = set("^",  $1, $3); }
-        | lval SETAND expr	{ $$ = set("&",  $1, $3); }
-        | lval SETLSH expr	{ $$ = set("<<", $1, $3); }
-        | lval SETRSH expr	{ $$ = set(">>", $1, $3); }
-        | lval SETADD expr	{ $$ = set("+",  $1, $3); }
-        | lval SETSUB expr	{ $$ = set("-",  $1, $3); }
-        | lval SETMUL expr	{ $$ = set("*",  $1, $3); }
-        | lval SETDIV expr	{ $$ = set("/",  $1, $3); }
-        | lval SETMOD expr	{ $$ = set("%",  $1, $3); }
-        | expr BITOR expr	{ $$ = opb("|",  $1, $3); }
-        | expr BITXOR expr	{ $$ = opb("^",  $1, $3); }
-        | expr BITAND expr	{ $$ = opb("&",  $1, $3); }
-        | expr LSH expr		{ $$ = opb("<<", $1, $3); }
-        | expr RSH expr		{ $$ = opb(">>", $1, $3); }
-        | expr ADD expr		{ $$ = op2("+",  $1, $3); }
-        | expr SUB expr		{ $$ = op2("-",  $1, $3); }
-        | expr MUL expr		{ $$ = op2("*",  $1, $3); }
-        | expr DIV expr		{ $$ = op2("/",  $1, $3); }
-        | expr MOD expr		{ $$ = op2("%",  $1, $3); }
+expr    : lval SET expr		{ SEM($$ = set(Q_ASSIGN, $1, $3)); }
+        | lval SETOR expr	{ SEM($$ = set(Q_OR,     $1, $3)); }
+        | lval SETXOR expr	{ SEM($$ = set(Q_XOR,    $1, $3)); }
+        | lval SETAND expr	{ SEM($$ = set(Q_AND,    $1, $3)); }
+        | lval SETLSH expr	{ SEM($$ = set(Q_LSH,    $1, $3)); }
+        | lval SETRSH expr	{ SEM($$ = set(Q_RSH,    $1, $3)); }
+        | lval SETADD expr	{ SEM($$ = set(Q_ADD,    $1, $3)); }
+        | lval SETSUB expr	{ SEM($$ = set(Q_SUB,    $1, $3)); }
+        | lval SETMUL expr	{ SEM($$ = set(Q_MUL,    $1, $3)); }
+        | lval SETDIV expr	{ SEM($$ = set(Q_DIV,    $1, $3)); }
+        | lval SETMOD expr	{ SEM($$ = set(Q_MOD,    $1, $3)); }
+        | expr BITOR expr	{ SEM($$ = opb(Q_OR,     $1, $3)); }
+        | expr BITXOR expr	{ SEM($$ = opb(Q_XOR,    $1, $3)); }
+        | expr BITAND expr	{ SEM($$ = opb(Q_AND,    $1, $3)); }
+        | expr LSH expr		{ SEM($$ = opb(Q_LSH,    $1, $3)); }
+        | expr RSH expr		{ SEM($$ = opb(Q_RSH,    $1, $3)); }
+        | expr ADD expr		{ SEM($$ = op2(Q_ADD,    $1, $3)); }
+        | expr SUB expr		{ SEM($$ = op2(Q_SUB,    $1, $3)); }
+        | expr MUL expr		{ SEM($$ = op2(Q_MUL,    $1, $3)); }
+        | expr DIV expr		{ SEM($$ = op2(Q_DIV,    $1, $3)); }
+        | expr MOD expr		{ SEM($$ = op2(Q_MOD,    $1, $3)); }
         | BITAND lval %prec UNARY
 				{ $$ = $2; }
-        | SUB expr %prec UNARY	{ $$ = op1("-",      $2); }
-        | COM expr		{ $$ = op1("~",      $2); }
-        | lval %prec LVAL	{ $$ = op1("@",      $1); }
-        | ID '(' ')'		{ $$ = call($1, (struct sem_rec *) NULL); }
-        | ID '(' exprs ')'	{ $$ = call($1, $3); }
+        | SUB expr %prec UNARY	{ SEM($$ = op1(Q_NEG,    $2)); }
+        | COM expr		{ SEM($$ = op1(Q_COM,    $2)); }
+        | lval %prec LVAL	{ SEM($$ = op1(Q_DEREF,  $1)); }
+        | ID '(' ')'		{ SEM($$ = call($1, (struct sem_rec *) NULL)); }
+        | ID '(' exprs ')'	{ SEM($$ = call($1, $3)); }
         | '(' expr ')'		{ $$ = $2; }
-        | CON			{ $$ = con($1); }
-        | STR			{ $$ = string($1); }
+        | CON			{ SEM($$ = con($1)); }
+        | STR			{ SEM($$ = string($1)); }
 	;
 
-lval	: ID			{ $$ = id($1); }
-	| ID '[' expr ']'	{ $$ = tom_index(id($1), $3); }
+lval	: ID			{ SEM($$ = id($1)); }
+	| ID '[' expr ']'	{ SEM($$ = tom_index(id($1), $3)); }
         ;
 %%
 # include <stdio.h>
+# include <string.h>
+# include <unistd.h>
+# include <pthread.h>
+# include <sys/stat.h>
 
-extern int lineno;
+extern UNIT int lineno;
 
-/* 
- * main - read a program, and parse it
+static UNIT char *srcname;	/* file being compiled, NULL for stdin */
+
+static char **files;		/* files named on the command line */
+static int nfiles;		/* files in files */
+static int nextfile;		/* next of them to compile */
+static int failed;		/* nonzero if any of them failed */
+static pthread_mutex_t flock = PTHREAD_MUTEX_INITIALIZER; /* guards the above */
+
+/*
+ * compile - translate the program on fp, write the quads on out, return
+ *           nonzero if it had a syntax error
+ *
+ * Everything but the interned strings is started over, so a thread may
+ * compile one file after another.
  */
-main(int argc, char *argv)
+int compile(FILE *fp, FILE *out)
 {
+   int err, ph;
 
+   qout = out;
+   tsource(srcname);
+   ph = tenter(PH_READ);
+   readin(fp);
+   tenter(PH_PARSE);
    enterblock();
-   initlex();
    enterblock();
-   if (yyparse())
+   if ((err = yyparse()) != 0)
       yyerror("syntax error");
-   exit(0);
+   tenter(PH_WRITE);
+   pwait();
+   tenter(ph);
+   if (sstat)
+      symstats();
+   tflush();
+   symreset();
+   semreset();
+   return (err);
+}
+
+/*
+ * outname - name of the file the quads of file name go to: name with its
+ *           suffix, if any, replaced by .q, or .qb with -b
+ */
+char *outname(char *name)
+{
+   char *o, *dot, *slash;
+
+   o = alloc(strlen(name) + 4);
+   strcpy(o, name);
+   dot = strrchr(o, '.');
+   slash = strrchr(o, '/');
+   if (dot && (slash == NULL || dot > slash))
+      *dot = '\0';
+   strcat(o, qbinary ? ".qb" : ".q");
+   return (o);
+}
+
+/*
+ * worker - compile files until none are left
+ */
+void *worker(void *arg)
+{
+   FILE *fp, *out;
+   char *o;
+   int i, err;
+
+   for (;;) {
+      pthread_mutex_lock(&flock);
+      i = nextfile++;
+      pthread_mutex_unlock(&flock);
+      if (i >= nfiles)
+         break;
+      srcname = files[i];
+      o = outname(files[i]);
+      err = 1;
+      if ((fp = fopen(files[i], "r")) == NULL)
+         fprintf(stderr, "csem: cannot open %s\n", files[i]);
+      else if ((out = fopen(o, "w")) == NULL) {
+         fprintf(stderr, "csem: cannot create %s\n", o);
+         fclose(fp);
+      }
+      else {
+         err = compile(fp, out);
+         fclose(fp);
+         if (fclose(out) != 0) {
+            fprintf(stderr, "csem: cannot write %s\n", o);
+            err = 1;
+         }
+      }
+      free(o);
+      if (err) {
+         pthread_mutex_lock(&flock);
+         failed = 1;
+         pthread_mutex_unlock(&flock);
+      }
+   }
+   if (sstat) {
+      strstats();
+      tflush();
+   }
+   return (NULL);
+}
+
+/* 
+ * main - read a program, and parse it
+ *
+ *    -B   leave branches on backpatch labels and emit the Bn=Lm lines
+ *    -b   write the quads in the binary form of qbin.h, for a back end
+ *         to read with qbread.c
+ *    -Cdir  keep the optimized quads of each function in directory dir,
+ *         and take a function unchanged since from there; the output is
+ *         the same
+ *    -G   print the basic blocks and control-flow graph of each function
+ *         on stderr
+ *    -jn  compile the files named on n threads (default one per processor)
+ *    -On  optimize at level n (-O alone is -O1)
+ *           1  local value numbering, constant folding and pooling,
+ *              copy propagation, dead temporary elimination, jump
+ *              threading and deletion of unreachable code
+ *           2  and loop-invariant code motion, strength reduction of
+ *              array subscripts by induction variables
+ *           3  and scalar variables kept in temporaries in static single
+ *              assignment form, sparse conditional constant propagation
+ *              and global value numbering over it, and calls to small
+ *              functions defined before them that call none expanded
+ *              in place
+ *    -Pfile  lay out the blocks of each function by the profile in file,
+ *         those that never ran after the rest
+ *    -p   print statistics of the optimization passes, and the time
+ *         spent reading, scanning, parsing, in the semantic actions,
+ *         optimizing and writing, on stderr
+ *    -profile  count the runs of each basic block, printing the counts
+ *         as a profile when the program exits
+ *    -stats  print the lengths of the chains of the identifier and
+ *         string tables, the most semantic records held at once, the
+ *         bytes allocated, the time spent in each phase as with -p, and
+ *         the temporaries and labels of each function, on stderr;
+ *         -stats=json prints them as JSON
+ *    -tn  optimize the functions of a file on n threads while it is
+ *         parsed; the output is the same.  Not with -G, which keeps the
+ *         graphs in order.
+ *
+ * With no files the program is read from stdin and its quads written on
+ * stdout; otherwise the quads of each file x.c go to x.q, or x.qb.
+ */
+main(int argc, char *argv[])
+{
+   pthread_t *tid;
+   int i, nthreads = 0;
+
+   for (i = 1; i < argc && argv[i][0] == '-'; i++)
+      if (strcmp(argv[i], "-B") == 0)
+         qbpatch = 1;
+      else if (strcmp(argv[i], "-b") == 0)
+         qbinary = 1;
+      else if (strncmp(argv[i], "-C", 2) == 0 && argv[i][2])
+         cachedir = &argv[i][2];
+      else if (strcmp(argv[i], "-G") == 0)
+         cfgdump = 1;
+      else if (strncmp(argv[i], "-j", 2) == 0 && atoi(&argv[i][2]) > 0)
+         nthreads = atoi(&argv[i][2]);
+      else if (strncmp(argv[i], "-O", 2) == 0)
+         optlevel = argv[i][2] ? atoi(&argv[i][2]) : 1;
+      else if (strncmp(argv[i], "-P", 2) == 0 && argv[i][2])
+         proffile = &argv[i][2];
+      else if (strcmp(argv[i], "-p") == 0)
+         ostat = 1;
+      else if (strcmp(argv[i], "-profile") == 0)
+         profgen = 1;
+      else if (strcmp(argv[i], "-stats") == 0)
+         sstat = ST_TEXT;
+      else if (strcmp(argv[i], "-stats=json") == 0)
+         sstat = ST_JSON;
+      else if (strncmp(argv[i], "-t", 2) == 0 && atoi(&argv[i][2]) > 0)
+         pthreads = atoi(&argv[i][2]);
+      else {
+         fprintf(stderr,
+                 "usage: csem [-B] [-b] [-Cdir] [-G] [-jn] [-On] [-Pfile] "
+                 "[-p] [-profile] [-stats[=json]] [-tn] [file ...]\n");
+         exit(1);
+      }
+
+   if (cfgdump)
+      pthreads = 0;
+   if (cachedir)
+      mkdir(cachedir, 0777);
+   if (proffile)
+      prload(proffile);
+   pstart();
+   initlex();
+   if (i == argc) {
+      compile(stdin, stdout);
+      if (sstat) {
+         strstats();
+         tflush();
+      }
+   }
+   else {
+      files = &argv[i];
+      nfiles = argc - i;
+      if (nthreads == 0 && (nthreads = sysconf(_SC_NPROCESSORS_ONLN)) < 1)
+         nthreads = 1;
+      if (nthreads > nfiles)
+         nthreads = nfiles;
+      tid = (pthread_t *) alloc(nthreads * sizeof(pthread_t));
+      for (i = 1; i < nthreads; i++)
+         if (pthread_create(&tid[i], NULL, worker, NULL) != 0) {
+            fprintf(stderr, "csem: cannot start a thread\n");
+            exit(1);
+         }
+      worker(NULL);
+      for (i = 1; i < nthreads; i++)
+         pthread_join(tid[i], NULL);
+      free(tid);
+   }
+   if (ostat) {
+      ostats(stderr);
+      tstats(stderr);
+      if (optlevel >= 3)
+         istats(stderr);
+      if (cachedir)
+         cstats(stderr);
+   }
+   if (sstat)
+      sstats(stderr);
+   exit(failed);
 }
 
 /*
@@ -229,5 +460,7 @@ main(int argc, char *argv)
  */
 yyerror(char msg[])
 {
+   if (srcname)
+      fprintf(stderr, "%s:", srcname);
    fprintf(stderr, " %s.  Line %d\n", msg, lineno);
 }
@@ -0,0 +1,211 @@
+"""
+Writes a large random program in the C subset cgram.y accepts, for timing
+csem: thousands of functions, statements nested deeply, long expressions
+and many loops.  The same seed gives the same program.
+"""
+import argparse
+import random
+import sys
+
+NGLOBALS = 8
+NARRAY = 64
+
+
+class Gen:
+    def __init__(self, seed, depth, terms):
+        self.r = random.Random(seed)
+        self.depth = depth
+        self.terms = terms
+        self.out = []
+        self.funcs = []
+
+    def emit(self, ind, s):
+        self.out.append('  ' * ind + s)
+
+    def ivar(self, f):
+        return self.r.choice(f['ints'])
+
+    def dvar(self, f):
+        return self.r.choice(f['dbls'])
+
+    def call(self, f):
+        name, params, ret = self.r.choice(self.funcs)
+        args = [self.ivar(f) if t == 'int' else self.dvar(f) for t in params]
+        return '%s(%s)' % (name, ', '.join(args))
+
+    def term(self, f, d):
+        c = self.r.random()
+        if c < 0.3:
+            return str(self.r.randint(0, 99))
+        if c < 0.6:
+            return self.ivar(f)
+        if c < 0.75:
+            a = self.r.choice(['t', 'ga'])
+            return '%s[%s & %d]' % (a, self.ivar(f),
+                                    15 if a == 't' else NARRAY - 1)
+        if c < 0.85 and d < 2:
+            return '(%s)' % self.iexpr(f, d + 1, self.r.randint(2, 6))
+        if c < 0.9 and self.funcs and d < 2:
+            return self.call(f)
+        if c < 0.95:
+            return '-%s' % self.ivar(f)
+        return '~%s' % self.ivar(f)
+
+    def iexpr(self, f, d=0, n=None):
+        if n is None:
+            n = self.r.randint(1, self.terms)
+        s = self.term(f, d)
+        for _ in range(n - 1):
+            op = self.r.choice(['+', '-', '*', '+', '-', '|', '&', '^',
+                                '<<', '>>', '/', '%'])
+            t = self.term(f, d)
+            if op in ('/', '%'):
+                t = str(self.r.randint(1, 9))
+            elif op in ('<<', '>>'):
+                t = str(self.r.randint(0, 7))
+            s = '%s %s %s' % (s, op, t)
+        return s
+
+    def dexpr(self, f):
+        s = self.dvar(f)
+        for _ in range(self.r.randint(0, self.terms // 2)):
+            s = '%s %s %s' % (s, self.r.choice(['+', '-', '*', '/']),
+                              self.r.choice([self.dvar(f), self.ivar(f),
+                                             'da[%s & %d]' % (self.ivar(f),
+                                                              NARRAY - 1)]))
+        return s
+
+    def cond(self, f):
+        rel = lambda: '%s %s %s' % (self.iexpr(f, 1, self.r.randint(1, 3)),
+                                    self.r.choice(['<', '<=', '>', '>=',
+                                                   '==', '!=']),
+                                    self.iexpr(f, 1, self.r.randint(1, 3)))
+        s = rel()
+        for _ in range(self.r.randint(0, 2)):
+            s = '%s %s %s' % (s, self.r.choice(['&&', '||']), rel())
+        return s
+
+    def stmt(self, f, ind, depth, loop):
+        c = self.r.random()
+        nest = depth < self.depth
+        if c < 0.3 or not nest and c < 0.6:
+            self.emit(ind, '%s %s %s;' % (
+                self.ivar(f), self.r.choice(['=', '=', '+=', '-=', '^=', '|=']),
+                self.iexpr(f)))
+        elif c < 0.4 or not nest and c < 0.75:
+            self.emit(ind, '%s = %s;' % (self.dvar(f), self.dexpr(f)))
+        elif c < 0.45 or not nest:
+            self.emit(ind, 't[%s & 15] = %s;' % (self.ivar(f), self.iexpr(f)))
+        elif c < 0.55:
+            self.emit(ind, 'if (%s) {' % self.cond(f))
+            self.block(f, ind + 1, depth + 1, loop)
+            if self.r.random() < 0.5:
+                self.emit(ind, '} else {')
+                self.block(f, ind + 1, depth + 1, loop)
+            self.emit(ind, '}')
+        elif c < 0.65:
+            i = 'i%d' % depth
+            self.emit(ind, 'for (%s = 0; %s < %d; %s += 1) {' % (
+                i, i, self.r.randint(2, 100), i))
+            self.block(f, ind + 1, depth + 1, True)
+            self.emit(ind, '}')
+        elif c < 0.72:
+            i = 'i%d' % depth
+            self.emit(ind, '%s = 0;' % i)
+            self.emit(ind, 'while (%s < %d && %s) {' % (
+                i, self.r.randint(2, 100), self.cond(f)))
+            self.emit(ind + 1, '%s += 1;' % i)
+            self.block(f, ind + 1, depth + 1, True)
+            self.emit(ind, '}')
+        elif c < 0.77:
+            i = 'i%d' % depth
+            self.emit(ind, '%s = 0;' % i)
+            self.emit(ind, 'do {')
+            self.emit(ind + 1, '%s += 1;' % i)
+            self.block(f, ind + 1, depth + 1, True)
+            self.emit(ind, '} while (%s < %d);' % (i, self.r.randint(2, 100)))
+        elif c < 0.82 and loop:
+            self.emit(ind, 'if (%s) %s;' % (self.cond(f),
+                                           self.r.choice(['break',
+                                                          'continue'])))
+        elif c < 0.87:
+            self.emit(ind, '{')
+            self.block(f, ind + 1, depth + 1, loop)
+            self.emit(ind, '}')
+        elif c < 0.92 and self.funcs:
+            self.emit(ind, '%s = %s;' % (self.ivar(f), self.call(f)))
+        else:
+            self.emit(ind, 'printf("%%d %%f\\n", %s, %s);' % (self.iexpr(f),
+                                                            self.dvar(f)))
+
+    def block(self, f, ind, depth, loop):
+        for _ in range(self.r.randint(1, 4)):
+            self.stmt(f, ind, depth, loop)
+
+    def func(self, k):
+        ret = self.r.choice(['int', 'int', 'double'])
+        params = [self.r.choice(['int', 'int', 'double'])
+                  for _ in range(self.r.randint(0, 4))]
+        f = {'ints': ['a', 'b', 'c'] +
+                     ['g%d' % i for i in range(NGLOBALS)] +
+                     ['p%d' % i for i, t in enumerate(params) if t == 'int'],
+             'dbls': ['x', 'y', 'd0', 'd1'] +
+                     ['p%d' % i for i, t in enumerate(params) if t == 'double']}
+        self.emit(0, '%s f%d(%s) {' % (ret, k, ', '.join(
+            '%s p%d' % (t, i) for i, t in enumerate(params))))
+        self.emit(1, 'int a, b, c, t[16], %s;' % ', '.join(
+            'i%d' % i for i in range(self.depth + 1)))
+        self.emit(1, 'double x, y;')
+        self.emit(1, 'a = 1; b = 2; c = 3; x = 4; y = 5;')
+        for _ in range(self.r.randint(3, 8)):
+            self.stmt(f, 1, 0, False)
+        self.emit(1, 'return %s;' % (self.iexpr(f) if ret == 'int'
+                                     else self.dexpr(f)))
+        self.emit(0, '}')
+        if ret == 'int':
+            self.funcs.append(('f%d' % k, params, ret))
+
+    def program(self, nfuncs):
+        self.emit(0, 'int %s;' % ', '.join('g%d' % i for i in range(NGLOBALS)))
+        self.emit(0, 'double d0, d1;')
+        self.emit(0, 'int ga[%d];' % NARRAY)
+        self.emit(0, 'double da[%d];' % NARRAY)
+        for k in range(nfuncs):
+            self.func(k)
+        self.emit(0, 'int main() {')
+        self.emit(1, 'int a, b, c;')
+        self.emit(1, 'double x, y;')
+        self.emit(1, 'a = 1; b = 2; c = 3; x = 4; y = 5;')
+        f = {'ints': ['a', 'b', 'c'], 'dbls': ['x', 'y']}
+        for _ in range(min(nfuncs, 20)):
+            if self.funcs:
+                self.emit(1, 'a = a + %s;' % self.call(f))
+        self.emit(1, 'printf("%d\\n", a);')
+        self.emit(1, 'return 0;')
+        self.emit(0, '}')
+        return '\n'.join(self.out) + '\n'
+
+
+def generate(nfuncs, seed=1, depth=6, terms=16):
+    """The text of a program of nfuncs functions."""
+    return Gen(seed, depth, terms).program(nfuncs)
+
+
+if __name__ == '__main__':
+    parser = argparse.ArgumentParser()
+    parser.add_argument('--functions', '-n', type=int, default=2000,
+                        help="functions in the program")
+    parser.add_argument('--depth', '-d', type=int, default=6,
+                        help="deepest nesting of statements")
+    parser.add_argument('--terms', '-t', type=int, default=16,
+                        help="most terms in an expression")
+    parser.add_argument('--seed', '-s', type=int, default=1)
+    parser.add_argument('--output', '-o', type=str, default=None,
+                        help="file to write, stdout if none")
+    args = parser.parse_args()
+    text = generate(args.functions, args.seed, args.depth, args.terms)
+    if args.output:
+        with open(args.output, 'w') as fp:
+            fp.write(text)
+    else:
+        sys.stdout.write(text)
@@ -0,0 +1,415 @@
+/* inlining of small leaf functions at their calls */
+
+# include <stdio.h>
+# include <stdlib.h>
+# include <string.h>
+# include <pthread.h>
+# include "cc.h"
+# include "quad.h"
+# include "opt.h"
+# include "sym.h"
+# include "inline.h"
+# include "prof.h"
+
+extern UNIT int ntmp, numlabels, numblabels;
+
+/*
+ * At -O3 each function is taken as it is finished, before it is resolved
+ * or optimized: calls in it to functions of the file seen before are
+ * expanded, and then, if it calls nothing left and is small, it is kept
+ * to be expanded in turn.  So the call graph is worked up from its leaves,
+ * and a function calling itself, which never gets to be a leaf, is never
+ * kept.  A call to a kept function is
+ *
+ *    argT ty ... ; tg := global f ; tz := fT tg n
+ *
+ * with an argument of the type of each formal.  It becomes a store of each
+ * argument to a new local standing for the formal, the body with its
+ * params and locals moved to new locals of the caller, its temporaries and
+ * labels renumbered after those of the file, and each return a store of
+ * its value to one more local and a branch to the end, where tz is loaded.
+ * The -O3 passes then keep those locals in temporaries.
+ *
+ * The calls are taken in order until the growth they add would pass
+ * IMAXGROW.  With -P and counts for the lines of the function, a call on
+ * a line that never ran is left, and the rest are taken the most run
+ * first, so the budget goes where the time goes.
+ *
+ * As it is done as the functions are parsed and in their order, the output
+ * does not depend on threads, and the cache keys a function by its quads
+ * with the bodies in them.
+ */
+
+# define IMAXQUADS 40		/* most quads in a body kept */
+# define IMAXGROW 400		/* most quads expansion adds to a function */
+# define IHASH 256		/* buckets of the table of kept functions */
+
+/* a function kept to be expanded at its calls */
+struct icallee {
+   char *c_name;		/* its name */
+   struct quad *c_body;		/* its quads between heading and fend */
+   int c_nbody;			/* quads in c_body */
+   char *c_formals;		/* type of each formal, 'i' or 'f' */
+   int c_nformals;		/* formals */
+   int *c_locals;		/* size of each local */
+   int c_nlocals;		/* locals */
+   int c_ret;			/* type it returns, 0 if it has no return */
+   int c_tlo, c_thi;		/* its temporaries */
+   int c_llo, c_lhi;		/* its labels Ln */
+   int c_blo, c_bhi;		/* its backpatch labels Bn */
+   struct icallee *c_next;	/* next in its bucket */
+};
+
+/* a call iexpand may expand */
+struct isite {
+   int s_at;			/* index of its call quad */
+   long s_count;		/* runs of its line in the profile, or -1 */
+};
+
+/* kept functions of the file this thread is compiling */
+static UNIT struct icallee *itab[IHASH];
+
+/* calls expanded, for -p, shared by all threads */
+static pthread_mutex_t ilock = PTHREAD_MUTEX_INITIALIZER;
+static long icalls = 0;
+
+/*
+ * ilookup - the kept function named s, or NULL
+ */
+static struct icallee *ilookup(char *s)
+{
+   struct icallee *c;
+
+   for (c = itab[(unsigned long) s / 8 % IHASH]; c; c = c->c_next)
+      if (c->c_name == s)
+         return (c);
+   return (NULL);
+}
+
+/*
+ * ilearn - keep function f to be expanded at its calls, if it calls
+ *          nothing and is small enough
+ */
+void ilearn(struct qfunc *f)
+{
+   struct icallee *c;
+   struct quad *q, *end;
+   int n, h;
+
+   if (f->f_nquads < 2 || f->f_quads[0].q_op != Q_FUNC ||
+       f->f_quads[f->f_nquads - 1].q_op != Q_FEND ||
+       ilookup(f->f_quads[0].q_s))
+      return;
+   end = &f->f_quads[f->f_nquads - 1];
+   for (q = &f->f_quads[1]; q < end && (q->q_op == Q_FORMAL ||
+                                        q->q_op == Q_LOCALLOC); q++)
+      ;
+   for (n = 0; q + n < end; n++)
+      switch (q[n].q_op) {
+         case Q_CALL: case Q_GOTO: case Q_ALLOC: case Q_FUNC:
+         case Q_FORMAL: case Q_LOCALLOC:
+            return;
+         case Q_LABEL:
+            if (q[n].q_s)
+               return;
+      }
+   if (n > IMAXQUADS)
+      return;
+
+   c = (struct icallee *) alloc(sizeof(struct icallee));
+   c->c_name = f->f_quads[0].q_s;
+   c->c_formals = alloc(f->f_nquads);
+   c->c_locals = (int *) alloc(f->f_nquads * sizeof(int));
+   for (q = &f->f_quads[1]; q < end; q++)
+      if (q->q_op == Q_FORMAL)
+         c->c_formals[c->c_nformals++] = q->q_n == 8 ? 'f' : 'i';
+      else if (q->q_op == Q_LOCALLOC)
+         c->c_locals[c->c_nlocals++] = q->q_n;
+      else
+         break;
+   c->c_body = (struct quad *) alloc((n ? n : 1) * sizeof(struct quad));
+   memcpy(c->c_body, q, n * sizeof(struct quad));
+   c->c_nbody = n;
+   c->c_tlo = c->c_llo = c->c_blo = 0x7fffffff;
+   for (q = c->c_body; q < &c->c_body[n]; q++) {
+      if (q->q_z) {
+         c->c_tlo = q->q_z < c->c_tlo ? q->q_z : c->c_tlo;
+         c->c_thi = q->q_z > c->c_thi ? q->q_z : c->c_thi;
+      }
+      if (q->q_op == Q_RET) {
+         if (q->q_y == 0 || (c->c_ret && c->c_ret != q->q_t)) {
+            free(c->c_formals);
+            free(c->c_locals);
+            free(c->c_body);
+            free(c);
+            return;
+         }
+         c->c_ret = q->q_t;
+      }
+      if (q->q_op == Q_LABEL || q->q_op == Q_BPATCH) {
+         h = q->q_op == Q_LABEL ? q->q_n : q->q_m;
+         c->c_llo = h < c->c_llo ? h : c->c_llo;
+         c->c_lhi = h > c->c_lhi ? h : c->c_lhi;
+      }
+      if (q->q_op == Q_BT || q->q_op == Q_BR || q->q_op == Q_BPATCH) {
+         c->c_blo = q->q_n < c->c_blo ? q->q_n : c->c_blo;
+         c->c_bhi = q->q_n > c->c_bhi ? q->q_n : c->c_bhi;
+      }
+   }
+   h = (unsigned long) c->c_name / 8 % IHASH;
+   c->c_next = itab[h];
+   itab[h] = c;
+}
+
+/*
+ * icallat - the kept function called by the call ending at quad i of f,
+ *           if its arguments fit its formals, or NULL
+ */
+static struct icallee *icallat(struct qfunc *f, int i)
+{
+   struct quad *q = &f->f_quads[i], *g;
+   struct icallee *c;
+   int k;
+
+   if (q->q_op != Q_CALL || i < 1 + q->q_n)
+      return (NULL);
+   g = q - 1;
+   if (g->q_op != Q_GLOBAL || g->q_z != q->q_x ||
+       (c = ilookup(g->q_s)) == NULL || c->c_nformals != q->q_n ||
+       (c->c_ret && c->c_ret != q->q_t))
+      return (NULL);
+   for (k = 0; k < q->q_n; k++)
+      if (g[k - q->q_n].q_op != Q_ARG || g[k - q->q_n].q_t != c->c_formals[k])
+         return (NULL);
+   return (c);
+}
+
+/*
+ * iemit - append a quad to g
+ */
+static struct quad *iemit(struct qfunc *g, int op)
+{
+   struct quad *q = qinsert(g, g->f_nquads, 1);
+
+   q->q_op = op;
+   return (q);
+}
+
+/*
+ * islot - append to g a quad taking the address of local n, return its
+ *         temporary
+ */
+static int islot(struct qfunc *g, int n)
+{
+   struct quad *q = iemit(g, Q_LOCAL);
+
+   q->q_z = ++ntmp;
+   q->q_n = n;
+   return (q->q_z);
+}
+
+/*
+ * iexpand1 - append to g callee c expanded at call q, its formals in the
+ *            locals from nloc on
+ */
+static void iexpand1(struct qfunc *g, struct icallee *c, struct quad *q,
+                     int nloc)
+{
+   struct quad *p, *r;
+   int k, t, tbase, lbase, bbase, lend, bend, ret;
+
+   for (k = 0; k < c->c_nformals; k++) {
+      t = islot(g, nloc + k);
+      p = iemit(g, Q_ASSIGN);
+      p->q_x = t;
+      p->q_y = q[k - 1 - q->q_n].q_y;
+      p->q_t = c->c_formals[k];
+   }
+   ret = nloc + c->c_nformals + c->c_nlocals;
+
+   tbase = ntmp + 1 - c->c_tlo;
+   if (c->c_thi >= c->c_tlo)
+      ntmp += c->c_thi - c->c_tlo + 1;
+   lbase = numlabels + 1 - c->c_llo;
+   if (c->c_lhi >= c->c_llo)
+      numlabels += c->c_lhi - c->c_llo + 1;
+   bbase = numblabels + 1 - c->c_blo;
+   if (c->c_bhi >= c->c_blo)
+      numblabels += c->c_bhi - c->c_blo + 1;
+   lend = ++numlabels;
+   bend = ++numblabels;
+
+   for (p = c->c_body; p < &c->c_body[c->c_nbody]; p++) {
+      if (p->q_op == Q_BGNSTMT)
+         continue;
+      if (p->q_op == Q_RET) {
+         t = islot(g, ret);
+         r = iemit(g, Q_ASSIGN);
+         r->q_x = t;
+         r->q_y = p->q_y + tbase;
+         r->q_t = p->q_t;
+         if (p + 1 < &c->c_body[c->c_nbody])
+            iemit(g, Q_BR)->q_n = bend;
+         continue;
+      }
+      r = iemit(g, p->q_op);
+      *r = *p;
+      if (r->q_z)
+         r->q_z += tbase;
+      if (qusesx(r->q_op))
+         r->q_x += tbase;
+      if (qusesy(r->q_op) && r->q_y)
+         r->q_y += tbase;
+      switch (r->q_op) {
+         case Q_PARAM:
+            r->q_op = Q_LOCAL;
+            r->q_n += nloc;
+            break;
+         case Q_LOCAL:
+            r->q_n += nloc + c->c_nformals;
+            break;
+         case Q_LABEL:
+            r->q_n += lbase;
+            break;
+         case Q_BPATCH:
+            r->q_m += lbase;
+            /* fall through */
+         case Q_BT: case Q_BR:
+            r->q_n += bbase;
+            break;
+      }
+   }
+   r = iemit(g, Q_BPATCH);
+   r->q_n = bend;
+   r->q_m = lend;
+   iemit(g, Q_LABEL)->q_n = lend;
+   t = islot(g, ret);
+   r = iemit(g, Q_DEREF);
+   r->q_y = t;
+   r->q_z = q->q_z;
+   r->q_t = q->q_t;
+}
+
+/*
+ * isitecmp - order calls the most run first, then as they come
+ */
+static int isitecmp(const void *a, const void *b)
+{
+   const struct isite *x = a, *y = b;
+
+   if (x->s_count != y->s_count)
+      return (x->s_count > y->s_count ? -1 : 1);
+   return (x->s_at - y->s_at);
+}
+
+/*
+ * iexpand - expand in f the calls to kept functions, as many as fit
+ *           the budget, those run most in the profile first
+ */
+void iexpand(struct qfunc *f)
+{
+   struct qfunc g, b;
+   struct icallee **at, *c;
+   struct isite *site;
+   struct quad *q;
+   char *skip, *name = NULL;
+   int i, j, k, n, ns, line, head, nloc, cost, grow;
+
+   at = (struct icallee **) alloc(f->f_nquads * sizeof(struct icallee *));
+   skip = alloc(f->f_nquads);
+   site = (struct isite *) alloc(f->f_nquads * sizeof(struct isite));
+   if (proffile && f->f_nquads && f->f_quads[0].q_op == Q_FUNC)
+      name = f->f_quads[0].q_s;
+   for (ns = line = 0, i = 0; i < f->f_nquads; i++)
+      if (f->f_quads[i].q_op == Q_BGNSTMT)
+         line = f->f_quads[i].q_n;
+      else if (icallat(f, i) != NULL) {
+         site[ns].s_at = i;
+         site[ns].s_count = name ? prline(name, line) : -1;
+         if (site[ns].s_count != 0)
+            ns++;
+      }
+   if (name)
+      qsort(site, ns, sizeof(struct isite), isitecmp);
+   for (n = grow = 0, k = 0; k < ns; k++) {
+      c = icallat(f, i = site[k].s_at);
+      if (grow + (cost = c->c_nbody + 3 * c->c_nformals + 8) > IMAXGROW)
+         continue;
+      at[i] = c;
+      for (j = 0; j <= c->c_nformals; j++)
+         skip[i - 1 - j] = 1;
+      grow += cost;
+      n++;
+   }
+   free(site);
+   if (n == 0) {
+      free(at);
+      free(skip);
+      return;
+   }
+
+   for (head = 1; head < f->f_nquads && (f->f_quads[head].q_op == Q_FORMAL ||
+                                         f->f_quads[head].q_op == Q_LOCALLOC);
+        head++)
+      ;
+   memset(&g, 0, sizeof(g));
+   memset(&b, 0, sizeof(b));
+   for (nloc = i = 0; i < head; i++) {
+      *qinsert(&g, g.f_nquads, 1) = f->f_quads[i];
+      if (f->f_quads[i].q_op == Q_LOCALLOC)
+         nloc++;
+   }
+   for (i = head; i < f->f_nquads; i++) {
+      if (skip[i])
+         continue;
+      if ((c = at[i]) == NULL) {
+         *qinsert(&b, b.f_nquads, 1) = f->f_quads[i];
+         continue;
+      }
+      for (k = 0; k < c->c_nformals; k++)
+         iemit(&g, Q_LOCALLOC)->q_n = c->c_formals[k] == 'f' ? 8 : 4;
+      for (k = 0; k < c->c_nlocals; k++)
+         iemit(&g, Q_LOCALLOC)->q_n = c->c_locals[k];
+      iemit(&g, Q_LOCALLOC)->q_n = f->f_quads[i].q_t == 'f' ? 8 : 4;
+      iexpand1(&b, c, &f->f_quads[i], nloc);
+      nloc += c->c_nformals + c->c_nlocals + 1;
+   }
+   q = qinsert(&g, g.f_nquads, b.f_nquads);
+   memcpy(q, b.f_quads, b.f_nquads * sizeof(struct quad));
+   g.f_ntemp = ntmp;
+   free(b.f_quads);
+   free(f->f_quads);
+   *f = g;
+   free(at);
+   free(skip);
+
+   pthread_mutex_lock(&ilock);
+   icalls += n;
+   pthread_mutex_unlock(&ilock);
+}
+
+/*
+ * iclear - forget the functions kept for the file just compiled
+ */
+void iclear()
+{
+   struct icallee *c;
+   int h;
+
+   for (h = 0; h < IHASH; h++)
+      while ((c = itab[h]) != NULL) {
+         itab[h] = c->c_next;
+         free(c->c_body);
+         free(c->c_formals);
+         free(c->c_locals);
+         free(c);
+      }
+}
+
+/*
+ * istats - print the calls expanded on fp
+ */
+void istats(FILE *fp)
+{
+   fprintf(fp, "inline: %ld calls expanded\n", icalls);
+}
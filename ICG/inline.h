@@ -0,0 +1,4 @@
+void iexpand(struct qfunc *);
+void ilearn(struct qfunc *);
+void iclear();
+void istats(FILE *);
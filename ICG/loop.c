@@ -0,0 +1,460 @@
+/* loop optimizations over the quads of a function */
+
+# include <stdio.h>
+# include <stdlib.h>
+# include <string.h>
+# include "cc.h"
+# include "quad.h"
+# include "cfg.h"
+# include "opt.h"
+# include "sym.h"
+
+/*
+ * preheader - find where quads run once before loop l is entered, or -1
+ *
+ * The loop must be entered only from the block just before its header,
+ * by falling into it or by a branch to it; the quads go at the end of
+ * that block, before any branch.  The header must also come first, as
+ * csem lays out its loops.
+ */
+static int preheader(struct cfg *g, struct loop *l, char *inl)
+{
+   struct block *h = &g->c_blocks[l->l_head], *p;
+   int i, op, n = 0;
+
+   if (l->l_blocks[0] != l->l_head || l->l_head == 0)
+      return (-1);
+   for (i = 0; i < h->b_npred; i++)
+      if (!inl[h->b_pred[i]])
+         n++;
+   p = h - 1;
+   if (n != 1 || inl[p - g->c_blocks] || p->b_nsucc != 1 ||
+       p->b_succ[0] != l->l_head)
+      return (-1);
+   op = g->c_f->f_quads[p->b_last - 1].q_op;
+   if (op == Q_BT || op == Q_BR || op == Q_GOTO)
+      return (p->b_last - 1);
+   return (h->b_first);
+}
+
+/*
+ * qbase - the quad naming the variable address temporary t points into,
+ *         or NULL if it is not known
+ */
+static struct quad *qbase(struct quad **def, int lo, int t)
+{
+   struct quad *q;
+
+   while ((q = def[t - lo]) != NULL && q->q_op == Q_INDEX)
+      t = q->q_x;
+   if (q && (q->q_op == Q_GLOBAL || q->q_op == Q_LOCAL || q->q_op == Q_PARAM))
+      return (q);
+   return (NULL);
+}
+
+/*
+ * samebase - nonzero if a and b name the same variable
+ */
+static int samebase(struct quad *a, struct quad *b)
+{
+   return (a->q_op == b->q_op && a->q_n == b->q_n && a->q_s == b->q_s);
+}
+
+/*
+ * invariant - nonzero if quad q of a loop computes the same value on every
+ *             iteration and may run even when the loop would not run it
+ *
+ * Operands must be set outside the loop or by quads found invariant.  A
+ * load must be from a variable itself, not an element, and the loop must
+ * store to no variable it cannot name, call nothing, and never store to
+ * that variable.
+ */
+static int invariant(struct quad *q, char *inloop, char *inv, int lo,
+                     struct quad **def, struct quad **stores, int nstores)
+{
+   struct quad *b;
+   int i;
+
+   switch (q->q_op) {
+      case Q_DEREF:
+         if (nstores < 0 || (b = def[q->q_y - lo]) == NULL ||
+             (b->q_op != Q_GLOBAL && b->q_op != Q_LOCAL && b->q_op != Q_PARAM))
+            return (0);
+         for (i = 0; i < nstores; i++)
+            if (samebase(b, stores[i]))
+               return (0);
+         break;
+      default:
+         if (!(qops[q->q_op].o_flags & O_PURE) ||
+             (qops[q->q_op].o_flags & O_TRAP && q->q_t != 'f'))
+            return (0);
+         break;
+   }
+   if (qusesx(q->q_op) && inloop[q->q_x - lo] && !inv[q->q_x - lo])
+      return (0);
+   if (qusesy(q->q_op) && q->q_y && inloop[q->q_y - lo] && !inv[q->q_y - lo])
+      return (0);
+   return (1);
+}
+
+/*
+ * hoist - move the invariant quads of loop l of g to its preheader,
+ *         return the number moved
+ */
+static int hoist(struct cfg *g, struct loop *l, struct quad **def, int lo,
+                 int hi)
+{
+   struct qfunc *f = g->c_f;
+   struct quad *q, **stores, *nq;
+   struct block *b;
+   char *inl, *inloop, *inv, *moved;
+   int at, i, j, nstores, n = 0, changed;
+
+   inl = oalloc(g->c_nblocks);
+   for (i = 0; i < l->l_nblocks; i++)
+      inl[l->l_blocks[i]] = 1;
+   if ((at = preheader(g, l, inl)) < 0) {
+      free(inl);
+      return (0);
+   }
+   inloop = oalloc(hi - lo + 1);
+   inv = oalloc(hi - lo + 1);
+   moved = oalloc(f->f_nquads);
+   stores = (struct quad **) oalloc(f->f_nquads * sizeof(struct quad *));
+
+   /* what the loop sets */
+   nstores = 0;
+   for (i = 0; i < l->l_nblocks; i++) {
+      b = &g->c_blocks[l->l_blocks[i]];
+      for (q = &f->f_quads[b->b_first]; q < &f->f_quads[b->b_last]; q++) {
+         if (q->q_z)
+            inloop[q->q_z - lo] = 1;
+         if (q->q_op == Q_CALL)
+            nstores = -1;
+         else if (q->q_op == Q_ASSIGN && nstores >= 0) {
+            if ((stores[nstores] = qbase(def, lo, q->q_x)) == NULL)
+               nstores = -1;
+            else
+               nstores++;
+         }
+      }
+   }
+
+   do {
+      changed = 0;
+      for (i = 0; i < l->l_nblocks; i++) {
+         b = &g->c_blocks[l->l_blocks[i]];
+         for (j = b->b_first; j < b->b_last; j++)
+            if (!moved[j] && invariant(&f->f_quads[j], inloop, inv, lo, def,
+                                       stores, nstores)) {
+               moved[j] = 1;
+               inv[f->f_quads[j].q_z - lo] = 1;
+               changed = 1;
+               n++;
+            }
+      }
+   } while (changed);
+
+   if (n) {
+      nq = (struct quad *) oalloc(f->f_nquads * sizeof(struct quad));
+      for (i = j = 0; i < at; i++)
+         nq[j++] = f->f_quads[i];
+      for (i = at; i < f->f_nquads; i++)
+         if (moved[i])
+            nq[j++] = f->f_quads[i];
+      for (i = at; i < f->f_nquads; i++)
+         if (!moved[i])
+            nq[j++] = f->f_quads[i];
+      memcpy(f->f_quads, nq, f->f_nquads * sizeof(struct quad));
+      free(nq);
+   }
+   free(inl);
+   free(inloop);
+   free(inv);
+   free(moved);
+   free(stores);
+   return (n);
+}
+
+/*
+ * licm - loop-invariant code motion, return number of quads moved
+ *
+ * Loops are taken inner first, so a quad hoisted out of an inner loop may
+ * go on out of the one around it.  Moving quads renumbers them, so the
+ * graph is rebuilt after each loop that changes; a loop is known by the
+ * label of its header.
+ */
+int licm(struct qfunc *f)
+{
+   struct cfg g;
+   struct quad *q, **def;
+   int *done, ndone = 0, lo, hi, moved = 0, n, i, k, lab;
+
+   qtemps(f, &lo, &hi);
+   def = (struct quad **) oalloc((hi - lo + 1) * sizeof(struct quad *));
+   done = NULL;
+   for (n = 1; n; ) {
+      cfgbuild(&g, f);
+      cfgloops(&g);
+      if (done == NULL)
+         done = (int *) oalloc((g.c_nblocks + 1) * sizeof(int));
+      for (q = f->f_quads; q < &f->f_quads[f->f_nquads]; q++)
+         if (q->q_z)
+            def[q->q_z - lo] = q;
+      for (n = i = 0; i < g.c_nloops && n == 0; i++) {
+         lab = f->f_quads[g.c_blocks[g.c_loops[i].l_head].b_first].q_n;
+         for (k = 0; k < ndone && done[k] != lab; k++)
+            ;
+         if (k < ndone)
+            continue;
+         done[ndone++] = lab;
+         n = hoist(&g, &g.c_loops[i], def, lo, hi);
+      }
+      moved += n;
+      cfgfree(&g);
+   }
+   free(def);
+   free(done);
+   return (moved);
+}
+
+/*
+ * escapes - nonzero if the address of variable v is used other than to
+ *           load or store it, so it may change behind a store to v
+ */
+static int escapes(struct qfunc *f, struct quad **def, int lo, struct quad *v)
+{
+   struct quad *q, *d;
+
+   for (q = f->f_quads; q < &f->f_quads[f->f_nquads]; q++) {
+      if (qusesx(q->q_op) && (d = def[q->q_x - lo]) != NULL &&
+          samebase(d, v) && q->q_op != Q_ASSIGN)
+         return (1);
+      if (qusesy(q->q_op) && q->q_y && (d = def[q->q_y - lo]) != NULL &&
+          samebase(d, v) && q->q_op != Q_DEREF)
+         return (1);
+   }
+   return (0);
+}
+
+/*
+ * loadof - the variable quad q loads directly from, or NULL
+ */
+static struct quad *loadof(struct quad **def, int lo, struct quad *q)
+{
+   struct quad *d;
+
+   if (q == NULL || q->q_op != Q_DEREF || q->q_t != 'i')
+      return (NULL);
+   d = def[q->q_y - lo];
+   if (d && (d->q_op == Q_LOCAL || d->q_op == Q_PARAM))
+      return (d);
+   return (NULL);
+}
+
+/*
+ * stepof - the constant an induction variable v is stepped by in store
+ *          q, or 0 if q does not store v + c, c + v or v - c into v
+ */
+static int stepof(struct quad **def, int lo, struct quad *q, struct quad *v)
+{
+   struct quad *s, *a, *c;
+   int sign = 1;
+
+   s = def[q->q_y - lo];
+   if (s == NULL || s->q_t != 'i' || (s->q_op != Q_ADD && s->q_op != Q_SUB))
+      return (0);
+   a = def[s->q_x - lo];
+   c = def[s->q_y - lo];
+   if (s->q_op == Q_SUB)
+      sign = -1;
+   else if (c && c->q_op != Q_CON) {
+      a = def[s->q_y - lo];
+      c = def[s->q_x - lo];
+   }
+   if (a == NULL || c == NULL || c->q_op != Q_CON || loadof(def, lo, a) == NULL ||
+       !samebase(loadof(def, lo, a), v) || strlen(c->q_s) > 6)
+      return (0);
+   return (sign * atoi(c->q_s));
+}
+
+/*
+ * reduce - give one set of array subscripts of loop l of g a running
+ *          address, return the number of subscripts reduced
+ *
+ * The subscript a[i] is a candidate when a is set outside the loop, i is
+ * loaded in the same block, and i is an int variable whose address goes
+ * nowhere, stored in the loop only once, to i + c.  A new local holds the
+ * address of a[i]: it is set before the loop, bumped by c elements right
+ * after the store to i, and loaded in place of each a[i] with the same a.
+ */
+static int reduce(struct cfg *g, struct loop *l, struct quad **def, int lo)
+{
+   struct qfunc *f = g->c_f;
+   struct quad *q, *v, *sv = NULL, *base = NULL, *p, var;
+   char *inl;
+   int *blk, at, i, j, n = 0, st = 0, step = 0, nst, ld, nloc, lalloc;
+   int bt, bx, ta, tk, ts, t;
+   char lit[16];
+
+   blk = (int *) oalloc(f->f_nquads * sizeof(int));
+   for (i = 0; i < f->f_nquads; i++)
+      blk[i] = -1;
+   for (i = 0; i < l->l_nblocks; i++)
+      for (j = g->c_blocks[l->l_blocks[i]].b_first;
+           j < g->c_blocks[l->l_blocks[i]].b_last; j++)
+         blk[j] = l->l_blocks[i];
+
+   /* the first candidate fixes i and a */
+   for (j = 0; j < f->f_nquads && base == NULL; j++) {
+      q = &f->f_quads[j];
+      if (blk[j] < 0 || q->q_op != Q_INDEX || def[q->q_x - lo] == NULL ||
+          blk[def[q->q_x - lo] - f->f_quads] >= 0 ||
+          (v = loadof(def, lo, def[q->q_y - lo])) == NULL)
+         continue;
+      ld = def[q->q_y - lo] - f->f_quads;
+      if (blk[ld] != blk[j] || escapes(f, def, lo, v))
+         continue;
+      for (nst = i = 0; i < f->f_nquads; i++)
+         if (blk[i] >= 0 && f->f_quads[i].q_op == Q_ASSIGN &&
+             def[f->f_quads[i].q_x - lo] &&
+             samebase(def[f->f_quads[i].q_x - lo], v)) {
+            nst++;
+            st = i;
+         }
+      if (nst != 1 || (step = stepof(def, lo, &f->f_quads[st], v)) == 0 ||
+          (st > ld && st < j))
+         continue;
+      sv = v;
+      base = q;
+   }
+   inl = oalloc(g->c_nblocks);
+   for (i = 0; i < l->l_nblocks; i++)
+      inl[l->l_blocks[i]] = 1;
+   at = base ? preheader(g, l, inl) : -1;
+   free(inl);
+   if (at < 0) {
+      free(blk);
+      return (0);
+   }
+
+   /* the subscripts of a by i */
+   var = *sv;
+   bt = base->q_t;
+   bx = base->q_x;
+   tk = qnewtemp(f);
+   for (j = 0; j < f->f_nquads; j++) {
+      q = &f->f_quads[j];
+      if (blk[j] < 0 || q->q_op != Q_INDEX || q->q_x != bx || q->q_t != bt ||
+          (v = loadof(def, lo, def[q->q_y - lo])) == NULL ||
+          !samebase(v, &var))
+         continue;
+      ld = def[q->q_y - lo] - f->f_quads;
+      if (blk[ld] != blk[j] || (st > ld && st < j))
+         continue;
+      q->q_op = Q_DEREF;
+      q->q_t = 'i';
+      q->q_x = 0;
+      q->q_y = tk;
+      n++;
+   }
+   free(blk);
+
+   /* bump the address after the store to i */
+   p = qinsert(f, st + 1, 3);
+   p[0].q_op = Q_DEREF;
+   p[0].q_t = 'i';
+   p[0].q_z = t = qnewtemp(f);
+   p[0].q_y = tk;
+   p[1].q_op = step < 0 ? Q_SUB : Q_ADD;
+   p[1].q_t = 'i';
+   p[1].q_z = qnewtemp(f);
+   p[1].q_x = t;
+   p[1].q_y = ts = qnewtemp(f);
+   p[2].q_op = Q_ASSIGN;
+   p[2].q_t = 'i';
+   p[2].q_x = tk;
+   p[2].q_y = p[1].q_z;
+
+   /* set it before the loop */
+   for (nloc = lalloc = i = 0; i < at; i++)
+      if (f->f_quads[i].q_op == Q_LOCALLOC) {
+         nloc++;
+         lalloc = i + 1;
+      }
+      else if (f->f_quads[i].q_op == Q_FUNC || f->f_quads[i].q_op == Q_FORMAL)
+         lalloc = i + 1;
+   p = qinsert(f, at, 6);
+   p[0].q_op = Q_LOCAL;
+   p[0].q_z = tk;
+   p[0].q_n = nloc;
+   p[1] = var;
+   p[1].q_z = ta = qnewtemp(f);
+   p[2].q_op = Q_DEREF;
+   p[2].q_t = 'i';
+   p[2].q_z = t = qnewtemp(f);
+   p[2].q_y = ta;
+   p[3].q_op = Q_INDEX;
+   p[3].q_t = bt;
+   p[3].q_z = qnewtemp(f);
+   p[3].q_x = bx;
+   p[3].q_y = t;
+   p[4].q_op = Q_ASSIGN;
+   p[4].q_t = 'i';
+   p[4].q_x = tk;
+   p[4].q_y = p[3].q_z;
+   p[5].q_op = Q_CON;
+   p[5].q_t = 'i';
+   p[5].q_z = ts;
+   sprintf(lit, "%d", (step < 0 ? -step : step) * (bt == 'f' ? 8 : 4));
+   p[5].q_s = slookup(lit);
+
+   /* and give it room */
+   p = qinsert(f, lalloc, 1);
+   p->q_op = Q_LOCALLOC;
+   p->q_n = 4;
+   return (n);
+}
+
+/*
+ * ivsr - induction-variable strength reduction, return number of array
+ *        subscripts reduced
+ *
+ * Each change renumbers the quads, so the graph is rebuilt after it, and
+ * a loop is left alone once nothing in it changes.
+ */
+int ivsr(struct qfunc *f)
+{
+   struct cfg g;
+   struct quad *q, **def;
+   int *done, ndone = 0, lo, hi, reduced = 0, n, i, k, lab;
+
+   done = NULL;
+   def = NULL;
+   for (n = 1; n; ) {
+      qtemps(f, &lo, &hi);
+      free(def);
+      def = (struct quad **) oalloc((hi - lo + 1) * sizeof(struct quad *));
+      for (q = f->f_quads; q < &f->f_quads[f->f_nquads]; q++)
+         if (q->q_z)
+            def[q->q_z - lo] = q;
+      cfgbuild(&g, f);
+      cfgloops(&g);
+      if (done == NULL)
+         done = (int *) oalloc((g.c_nblocks + 1) * sizeof(int));
+      for (n = i = 0; i < g.c_nloops && n == 0; i++) {
+         lab = f->f_quads[g.c_blocks[g.c_loops[i].l_head].b_first].q_n;
+         for (k = 0; k < ndone && done[k] != lab; k++)
+            ;
+         if (k < ndone)
+            continue;
+         if ((n = reduce(&g, &g.c_loops[i], def, lo)) == 0)
+            done[ndone++] = lab;
+      }
+      reduced += n;
+      cfgfree(&g);
+   }
+   free(def);
+   free(done);
+   return (reduced);
+}
@@ -0,0 +1,886 @@
+/* optimization passes over the quads of a function */
+
+# include <stdio.h>
+# include <stdlib.h>
+# include <string.h>
+# include <math.h>
+# include <time.h>
+# include <pthread.h>
+# include "cc.h"
+# include "quad.h"
+# include "opt.h"
+# include "sym.h"
+
+extern void yyerror(const char *);
+
+int optlevel = 0;			/* -O level */
+int ostat = 0;				/* keep statistics of the passes */
+
+/* value table entry for local value numbering */
+struct vn {
+   int v_op;				/* opcode */
+   int v_t;				/* type suffix */
+   int v_x;				/* first operand */
+   int v_y;				/* second operand */
+   int v_n;				/* integer operand */
+   char *v_s;				/* name or literal */
+   int v_z;				/* temporary holding the value */
+   int v_gen;				/* generation the entry is valid for */
+};
+
+/* constant pool entry, materialized at function entry */
+struct kon {
+   struct kval p_v;			/* the value */
+   int p_z;				/* temporary holding it */
+   int p_op;				/* Q_CON, or Q_NEG or Q_CV of p_y */
+   int p_y;				/* pool temporary the value is built from */
+   char *p_s;				/* literal of a Q_CON */
+};
+
+/* the constant pool of a function */
+struct kpool {
+   struct kon *k_ent;			/* entries, each after those it uses */
+   int k_n;				/* entries in use */
+   int *k_tab;				/* hash table of entry index + 1 */
+   unsigned k_mask;			/* size of k_tab - 1 */
+   struct qfunc *k_f;			/* function the temporaries are of */
+};
+
+/*
+ * oalloc - allocate n zeroed bytes of scratch space for a pass
+ */
+char *oalloc(unsigned n)
+{
+   char *p;
+
+   if ((p = calloc(1, n ? n : 1)) == NULL) {
+      yyerror("csem: out of space");
+      exit (1);
+   }
+   return (p);
+}
+
+/*
+ * commutes - nonzero if the operands of op may be swapped
+ */
+static int commutes(int op)
+{
+   return (qops[op].o_flags & O_COMM);
+}
+
+/*
+ * pure - nonzero if the value of quad q depends only on its operands
+ */
+static int pure(struct quad *q)
+{
+   return (qops[q->q_op].o_flags & O_PURE);
+}
+
+/*
+ * vnlook - find the live entry for key k, or the slot to put it in
+ *
+ * A load is live in memory generation memgen, anything else in block
+ * generation blkgen.  A slot holding an entry that is no longer live is
+ * passed over, since the entry sought may have gone in after it, and the
+ * first one is handed back for reuse.  The probe ends at a slot never
+ * filled; there is always one, as each quad fills at most one slot of a
+ * table twice its length.
+ */
+static struct vn *vnlook(struct vn *tab, unsigned mask, struct vn *k,
+                         int blkgen, int memgen)
+{
+   struct vn *v, *old = NULL;
+   unsigned h;
+
+   h = k->v_op * 31u + k->v_t;
+   h = h * 1000003u ^ k->v_x;
+   h = h * 1000003u ^ k->v_y;
+   h = h * 1000003u ^ k->v_n;
+   h = h * 1000003u ^ (unsigned) (unsigned long) k->v_s;
+   for (h &= mask;; h = (h + 1) & mask) {
+      v = &tab[h];
+      if (v->v_gen == 0)
+         return (old ? old : v);
+      if (v->v_gen != (v->v_op == Q_DEREF ? memgen : blkgen)) {
+         if (old == NULL)
+            old = v;
+         continue;
+      }
+      if (v->v_op == k->v_op && v->v_t == k->v_t && v->v_x == k->v_x &&
+          v->v_y == k->v_y && v->v_n == k->v_n && v->v_s == k->v_s)
+         return (v);
+   }
+}
+
+/*
+ * lvn - local value numbering, return number of quads removed
+ *
+ * Within a basic block, a quad computing a value some earlier temporary
+ * already holds is deleted and its result renamed to that temporary.
+ * Temporaries are assigned once, so the renaming is valid throughout
+ * the function; a use laid out before the definition, as leaving SSA
+ * form makes at the end of a loop body, is renamed after.  Loads are
+ * remembered until the next store or call, and a store makes the stored
+ * value the result of a later load from the same address.
+ */
+int lvn(struct qfunc *f)
+{
+   struct quad *q;
+   struct vn *tab, *v, k;
+   int *canon, lo, hi, removed = 0, blkgen, memgen, gen, t;
+   unsigned size, mask;
+
+   qtemps(f, &lo, &hi);
+   canon = (int *) oalloc((hi - lo + 1) * sizeof(int));
+   for (size = 16; size < 2 * f->f_nquads; size *= 2)
+      ;
+   mask = size - 1;
+   tab = (struct vn *) oalloc(size * sizeof(struct vn));
+   blkgen = memgen = 1;
+
+   for (q = f->f_quads; q < &f->f_quads[f->f_nquads]; q++) {
+      if (q->q_op == Q_LABEL || q->q_op == Q_FUNC) {
+         blkgen = ++memgen;
+         memgen++;
+      }
+      if (qusesx(q->q_op) && canon[q->q_x - lo])
+         q->q_x = canon[q->q_x - lo];
+      if (qusesy(q->q_op) && q->q_y && canon[q->q_y - lo])
+         q->q_y = canon[q->q_y - lo];
+
+      if (pure(q) || q->q_op == Q_DEREF) {
+         memset(&k, 0, sizeof(k));
+         k.v_op = q->q_op;
+         k.v_t = q->q_t;
+         k.v_x = qusesx(q->q_op) ? q->q_x : 0;
+         k.v_y = q->q_y;
+         k.v_n = q->q_n;
+         k.v_s = q->q_s;
+         if (commutes(k.v_op) && k.v_x > k.v_y) {
+            t = k.v_x;
+            k.v_x = k.v_y;
+            k.v_y = t;
+         }
+         gen = q->q_op == Q_DEREF ? memgen : blkgen;
+         v = vnlook(tab, mask, &k, blkgen, memgen);
+         if (v->v_gen == gen) {
+            canon[q->q_z - lo] = v->v_z;
+            q->q_op = Q_DEAD;
+            removed++;
+            continue;
+         }
+         *v = k;
+         v->v_z = q->q_z;
+         v->v_gen = gen;
+      }
+      else if (q->q_op == Q_ASSIGN) {
+         /* a store forgets every load, then makes one */
+         memgen++;
+         if (q->q_z)
+            canon[q->q_z - lo] = q->q_y;
+         memset(&k, 0, sizeof(k));
+         k.v_op = Q_DEREF;
+         k.v_t = q->q_t;
+         k.v_y = q->q_x;
+         v = vnlook(tab, mask, &k, blkgen, memgen);
+         *v = k;
+         v->v_z = q->q_y;
+         v->v_gen = memgen;
+      }
+      else if (q->q_op == Q_CALL)
+         memgen++;
+      else if (q->q_op == Q_BT || q->q_op == Q_BR || q->q_op == Q_GOTO ||
+               q->q_op == Q_RET) {
+         blkgen = ++memgen;
+         memgen++;
+      }
+   }
+   for (q = f->f_quads; q < &f->f_quads[f->f_nquads]; q++) {
+      while (qusesx(q->q_op) && canon[q->q_x - lo])
+         q->q_x = canon[q->q_x - lo];
+      while (qusesy(q->q_op) && q->q_y && canon[q->q_y - lo])
+         q->q_y = canon[q->q_y - lo];
+   }
+   qcompact(f);
+   free(canon);
+   free(tab);
+   return (removed);
+}
+
+/*
+ * kslot - find the slot of k_tab holding value v, or the empty one for it
+ */
+static int *kslot(struct kpool *kp, struct kval *v)
+{
+   struct kval *e;
+   unsigned long b;
+   unsigned h;
+   int *p;
+
+   if (v->k_t == 'i')
+      h = v->k_i * 2654435761u;
+   else {
+      memcpy(&b, &v->k_d, sizeof(b));
+      h = (unsigned) (b ^ b >> 32) * 2246822519u + 1;
+   }
+   for (h &= kp->k_mask;; h = (h + 1) & kp->k_mask) {
+      p = &kp->k_tab[h];
+      if (*p == 0)
+         return (p);
+      e = &kp->k_ent[*p - 1].p_v;
+      if (e->k_t == v->k_t && (v->k_t == 'i' ? e->k_i == v->k_i :
+          memcmp(&e->k_d, &v->k_d, sizeof(double)) == 0))
+         return (p);
+   }
+}
+
+/*
+ * ktemp - return the pool temporary holding v, adding it as tz if new
+ *
+ * Quads have only unsigned int literals, so a negative value is pooled as
+ * the negation of its magnitude and a double as the conversion of an int.
+ */
+static int ktemp(struct kpool *kp, struct kval *v, int z)
+{
+   struct kval u;
+   struct kon *e;
+   char buf[16];
+   int *p, op, y = 0;
+
+   if (*(p = kslot(kp, v)) != 0)
+      return (kp->k_ent[*p - 1].p_z);
+   u = *v;
+   if (v->k_t == 'i' && v->k_i < 0) {
+      op = Q_NEG;
+      u.k_i = -v->k_i;
+   }
+   else if (v->k_t == 'f' && v->k_d < 0) {
+      op = Q_NEG;
+      u.k_d = -v->k_d;
+   }
+   else if (v->k_t == 'f') {
+      op = Q_CV;
+      u.k_t = 'i';
+      u.k_i = (int) v->k_d;
+   }
+   else
+      op = Q_CON;
+   if (op != Q_CON) {
+      y = ktemp(kp, &u, 0);
+      p = kslot(kp, v);
+   }
+   e = &kp->k_ent[kp->k_n++];
+   *p = kp->k_n;
+   e->p_v = *v;
+   e->p_z = z ? z : qnewtemp(kp->k_f);
+   e->p_op = op;
+   e->p_y = y;
+   e->p_s = NULL;
+   if (op == Q_CON) {
+      sprintf(buf, "%d", v->k_i);
+      e->p_s = slookup(buf);
+   }
+   return (e->p_z);
+}
+
+/*
+ * kpoolable - nonzero if the pool can hold value v
+ */
+static int kpoolable(struct kval *v)
+{
+   if (v->k_t == 'i')
+      return (v->k_i != -2147483647 - 1);
+   return (v->k_t == 'f' && v->k_d >= -2147483647.0 &&
+           v->k_d <= 2147483647.0 && v->k_d == (int) v->k_d &&
+           !(v->k_d == 0 && signbit(v->k_d)));
+}
+
+/*
+ * kfold - compute the value of quad q from the values a and b of its
+ *         operands, return 0 if it cannot be known
+ */
+int kfold(struct quad *q, struct kval *a, struct kval *b, struct kval *r)
+{
+   unsigned ua, ub;
+   int ia, ib, c;
+   double da, db;
+
+   if (q->q_op == Q_CON) {
+      r->k_t = 'i';
+      r->k_d = strtod(q->q_s, NULL);
+      r->k_i = (int) r->k_d;
+      return (r->k_d <= 2147483647.0);
+   }
+   if (b == NULL || b->k_t == 0 || (a != NULL && a->k_t != b->k_t))
+      return (0);
+   ia = a ? a->k_i : 0;
+   ib = b->k_i;
+   ua = ia;
+   ub = ib;
+   da = a ? a->k_d : 0;
+   db = b->k_d;
+   r->k_t = q->q_t;
+   r->k_i = 0;
+   r->k_d = 0;
+   if (q->q_op == Q_CV) {
+      if (q->q_t == 'f')
+         r->k_d = b->k_t == 'f' ? db : ib;
+      else if (b->k_t == 'i')
+         r->k_i = ib;
+      else if (db > -2147483649.0 && db < 2147483648.0)
+         r->k_i = (int) db;
+      else
+         return (0);
+      return (1);
+   }
+   if (b->k_t != q->q_t)
+      return (0);
+   if (q->q_op >= Q_EQ && q->q_op <= Q_GE) {
+      c = b->k_t == 'f' ? (da > db) - (da < db) : (ia > ib) - (ia < ib);
+      r->k_t = 'i';
+      switch (q->q_op) {
+         case Q_EQ: r->k_i = c == 0; break;
+         case Q_NE: r->k_i = c != 0; break;
+         case Q_LT: r->k_i = c < 0; break;
+         case Q_LE: r->k_i = c <= 0; break;
+         case Q_GT: r->k_i = c > 0; break;
+         case Q_GE: r->k_i = c >= 0; break;
+      }
+      return (!(b->k_t == 'f' && (isnan(da) || isnan(db))));
+   }
+   if (q->q_t == 'f') {
+      switch (q->q_op) {
+         case Q_NEG: r->k_d = -db; break;
+         case Q_ADD: r->k_d = da + db; break;
+         case Q_SUB: r->k_d = da - db; break;
+         case Q_MUL: r->k_d = da * db; break;
+         case Q_DIV:
+            if (db == 0)
+               return (0);
+            r->k_d = da / db;
+            break;
+         default:
+            return (0);
+      }
+      return (1);
+   }
+   switch (q->q_op) {
+      case Q_NEG:
+         if (ib == -2147483647 - 1)
+            return (0);
+         r->k_i = -ib;
+         break;
+      case Q_COM: r->k_i = ~ib; break;
+      case Q_ADD: r->k_i = (int) (ua + ub); break;
+      case Q_SUB: r->k_i = (int) (ua - ub); break;
+      case Q_MUL: r->k_i = (int) (ua * ub); break;
+      case Q_DIV: case Q_MOD:
+         if (ib == 0 || (ia == -2147483647 - 1 && ib == -1))
+            return (0);
+         r->k_i = q->q_op == Q_DIV ? ia / ib : ia % ib;
+         break;
+      case Q_OR: r->k_i = ia | ib; break;
+      case Q_XOR: r->k_i = ia ^ ib; break;
+      case Q_AND: r->k_i = ia & ib; break;
+      case Q_LSH: case Q_RSH:
+         if (ib < 0 || ib > 31)
+            return (0);
+         r->k_i = q->q_op == Q_LSH ? (int) (ua << ib) : ia >> ib;
+         break;
+      default:
+         return (0);
+   }
+   return (1);
+}
+
+/*
+ * fold - constant folding and pooling, return number of quads removed
+ *
+ * Temporaries are assigned once, so one pass in order finds every one
+ * whose value is known.  A quad computing a known value is deleted and
+ * its result renamed to the pool temporary for the value.  The pool
+ * entries still used are materialized once, at the first statement of
+ * the function, which every use follows.  A double is folded only if
+ * the pool can hold the result.
+ */
+int fold(struct qfunc *f)
+{
+   struct quad *q;
+   struct kval *kv, *a, *b, r;
+   struct kpool kp;
+   struct kon *e;
+   int *canon, lo, hi, removed = 0, i, n, x, y;
+   unsigned size;
+   char *used;
+
+   qtemps(f, &lo, &hi);
+   kv = (struct kval *) oalloc((hi - lo + 1) * sizeof(struct kval));
+   canon = (int *) oalloc((hi - lo + 1) * sizeof(int));
+   kp.k_ent = (struct kon *) oalloc((3 * f->f_nquads + 3) * sizeof(struct kon));
+   for (size = 16; size < 6 * f->f_nquads + 6; size *= 2)
+      ;
+   kp.k_tab = (int *) oalloc(size * sizeof(int));
+   kp.k_mask = size - 1;
+   kp.k_n = 0;
+   kp.k_f = f;
+
+   for (q = f->f_quads; q < &f->f_quads[f->f_nquads]; q++) {
+      a = b = NULL;
+      x = qusesx(q->q_op) ? q->q_x : 0;
+      y = qusesy(q->q_op) ? q->q_y : 0;
+      if (x) {
+         a = &kv[x - lo];
+         if (canon[x - lo])
+            q->q_x = canon[x - lo];
+      }
+      if (y) {
+         b = &kv[y - lo];
+         if (canon[y - lo])
+            q->q_y = canon[y - lo];
+      }
+      if (q->q_op != Q_CON && q->q_op != Q_CV && q->q_op != Q_NEG &&
+          q->q_op != Q_COM && (q->q_op < Q_ADD || q->q_op > Q_GE))
+         continue;
+      if (!kfold(q, a, b, &r))
+         continue;
+      kv[q->q_z - lo] = r;
+      if (!kpoolable(&r))
+         continue;
+      canon[q->q_z - lo] = ktemp(&kp, &r, q->q_z);
+      q->q_op = Q_DEAD;
+      removed++;
+   }
+   qcompact(f);
+
+   /* materialize the entries still used, and those they are built from */
+   used = (char *) oalloc(f->f_ntemp - lo + 1);
+   for (q = f->f_quads; q < &f->f_quads[f->f_nquads]; q++) {
+      if (qusesx(q->q_op))
+         used[q->q_x - lo] = 1;
+      if (qusesy(q->q_op) && q->q_y)
+         used[q->q_y - lo] = 1;
+   }
+   for (n = 0, i = kp.k_n - 1; i >= 0; i--)
+      if (used[kp.k_ent[i].p_z - lo]) {
+         n++;
+         if (kp.k_ent[i].p_y)
+            used[kp.k_ent[i].p_y - lo] = 1;
+      }
+   if (n) {
+      for (i = 0; i < f->f_nquads && f->f_quads[i].q_op != Q_BGNSTMT; i++)
+         ;
+      q = qinsert(f, i < f->f_nquads ? i + 1 : i, n);
+      for (e = kp.k_ent; e < &kp.k_ent[kp.k_n]; e++)
+         if (used[e->p_z - lo]) {
+            q->q_op = e->p_op;
+            q->q_t = e->p_v.k_t;
+            q->q_z = e->p_z;
+            q->q_y = e->p_y;
+            q->q_s = e->p_s;
+            q++;
+         }
+      removed -= n;
+   }
+   free(used);
+   free(kv);
+   free(canon);
+   free(kp.k_ent);
+   free(kp.k_tab);
+   return (removed);
+}
+
+/*
+ * isconst - nonzero if temporary t is known to be the int c, or the
+ *           double c if t is a cvf of one
+ */
+static int isconst(struct quad **def, int lo, int t, int c)
+{
+   struct quad *q = def[t - lo];
+
+   if (q && q->q_op == Q_CV && q->q_t == 'f')
+      q = def[q->q_y - lo];
+   return (q && q->q_op == Q_CON && q->q_s[0] == '0' + c && q->q_s[1] == '\0');
+}
+
+/*
+ * copyprop - copy propagation, return number of quads removed
+ *
+ * The quads have no move; the copies are quads whose value is that of
+ * an operand: an assignment's result, a cvi of a cvf of an int, and
+ * identities such as x + 0, x * 1 and x / 1.  Uses of the result are
+ * renamed to the operand and the quad, unless it is a store, deleted.
+ */
+int copyprop(struct qfunc *f)
+{
+   struct quad *q, **def;
+   int *canon, lo, hi, removed = 0, c;
+
+   qtemps(f, &lo, &hi);
+   canon = (int *) oalloc((hi - lo + 1) * sizeof(int));
+   def = (struct quad **) oalloc((hi - lo + 1) * sizeof(struct quad *));
+
+   for (q = f->f_quads; q < &f->f_quads[f->f_nquads]; q++) {
+      if (qusesx(q->q_op) && canon[q->q_x - lo])
+         q->q_x = canon[q->q_x - lo];
+      if (qusesy(q->q_op) && q->q_y && canon[q->q_y - lo])
+         q->q_y = canon[q->q_y - lo];
+      if (q->q_z)
+         def[q->q_z - lo] = q;
+
+      c = 0;
+      switch (q->q_op) {
+         case Q_ASSIGN:
+            if (q->q_z)
+               canon[q->q_z - lo] = q->q_y;
+            continue;
+         case Q_CV:
+            /* cast converts only ints to double */
+            if (q->q_t == 'i' && def[q->q_y - lo] &&
+                def[q->q_y - lo]->q_op == Q_CV &&
+                def[q->q_y - lo]->q_t == 'f')
+               c = def[q->q_y - lo]->q_y;
+            break;
+         case Q_ADD: case Q_OR: case Q_XOR:
+            if (q->q_t == 'f')
+               break;
+            if (isconst(def, lo, q->q_x, 0))
+               c = q->q_y;
+            else if (isconst(def, lo, q->q_y, 0))
+               c = q->q_x;
+            break;
+         case Q_SUB: case Q_LSH: case Q_RSH:
+            if (isconst(def, lo, q->q_y, 0))
+               c = q->q_x;
+            break;
+         case Q_MUL:
+            if (isconst(def, lo, q->q_x, 1))
+               c = q->q_y;
+            else if (isconst(def, lo, q->q_y, 1))
+               c = q->q_x;
+            break;
+         case Q_DIV:
+            if (isconst(def, lo, q->q_y, 1))
+               c = q->q_x;
+            break;
+      }
+      if (c) {
+         canon[q->q_z - lo] = c;
+         q->q_op = Q_DEAD;
+         removed++;
+      }
+   }
+   qcompact(f);
+   free(canon);
+   free(def);
+   return (removed);
+}
+
+/*
+ * dce - dead temporary elimination, return number of quads removed
+ *
+ * A temporary is assigned once, so it is live exactly when some quad
+ * reads it.  Going backwards, a quad with no side effect whose result
+ * is never read is deleted, which may leave its operands unread too.
+ * A store whose result is never read stays, without the result.
+ */
+int dce(struct qfunc *f)
+{
+   struct quad *q;
+   int *uses, lo, hi, removed = 0;
+
+   qtemps(f, &lo, &hi);
+   uses = (int *) oalloc((hi - lo + 1) * sizeof(int));
+   for (q = f->f_quads; q < &f->f_quads[f->f_nquads]; q++) {
+      if (qusesx(q->q_op))
+         uses[q->q_x - lo]++;
+      if (qusesy(q->q_op) && q->q_y)
+         uses[q->q_y - lo]++;
+   }
+   for (q = &f->f_quads[f->f_nquads - 1]; q >= f->f_quads; q--)
+      if (q->q_z == 0 || uses[q->q_z - lo] != 0)
+         continue;
+      else if (q->q_op == Q_ASSIGN)
+         q->q_z = 0;
+      else if (pure(q) || q->q_op == Q_DEREF) {
+         if (qusesx(q->q_op))
+            uses[q->q_x - lo]--;
+         if (qusesy(q->q_op) && q->q_y)
+            uses[q->q_y - lo]--;
+         q->q_op = Q_DEAD;
+         removed++;
+      }
+   qcompact(f);
+   free(uses);
+   return (removed);
+}
+
+/*
+ * jnext - index of the first quad of f from i on that does something,
+ *         skipping labels and statement marks
+ */
+static int jnext(struct qfunc *f, int i)
+{
+   while (i < f->f_nquads && (f->f_quads[i].q_op == Q_LABEL ||
+                              f->f_quads[i].q_op == Q_BGNSTMT ||
+                              f->f_quads[i].q_op == Q_DEAD))
+      i++;
+   return (i);
+}
+
+/*
+ * jinvert - the comparison testing the opposite of op on operands of
+ *           type t, or 0 if there is none: with a double NaN, a < b
+ *           and a >= b may both be false
+ */
+int jinvert(int op, int t)
+{
+   switch (op) {
+      case Q_EQ: return (Q_NE);
+      case Q_NE: return (Q_EQ);
+   }
+   if (t != 'i')
+      return (0);
+   switch (op) {
+      case Q_LT: return (Q_GE);
+      case Q_GE: return (Q_LT);
+      case Q_LE: return (Q_GT);
+      case Q_GT: return (Q_LE);
+   }
+   return (0);
+}
+
+/*
+ * jumps - thread branches through to where they end up, turn a branch
+ *         over a branch into one branch on the opposite test, and delete
+ *         code no branch reaches
+ *
+ * The lowering of && || ! and of the statements leaves chains like
+ * br L1 ... label L1; br L2, and bt tx L1; br L2; label L1.  A branch to
+ * a label followed by br Lm is pointed at Lm, a branch to just past
+ * itself is deleted, and bt tx L1; br L2; label L1 becomes bt ty L2 when
+ * tx is a comparison read nowhere else and ty the opposite one.  Then the
+ * quads are walked from the entry along the branches: those not reached,
+ * and the labels no branch names any more, are deleted.  A label the user
+ * wrote can be reached by a goto, so it and what follows it are kept.
+ * Nothing is done under -B, where the branches are not resolved, or to
+ * a function with a branch to no label of its own.
+ */
+int jumps(struct qfunc *f)
+{
+   struct quad *q, *p;
+   int *lpos, *uses, *def, *work, llo, lhi, lo, hi, i, j, k, n, nw, changed;
+   int done = 0;
+   char *seen;
+
+   if (qbpatch || f->f_nquads == 0 || f->f_quads[0].q_op != Q_FUNC)
+      return (0);
+   do {
+      changed = 0;
+      llo = 0x7fffffff;
+      lhi = 0;
+      for (q = f->f_quads; q < &f->f_quads[f->f_nquads]; q++)
+         if (q->q_op == Q_LABEL) {
+            llo = q->q_n < llo ? q->q_n : llo;
+            lhi = q->q_n > lhi ? q->q_n : lhi;
+         }
+      if (lhi < llo)
+         llo = lhi = 1;
+      lpos = (int *) oalloc((lhi - llo + 1) * sizeof(int));
+      for (i = 0; i < f->f_nquads; i++)
+         if (f->f_quads[i].q_op == Q_LABEL)
+            lpos[f->f_quads[i].q_n - llo] = i + 1;
+      for (q = f->f_quads; q < &f->f_quads[f->f_nquads]; q++)
+         if ((q->q_op == Q_BT || q->q_op == Q_BR) && (q->q_m < llo ||
+             q->q_m > lhi || lpos[q->q_m - llo] == 0)) {
+            free(lpos);
+            return (done);
+         }
+      qtemps(f, &lo, &hi);
+      uses = (int *) oalloc((hi - lo + 1) * sizeof(int));
+      def = (int *) oalloc((hi - lo + 1) * sizeof(int));
+      for (i = 0; i < f->f_nquads; i++) {
+         q = &f->f_quads[i];
+         if (q->q_z)
+            def[q->q_z - lo] = i + 1;
+         if (qusesx(q->q_op))
+            uses[q->q_x - lo]++;
+         if (qusesy(q->q_op) && q->q_y)
+            uses[q->q_y - lo]++;
+      }
+
+      /* thread, and drop branches to the next quad */
+      for (i = 0; i < f->f_nquads; i++) {
+         q = &f->f_quads[i];
+         if (q->q_op != Q_BT && q->q_op != Q_BR)
+            continue;
+         for (n = 0; n <= lhi - llo; n++) {
+            j = jnext(f, lpos[q->q_m - llo] - 1);
+            p = &f->f_quads[j];
+            if (j == f->f_nquads || p->q_op != Q_BR || p == q ||
+                p->q_m == q->q_m)
+               break;
+            q->q_m = p->q_m;
+            changed++;
+         }
+         if (jnext(f, i + 1) == jnext(f, lpos[q->q_m - llo] - 1)) {
+            if (q->q_op == Q_BT)
+               uses[q->q_x - lo]--;
+            q->q_op = Q_DEAD;
+            changed++;
+         }
+      }
+
+      /* bt tx L1; br L2; label L1 becomes bt ty L2 */
+      for (i = 0; i < f->f_nquads; i++) {
+         q = &f->f_quads[i];
+         if (q->q_op != Q_BT || uses[q->q_x - lo] != 1 ||
+             (j = def[q->q_x - lo]) == 0)
+            continue;
+         k = jnext(f, i + 1);
+         p = &f->f_quads[k];
+         if (k == f->f_nquads || p->q_op != Q_BR ||
+             jnext(f, k + 1) != jnext(f, lpos[q->q_m - llo] - 1) ||
+             (n = jinvert(f->f_quads[j - 1].q_op, f->f_quads[j - 1].q_t)) == 0)
+            continue;
+         for (n = i + 1; n < k; n++)
+            if (f->f_quads[n].q_op == Q_LABEL)
+               break;
+         if (n < k)
+            continue;
+         f->f_quads[j - 1].q_op = jinvert(f->f_quads[j - 1].q_op,
+                                          f->f_quads[j - 1].q_t);
+         q->q_m = p->q_m;
+         p->q_op = Q_DEAD;
+         changed++;
+      }
+
+      /* delete what is not reached, and labels not branched to */
+      seen = oalloc(f->f_nquads + 1);
+      work = (int *) oalloc((f->f_nquads + 1) * sizeof(int));
+      nw = 0;
+      work[nw++] = 0;
+      for (i = 0; i < f->f_nquads; i++)
+         if (f->f_quads[i].q_op == Q_LABEL && f->f_quads[i].q_s)
+            work[nw++] = i;
+      while (nw > 0)
+         for (i = work[--nw]; i < f->f_nquads && !seen[i]; i++) {
+            seen[i] = 1;
+            q = &f->f_quads[i];
+            if (q->q_op == Q_BT || q->q_op == Q_BR)
+               work[nw++] = lpos[q->q_m - llo] - 1;
+            if (q->q_op == Q_BR || q->q_op == Q_GOTO || q->q_op == Q_RET)
+               break;
+         }
+      memset(lpos, 0, (lhi - llo + 1) * sizeof(int));
+      for (i = 0; i < f->f_nquads; i++) {
+         q = &f->f_quads[i];
+         if (seen[i] && (q->q_op == Q_BT || q->q_op == Q_BR))
+            lpos[q->q_m - llo] = 1;
+      }
+      for (i = 0; i < f->f_nquads; i++) {
+         q = &f->f_quads[i];
+         if (q->q_op == Q_DEAD || q->q_op == Q_FEND ||
+             (q->q_op == Q_LABEL && q->q_s))
+            continue;
+         if (!seen[i] || (q->q_op == Q_LABEL && !lpos[q->q_n - llo])) {
+            q->q_op = Q_DEAD;
+            changed++;
+         }
+      }
+      qcompact(f);
+      free(seen);
+      free(work);
+      free(lpos);
+      free(uses);
+      free(def);
+      done += changed;
+   } while (changed);
+   return (done);
+}
+
+/* optimization passes, in the order they run */
+static struct opass {
+   char *p_name;			/* name in the statistics */
+   int p_level;				/* lowest -O level running it */
+   int (*p_run)(struct qfunc *);	/* the pass */
+   long p_runs;				/* functions it has run over */
+   long p_quads;			/* quads it has been given */
+   long p_changed;			/* quads it has removed or moved */
+   long p_temps;			/* temporaries it has done away with */
+   clock_t p_time;			/* processor time it has used */
+} passes[] = {
+   {"jumps",	1,	jumps},
+   {"lvn",	1,	lvn},
+   {"fold",	1,	fold},
+   {"copyprop",	1,	copyprop},
+   {"ssa",	3,	ssa},
+   {"licm",	2,	licm},
+   {"ivsr",	2,	ivsr},
+   {"lvn",	2,	lvn},
+   {"jumps",	1,	jumps},
+   {"dce",	1,	dce},
+};
+
+/* guards the statistics in passes, shared by the compiling threads */
+static pthread_mutex_t plock = PTHREAD_MUTEX_INITIALIZER;
+
+/*
+ * ntemps - count the temporaries f assigns
+ */
+static int ntemps(struct qfunc *f)
+{
+   struct quad *q;
+   int n = 0;
+
+   for (q = f->f_quads; q < &f->f_quads[f->f_nquads]; q++)
+      if (q->q_z)
+         n++;
+   return (n);
+}
+
+/*
+ * optimize - run the passes selected by optlevel over f
+ */
+void optimize(struct qfunc *f)
+{
+   struct opass *p;
+   clock_t t;
+   int n = 0, nq, changed, temps = 0;
+
+   if (ostat)
+      n = ntemps(f);
+   for (p = passes; p < &passes[sizeof(passes) / sizeof(passes[0])]; p++)
+      if (optlevel >= p->p_level) {
+         t = clock();
+         nq = f->f_nquads;
+         changed = (*p->p_run)(f);
+         t = clock() - t;
+         if (ostat) {
+            temps = n;
+            temps -= n = ntemps(f);
+         }
+         pthread_mutex_lock(&plock);
+         p->p_runs++;
+         p->p_quads += nq;
+         p->p_changed += changed;
+         p->p_time += t;
+         p->p_temps += temps;
+         pthread_mutex_unlock(&plock);
+      }
+}
+
+/*
+ * ostats - print the statistics of the passes run on fp
+ */
+void ostats(FILE *fp)
+{
+   struct opass *p;
+
+   fprintf(fp, "%-10s %8s %10s %10s %10s %8s\n", "pass", "funcs", "quads",
+           "changed", "temps", "msec");
+   for (p = passes; p < &passes[sizeof(passes) / sizeof(passes[0])]; p++)
+      if (p->p_runs)
+         fprintf(fp, "%-10s %8ld %10ld %10ld %10ld %8.1f\n", p->p_name,
+                 p->p_runs, p->p_quads, p->p_changed, p->p_temps,
+                 1000.0 * p->p_time / CLOCKS_PER_SEC);
+}
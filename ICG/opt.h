@@ -0,0 +1,23 @@
+/* value of a temporary known at compile time */
+struct kval {
+   int k_t;				/* 0 if unknown, else 'i' or 'f' */
+   int k_i;				/* int value */
+   double k_d;				/* double value */
+};
+
+extern int optlevel;
+extern int ostat;
+
+char *oalloc(unsigned);
+int lvn(struct qfunc *);
+int fold(struct qfunc *);
+int copyprop(struct qfunc *);
+int dce(struct qfunc *);
+int jumps(struct qfunc *);
+int jinvert(int, int);
+int licm(struct qfunc *);
+int ivsr(struct qfunc *);
+int ssa(struct qfunc *);
+int kfold(struct quad *, struct kval *, struct kval *, struct kval *);
+void optimize(struct qfunc *);
+void ostats(FILE *);
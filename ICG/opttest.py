@@ -0,0 +1,156 @@
+"""
+Checks what the optimizer and the ways of running csem may not change.
+The programs of testcases and opttests, run by qrun.py, must behave at
+-O1, -O2 and -O3 as they do at -O0.  Those programs and a large one from
+genprog.py must come out byte for byte the same with -t, with a cache of
+-C, cold and warm, and written with -b and read back by qbdump, as they
+do written as text on one thread.  Laid out by a profile taken with
+-profile, the programs of opttests must behave the same and come out the
+same with -t, and those in COLD, which have arms that never run, must be
+laid out differently.  Those in HOT, with more calls to expand than the
+budget of -O3 takes, must make fewer calls at -O3 once the profile
+chooses them.  The program of opttests/two, in two files
+compiled on two threads with -profile, must print the counts of both.
+"""
+import argparse
+import os
+import shutil
+import subprocess
+import sys
+import tempfile
+
+import genprog
+import qrun
+
+LEVELS = ['-O1', '-O2', '-O3']
+COLD = ['opttests/o5_cold.c']
+HOT = ['opttests/o6_hot.c']
+
+failed = 0
+
+
+def csem(args, src, csem='./csem'):
+    """The quads csem writes for file src with args, as text."""
+    with open(src) as fin:
+        p = subprocess.run([csem] + args, stdin=fin, stdout=subprocess.PIPE,
+                           stderr=subprocess.PIPE)
+    if p.returncode != 0:
+        raise Exception('csem %s < %s failed: %s' % (
+            ' '.join(args), src, p.stderr.decode()))
+    return p.stdout
+
+
+def check(name, ok):
+    """Report check name, counting it if it failed."""
+    global failed
+    print('%-4s %s' % ('ok' if ok else 'FAIL', name))
+    if not ok:
+        failed += 1
+
+
+def calls(text):
+    """The calls the quads text makes to its own functions running main."""
+    m = qrun.Machine(text)
+    m.call('main', [])
+    return m.frames
+
+
+def behavior(src):
+    """Run src at each -O level against -O0."""
+    want = qrun.run(csem([], src).decode())
+    for o in LEVELS:
+        check('%s %s runs as -O0' % (src, o),
+              qrun.run(csem([o], src).decode()) == want)
+
+
+def identity(src, tmp):
+    """Compile src on threads, through the cache and in binary, against
+    the text written on one thread."""
+    qb = os.path.join(tmp, 'out.qb')
+    for o in [[]] + [[l] for l in LEVELS]:
+        want = csem(o, src)
+        flags = ' '.join(o) or '-O0'
+        check('%s %s -t4 as serial' % (src, flags), csem(o + ['-t4'], src) == want)
+        cache = os.path.join(tmp, 'cache')
+        shutil.rmtree(cache, ignore_errors=True)
+        for run in ('cold', 'warm'):
+            check('%s %s -C %s as serial' % (src, flags, run),
+                  csem(o + ['-C' + cache], src) == want)
+        with open(qb, 'wb') as fp:
+            fp.write(csem(o + ['-b'], src))
+        p = subprocess.run(['./qbdump', qb], stdout=subprocess.PIPE)
+        check('%s %s -b read by qbdump as text' % (src, flags),
+              p.returncode == 0 and p.stdout == want)
+
+
+def layout(src, tmp):
+    """Lay out src by the profile of a run of it, at each -O level."""
+    want = qrun.run(csem([], src).decode())
+    prof = os.path.join(tmp, 'prof')
+    for o in ['-O0'] + LEVELS:
+        runs = qrun.run(csem([o, '-profile'], src).decode())
+        with open(prof, 'w') as fp:
+            fp.write(''.join(l for l in runs.splitlines(True)
+                             if l.startswith(('#prof ', '#stmt '))))
+        laid = csem([o, '-P' + prof], src)
+        check('%s %s -P runs as -O0' % (src, o),
+              qrun.run(laid.decode()) == want)
+        check('%s %s -P -t4 as serial' % (src, o),
+              csem([o, '-P' + prof, '-t4'], src) == laid)
+        if src in COLD:
+            check('%s %s -P moves the blocks never run' % (src, o),
+                  laid != csem([o], src))
+        if src in HOT and o == '-O3':
+            check('%s %s -P expands the calls run most' % (src, o),
+                  calls(laid.decode()) < calls(csem([o], src).decode()))
+
+
+def profiled(d, tmp):
+    """Run the files of directory d, compiled together with -profile on
+    two threads, and check each function printed its counts."""
+    srcs = sources(d)
+    for src in srcs:
+        shutil.copy(src, tmp)
+    files = [os.path.join(tmp, os.path.basename(src)) for src in srcs]
+    p = subprocess.run(['./csem', '-profile', '-j2'] + files,
+                       stderr=subprocess.PIPE)
+    if p.returncode != 0:
+        raise Exception('csem -profile -j2 %s failed: %s' % (
+            ' '.join(srcs), p.stderr.decode()))
+    text = ''
+    for f in files:
+        with open(f[:-2] + '.q') as fp:
+            text += fp.read()
+    runs = qrun.run(text)
+    for name in qrun.parse(text)[1]:
+        if not name.startswith('_pd_'):
+            check('%s -profile -j2 counts %s' % (d, name),
+                  '#prof %s 0 ' % name in runs)
+
+
+def sources(d):
+    """The C files in directory d."""
+    return [os.path.join(d, f) for f in sorted(os.listdir(d))
+            if f.endswith('.c')]
+
+
+if __name__ == '__main__':
+    parser = argparse.ArgumentParser()
+    parser.add_argument('--functions', '-n', type=int, default=200,
+                        help="size of the large program, in functions")
+    args = parser.parse_args()
+
+    tmp = tempfile.mkdtemp(prefix='csemtest')
+    big = os.path.join(tmp, 'big.c')
+    with open(big, 'w') as fp:
+        fp.write(genprog.generate(args.functions))
+    for src in sources('testcases') + sources('opttests'):
+        behavior(src)
+        identity(src, tmp)
+    for src in sources('opttests'):
+        layout(src, tmp)
+    profiled('opttests/two', tmp)
+    identity(big, tmp)
+    shutil.rmtree(tmp)
+    print('%d failed' % failed)
+    sys.exit(1 if failed else 0)
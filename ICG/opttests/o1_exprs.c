@@ -0,0 +1,54 @@
+int g, h;
+double d;
+
+exprs(int a, int b) {
+	int x, y, z;
+	x = 2 + 3 * 4;
+	y = x - 14;
+	z = a * b + a * b;
+	g = z + y;
+	h = (a + 1) * (b + 1) - (a + 1) * (b + 1);
+	x = x / 2 % 5 | 8 ^ 3 & 6;
+	y = -a + ~b;
+	z = x << 3 >> 1;
+	printf("exprs %d %d %d %d %d\n", x, y, z, g, h);
+	return x + y + z;
+}
+
+conds(int a, int b) {
+	int n;
+	n = 0;
+	if (a < b && b < 10)
+		n += 1;
+	if (a == 3 || b != 4)
+		n += 2;
+	if (!a > b)
+		n += 4;
+	if (a <= b && !b >= 7 || a == b)
+		n += 8;
+	if (1 < 2)
+		n += 16;
+	if (2 < 1)
+		n += 32;
+	return n;
+}
+
+double mixed(int i, double x) {
+	double y;
+	y = x * 2 + i;
+	if (y > x && x != 0)
+		y = y - x / 2;
+	d = y / 4;
+	return y * y;
+}
+
+main() {
+	int i;
+	for (i = 0; i < 6; i += 1)
+		printf("conds %d %d\n", i, conds(i, 6 - i));
+	printf("%d\n", exprs(3, 4));
+	printf("%d\n", exprs(-7, 2));
+	printf("%f %f\n", mixed(3, d + 5 / 2), d);
+	printf("%f %f\n", mixed(0, 0), d);
+	return g + h;
+}
@@ -0,0 +1,53 @@
+int a[20], b[20];
+double m[10], d;
+
+fill(int n, int k) {
+	int i, j, s;
+	s = 0;
+	for (i = 0; i < n; i += 1) {
+		a[i] = i * k + n * k;
+		b[i] = a[i] - k * 3;
+	}
+	for (i = 0; i < n; i += 1)
+		for (j = 0; j < i; j += 1)
+			s = s + a[j] * b[i - j] + n * k;
+	return s;
+}
+
+loops(int n) {
+	int i, s;
+	s = 0;
+	i = 0;
+	while (i < n) {
+		i += 1;
+		if (i % 3 == 0)
+			continue;
+		if (s > 100)
+			break;
+		s = s + i * 2;
+	}
+	i = 0;
+	do {
+		s = s - 1;
+		i += 2;
+	} while (i < n);
+	return s;
+}
+
+double scale(double x, int n) {
+	int i;
+	double t;
+	t = 0;
+	for (i = 0; i < 10; i += 1)
+		m[i] = i * x;
+	for (i = n; i > 0; i -= 1)
+		t = t + m[i % 10] * x;
+	return t;
+}
+
+main() {
+	printf("%d %d\n", fill(10, 3), fill(20, -2));
+	printf("%d %d %d\n", loops(5), loops(40), loops(0));
+	printf("%f\n", scale(d + 3, 25));
+	return a[7] + b[9];
+}
@@ -0,0 +1,44 @@
+int g;
+
+sq(int x) {
+	return x * x;
+}
+
+double half(double x) {
+	return x / 2;
+}
+
+clamp(int x, int lo, int hi) {
+	if (x < lo)
+		return lo;
+	if (x > hi)
+		return hi;
+	return x;
+}
+
+count(int x) {
+	g = g + x;
+	return g;
+}
+
+fact(int n) {
+	if (n <= 1)
+		return 1;
+	return n * fact(n - 1);
+}
+
+sum(int n) {
+	int i, s;
+	s = 0;
+	for (i = 0; i < n; i += 1)
+		s = s + sq(i) + clamp(i * 7 - 20, 0, 30) + count(1);
+	return s;
+}
+
+main() {
+	double x;
+	x = half(7) + half(sq(3));
+	printf("%d %d %f\n", sum(10), fact(6), x);
+	printf("%d %d %d\n", clamp(-5, 0, 9), clamp(50, 0, 9), clamp(4, 0, 9));
+	return g;
+}
@@ -0,0 +1,44 @@
+int t[8];
+
+flow(int k) {
+	int i, j, n, r;
+	n = 4;
+	r = 0;
+	j = n * 2;
+	if (n == 4)
+		r = j + 1;
+	else
+		r = j - 1;
+	for (i = 0; i < 8; i += 1) {
+		if (k > 0 && i == n)
+			break;
+		t[i] = r + i;
+		r = r + t[i] % 5;
+	}
+	if (i == 8)
+		r = r + 100;
+	if (k < 0)
+		return r;
+	return r + k;
+	r = 7;
+}
+
+pick(int a, int b, int c) {
+	int x;
+	x = 0;
+	if (a)
+		x = b;
+	else if (b)
+		x = c;
+	else
+		x = a + c;
+	while (x > 10 && !c == 0)
+		x = x - 3;
+	return x;
+}
+
+main() {
+	printf("%d %d %d\n", flow(1), flow(0), flow(-1));
+	printf("%d %d %d\n", pick(1, 20, 2), pick(0, 5, 30), pick(0, 0, 9));
+	return t[3];
+}
@@ -0,0 +1,39 @@
+int errs, v[16];
+
+check(int i, int n) {
+	if (i < 0) {
+		errs = errs + 1;
+		printf("bad index %d\n", i);
+		return 0;
+	}
+	if (i >= n) {
+		errs = errs + 2;
+		printf("index %d past %d\n", i, n);
+		return n - 1;
+	}
+	return i;
+}
+
+total(int n) {
+	int i, s;
+	s = 0;
+	for (i = 0; i < n; i += 1) {
+		if (v[check(i, 16)] > 1000)
+			s = s - v[i];
+		else
+			s = s + v[check(i, 16)];
+		if (s > 100000) {
+			printf("overflow at %d\n", i);
+			s = 0;
+		}
+	}
+	return s;
+}
+
+main() {
+	int i;
+	for (i = 0; i < 16; i += 1)
+		v[i] = i * i;
+	printf("%d %d\n", total(16), errs);
+	return errs;
+}
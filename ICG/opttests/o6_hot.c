@@ -0,0 +1,32 @@
+int bad, v[32];
+
+mix(int x) {
+	int h;
+	h = x * 31 + 7;
+	h = h ^ (h >> 3);
+	return h % 1009;
+}
+
+sum(int n) {
+	int i, s;
+	s = 0;
+	if (n < 0) {
+		bad = mix(n) + mix(n + 1) + mix(n + 2) + mix(n + 3);
+		bad = bad + mix(n + 4) + mix(n + 5) + mix(n + 6);
+		bad = bad + mix(n + 7) + mix(n + 8) + mix(n + 9);
+		bad = bad + mix(n + 10) + mix(n + 11) + mix(n + 12);
+		bad = bad + mix(n + 13) + mix(n + 14) + mix(n + 15);
+		return bad;
+	}
+	for (i = 0; i < n; i += 1)
+		s = s + mix(v[i]) - mix(i);
+	return s;
+}
+
+main() {
+	int i;
+	for (i = 0; i < 32; i += 1)
+		v[i] = i * 3 + 1;
+	printf("%d\n", sum(32));
+	return 0;
+}
@@ -0,0 +1,9 @@
+main() {
+	int i;
+	int s;
+	s = 0;
+	for (i = 0; i < 4; i = i + 1)
+		s = s + sq(i);
+	printf("%d\n", s);
+	return 0;
+}
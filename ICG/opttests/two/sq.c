@@ -0,0 +1,6 @@
+sq(int x) {
+	int i;
+	for (i = 0; i < 3; i = i + 1)
+		x = x + 1;
+	return x;
+}
@@ -0,0 +1,259 @@
+/* threads optimizing the functions of a file while the rest is parsed */
+
+# include <stdio.h>
+# include <stdlib.h>
+# include <pthread.h>
+# include "cc.h"
+# include "quad.h"
+# include "opt.h"
+# include "cfg.h"
+# include "sym.h"
+# include "pool.h"
+# include "cache.h"
+# include "prof.h"
+# include "inline.h"
+# include "stats.h"
+# include "qbin.h"
+
+extern void yyerror(const char *);
+extern UNIT int ntmp, numlabels;
+
+/* quads handed on to be written */
+struct job {
+   struct qfunc j_f;			/* the quads */
+   int j_base;				/* j_f.f_ntemp when handed on */
+   int j_lbase;				/* j_f.f_nlabel when handed on */
+   int j_done;				/* nonzero once ready to write */
+   struct strtab *j_strs;		/* strings of the file */
+   struct job *j_next;			/* next of the file, in order */
+   struct job *j_work;			/* next waiting for a worker */
+};
+
+int pthreads = 0;			/* worker threads, none to work inline */
+
+/* the queue of work and the j_done flags, shared by all threads */
+static pthread_mutex_t plock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t pwork = PTHREAD_COND_INITIALIZER; /* work queued */
+static pthread_cond_t pdone = PTHREAD_COND_INITIALIZER; /* a job done */
+static struct job *whead = NULL;	/* oldest job waiting for a worker */
+static struct job *wtail = NULL;	/* newest */
+
+/* jobs of the file this thread is compiling */
+static UNIT struct job *jhead = NULL;	/* oldest not yet written */
+static UNIT struct job *jtail = NULL;	/* newest */
+static UNIT struct job *jfree = NULL;	/* written, kept for reuse */
+static UNIT int toff = 0;		/* temporaries made by the optimizer
+					   in the jobs written */
+static UNIT int loff = 0;		/* labels made by it, likewise */
+
+/*
+ * pfinish - point the branches of function f at their labels, optimize
+ *           it, and print its graph if asked; with a cache, take f from
+ *           it if there, and put it there if not.  Then count its blocks,
+ *           or lay them out by a profile, as asked.
+ */
+static void pfinish(struct qfunc *f)
+{
+   struct ckey k;
+   struct cfg g;
+   struct prstmt *s = NULL;
+   int nblocks = 0, ns = 0, ph;
+
+   ph = tenter(PH_OPT);
+   if (cachedir == NULL || !cfetch(f, &k)) {
+      if (!qbpatch)
+         qresolve(f);
+      optimize(f);
+      if (cachedir)
+         cstore(f, &k);
+   }
+   if (profgen)
+      nblocks = prinstrument(f, &s, &ns);
+   if (proffile)
+      prlayout(f);
+   if (cfgdump) {
+      cfgbuild(&g, f);
+      cfgloops(&g);
+      cfgprint(stderr, &g);
+      cfgfree(&g);
+   }
+   if (nblocks)
+      prdumper(f, nblocks, s, ns);
+   tenter(ph);
+}
+
+/*
+ * worker - finish the functions queued, forever
+ */
+static void *worker(void *arg)
+{
+   struct job *j;
+
+   for (;;) {
+      pthread_mutex_lock(&plock);
+      while ((j = whead) == NULL)
+         pthread_cond_wait(&pwork, &plock);
+      if ((whead = j->j_work) == NULL)
+         wtail = NULL;
+      pthread_mutex_unlock(&plock);
+
+      suse(j->j_strs);
+      pfinish(&j->j_f);
+      tflush();
+
+      pthread_mutex_lock(&plock);
+      j->j_done = 1;
+      pthread_cond_broadcast(&pdone);
+      pthread_mutex_unlock(&plock);
+   }
+   return (NULL);
+}
+
+/*
+ * pstart - start the worker threads
+ */
+void pstart()
+{
+   pthread_t tid;
+   int i;
+
+   if (pthreads > 0)
+      sshared = 1;
+   for (i = 0; i < pthreads; i++)
+      if (pthread_create(&tid, NULL, worker, NULL) != 0) {
+         fprintf(stderr, "csem: cannot start a thread\n");
+         exit(1);
+      }
+}
+
+/*
+ * pwrite - write out job j, its temporaries and labels renumbered as if
+ *          the functions before it had been optimized inline
+ */
+static void pwrite(struct job *j)
+{
+   int ph;
+
+   ph = tenter(PH_WRITE);
+   if (toff)
+      qshift(&j->j_f, toff);
+   if (loff)
+      qlshift(&j->j_f, loff);
+   if (sstat)
+      tfunc(&j->j_f);
+   qwrite(qout ? qout : stdout, &j->j_f);
+   toff += j->j_f.f_ntemp - j->j_base;
+   loff += j->j_f.f_nlabel - j->j_lbase;
+   tenter(ph);
+}
+
+/*
+ * pdrain - write out the jobs of this file that are done, in order; with
+ *          wait, wait for them all
+ */
+static void pdrain(int wait)
+{
+   struct job *j;
+
+   for (;;) {
+      pthread_mutex_lock(&plock);
+      if (wait)
+         while (jhead && !jhead->j_done)
+            pthread_cond_wait(&pdone, &plock);
+      if ((j = jhead) == NULL || !j->j_done) {
+         pthread_mutex_unlock(&plock);
+         return;
+      }
+      if ((jhead = j->j_next) == NULL)
+         jtail = NULL;
+      pthread_mutex_unlock(&plock);
+
+      pwrite(j);
+      j->j_f.f_nquads = 0;
+      j->j_next = jfree;
+      jfree = j;
+   }
+}
+
+/*
+ * pflush - pass the pending quads on to be written, finishing them first
+ *          if they are a function (fn)
+ *
+ * With no workers this is done at once.  Otherwise a function goes to the
+ * next free worker, and qcur takes over the quads of a job written
+ * earlier, so nothing is allocated once enough jobs are about.  A temporary
+ * the optimizer makes is numbered as if from ntmp, and moved by pwrite;
+ * a label likewise from numlabels.
+ */
+void pflush(int fn)
+{
+   struct job *j;
+   struct qfunc f;
+   int ph;
+
+   if (fn && optlevel >= 3) {
+      ph = tenter(PH_OPT);
+      iexpand(&qcur);
+      ilearn(&qcur);
+      tenter(ph);
+   }
+   qcur.f_ntemp = ntmp;
+   qcur.f_nlabel = numlabels;
+   if (pthreads == 0) {
+      if (fn) {
+         pfinish(&qcur);
+         ntmp = qcur.f_ntemp;
+         numlabels = qcur.f_nlabel;
+      }
+      ph = tenter(PH_WRITE);
+      if (sstat)
+         tfunc(&qcur);
+      qflush();
+      tenter(ph);
+      return;
+   }
+
+   if ((j = jfree) != NULL)
+      jfree = j->j_next;
+   else
+      j = (struct job *) alloc(sizeof(struct job));
+   f = j->j_f;
+   j->j_f = qcur;
+   qcur = f;
+   j->j_base = ntmp;
+   j->j_lbase = numlabels;
+   j->j_done = !fn;
+   j->j_strs = scurrent();
+   j->j_next = NULL;
+   j->j_work = NULL;
+
+   pthread_mutex_lock(&plock);
+   if (jtail)
+      jtail->j_next = j;
+   else
+      jhead = j;
+   jtail = j;
+   if (fn) {
+      if (wtail)
+         wtail->j_work = j;
+      else
+         whead = j;
+      wtail = j;
+      pthread_cond_signal(&pwork);
+   }
+   pthread_mutex_unlock(&plock);
+   pdrain(0);
+}
+
+/*
+ * pwait - write out everything of this file still pending
+ */
+void pwait()
+{
+   pflush(0);
+   pdrain(1);
+   if (qbinary)
+      qbfinish(qout ? qout : stdout);
+   iclear();
+   toff = loff = 0;
+}
@@ -0,0 +1,5 @@
+extern int pthreads;
+
+void pstart();
+void pflush(int);
+void pwait();
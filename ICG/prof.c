@@ -0,0 +1,511 @@
+/* block counts: functions instrumented to take them, laid out by them,
+   and calls expanded by them */
+
+# include <stdio.h>
+# include <stdlib.h>
+# include <string.h>
+# include "cc.h"
+# include "quad.h"
+# include "cfg.h"
+# include "opt.h"
+# include "sym.h"
+# include "prof.h"
+
+extern void yyerror(const char *);
+
+/*
+ * With -profile, each basic block of a function f adds one to its own word
+ * of a global array _p_f as it starts.  A function _pd_f made along with f
+ * prints the words as lines
+ *
+ *    #prof f block count
+ *
+ * and, for each statement of f, from its bgnstmt, the word of the block
+ * it starts in as
+ *
+ *    #stmt f line count
+ *
+ * The first time f is entered it sets one more word of _p_f, after those
+ * of the blocks, and hands _pd_f to atexit, so the counts of every
+ * function run, in whatever file, come out at the end of a run among what
+ * the program printed itself.
+ *
+ * That output is a profile, read back with -Pfile: other lines are passed
+ * over, and the counts of runs put together are added.  Blocks are
+ * numbered as cfgbuild finds them in the optimized function, so the block
+ * counts hold for the same source compiled at the same -O level; a
+ * function whose count of blocks has changed since is not laid out.  The
+ * counts of a line, those of its statements added, hold whatever the
+ * level and whatever calls were expanded, and iexpand takes the count of
+ * the line of each call to choose the calls it expands.
+ */
+
+# define PRHASH 1024		/* chains of the profile */
+
+/* counts of a function in the profile */
+struct prfunc {
+   char *p_name;			/* the function */
+   long *p_counts;			/* runs of each block */
+   int p_nblocks;			/* blocks counted */
+   int *p_lines;			/* lines of statements counted */
+   long *p_lcounts;			/* runs of the statements of each */
+   int p_nlines;			/* lines counted */
+   int p_maxlines;			/* room in p_lines and p_lcounts */
+   struct prfunc *p_link;		/* next on the chain */
+};
+
+int profgen = 0;			/* -profile: count the blocks run */
+char *proffile = NULL;			/* -P profile, NULL if none */
+
+static struct prfunc *prtab[PRHASH];	/* read once, before any thread */
+
+/*
+ * prfind - the counts of function name, entered if new and enter is set
+ */
+static struct prfunc *prfind(char *name, int enter)
+{
+   struct prfunc *p;
+   unsigned h = 0;
+   char *s;
+
+   for (s = name; *s; s++)
+      h = 31 * h + (unsigned char) *s;
+   for (p = prtab[h % PRHASH]; p; p = p->p_link)
+      if (strcmp(p->p_name, name) == 0)
+         return (p);
+   if (!enter)
+      return (NULL);
+   p = (struct prfunc *) alloc(sizeof(struct prfunc));
+   p->p_name = strcpy(alloc(strlen(name) + 1), name);
+   p->p_link = prtab[h % PRHASH];
+   prtab[h % PRHASH] = p;
+   return (p);
+}
+
+/*
+ * prlineadd - add c to the count of the statements on line l of p
+ */
+static void prlineadd(struct prfunc *p, int l, long c)
+{
+   int i;
+
+   for (i = 0; i < p->p_nlines; i++)
+      if (p->p_lines[i] == l) {
+         p->p_lcounts[i] += c;
+         return;
+      }
+   if (p->p_nlines >= p->p_maxlines) {
+      p->p_maxlines = p->p_maxlines ? 2 * p->p_maxlines : 16;
+      p->p_lines = (int *) realloc(p->p_lines, p->p_maxlines * sizeof(int));
+      p->p_lcounts = (long *) realloc(p->p_lcounts,
+                                      p->p_maxlines * sizeof(long));
+      if (p->p_lines == NULL || p->p_lcounts == NULL) {
+         yyerror("csem: out of space");
+         exit (1);
+      }
+   }
+   p->p_lines[p->p_nlines] = l;
+   p->p_lcounts[p->p_nlines++] = c;
+}
+
+/*
+ * prload - read the profile in file
+ */
+void prload(char *file)
+{
+   struct prfunc *p;
+   FILE *fp;
+   char line[512], name[256];
+   long c;
+   int b;
+
+   if ((fp = fopen(file, "r")) == NULL) {
+      fprintf(stderr, "csem: cannot open %s\n", file);
+      exit(1);
+   }
+   while (fgets(line, sizeof(line), fp) != NULL) {
+      if (sscanf(line, "#stmt %255s %d %ld", name, &b, &c) == 3) {
+         prlineadd(prfind(name, 1), b, c);
+         continue;
+      }
+      if (sscanf(line, "#prof %255s %d %ld", name, &b, &c) != 3 || b < 0)
+         continue;
+      p = prfind(name, 1);
+      if (b >= p->p_nblocks) {
+         p->p_counts = (long *) realloc(p->p_counts, (b + 1) * sizeof(long));
+         if (p->p_counts == NULL) {
+            yyerror("csem: out of space");
+            exit (1);
+         }
+         memset(&p->p_counts[p->p_nblocks], 0,
+                (b + 1 - p->p_nblocks) * sizeof(long));
+         p->p_nblocks = b + 1;
+      }
+      p->p_counts[b] += c;
+   }
+   fclose(fp);
+}
+
+/*
+ * prline - times the statements on line l of function name ran in the
+ *          profile, -1 if it has no counts of lines
+ */
+long prline(char *name, int l)
+{
+   struct prfunc *p;
+   int i;
+
+   if ((p = prfind(name, 0)) == NULL || p->p_nlines == 0)
+      return (-1);
+   for (i = 0; i < p->p_nlines; i++)
+      if (p->p_lines[i] == l)
+         return (p->p_lcounts[i]);
+   return (0);
+}
+
+/*
+ * prname - interned name of the function or array for f: prefix then f
+ */
+static char *prname(char *prefix, char *f)
+{
+   char buf[256];
+
+   snprintf(buf, sizeof(buf), "%s%s", prefix, f);
+   return (snlookup(buf, strlen(buf)));
+}
+
+/*
+ * prnum - interned spelling of n
+ */
+static char *prnum(int n)
+{
+   char buf[16];
+
+   sprintf(buf, "%d", n);
+   return (snlookup(buf, strlen(buf)));
+}
+
+/*
+ * qput - append a quad with opcode op, type suffix t and result z to f
+ */
+static struct quad *qput(struct qfunc *f, int op, int t, int z)
+{
+   struct quad *q;
+
+   q = qinsert(f, f->f_nquads, 1);
+   q->q_op = op;
+   q->q_t = t;
+   q->q_z = z;
+   return (q);
+}
+
+/*
+ * prword - append to f quads leaving a temporary with the address of the
+ *          counter of block b in array, return it
+ */
+static int prword(struct qfunc *f, char *array, int b)
+{
+   struct quad *q;
+   int a, k;
+
+   qput(f, Q_GLOBAL, 0, a = qnewtemp(f))->q_s = array;
+   qput(f, Q_CON, 0, k = qnewtemp(f))->q_s = prnum(b);
+   q = qput(f, Q_INDEX, 'i', qnewtemp(f));
+   q->q_x = a;
+   q->q_y = k;
+   return (q->q_z);
+}
+
+/*
+ * prbump - append to f quads adding one to word b of array, or setting
+ *          it to one if old is zero
+ */
+static void prbump(struct qfunc *f, char *array, int b, int old)
+{
+   struct quad *q;
+   int e, v, k, s;
+
+   e = prword(f, array, b);
+   qput(f, Q_CON, 0, k = qnewtemp(f))->q_s = prnum(1);
+   s = k;
+   if (old) {
+      q = qput(f, Q_DEREF, 'i', v = qnewtemp(f));
+      q->q_y = e;
+      q = qput(f, Q_ADD, 'i', s = qnewtemp(f));
+      q->q_x = v;
+      q->q_y = k;
+   }
+   q = qput(f, Q_ASSIGN, 'i', 0);
+   q->q_x = e;
+   q->q_y = s;
+}
+
+/*
+ * prexit - append to f quads handing dump to atexit, unless word b of
+ *          array says it was done, and then setting it
+ */
+static void prexit(struct qfunc *f, char *array, int b, char *dump)
+{
+   struct quad *q;
+   int e, v, g, l;
+
+   e = prword(f, array, b);
+   q = qput(f, Q_DEREF, 'i', v = qnewtemp(f));
+   q->q_y = e;
+   q = qput(f, Q_BT, 0, 0);
+   q->q_x = v;
+   q->q_m = l = qnewlabel(f);
+   prbump(f, array, b, 0);
+   qput(f, Q_GLOBAL, 0, g = qnewtemp(f))->q_s = dump;
+   qput(f, Q_ARG, 'i', 0)->q_y = g;
+   qput(f, Q_GLOBAL, 0, g = qnewtemp(f))->q_s = slookup("atexit");
+   q = qput(f, Q_CALL, 'i', qnewtemp(f));
+   q->q_x = g;
+   q->q_n = 1;
+   qput(f, Q_LABEL, 0, 0)->q_n = l;
+}
+
+/*
+ * prinstrument - count the runs of each block of f, and have the counts
+ *                dumped at exit; return the number of blocks, and set *sp
+ *                and *ns to its statements and their number
+ */
+int prinstrument(struct qfunc *f, struct prstmt **sp, int *ns)
+{
+   struct qfunc nf;
+   struct cfg g;
+   struct quad *q;
+   struct prstmt *s;
+   char *array;
+   int b, i, k, first;
+
+   *sp = NULL;
+   *ns = 0;
+   if (f->f_nquads == 0 || f->f_quads[0].q_op != Q_FUNC)
+      return (0);
+   array = prname("_p_", f->f_quads[0].q_s);
+   cfgbuild(&g, f);
+   s = (struct prstmt *) oalloc(f->f_nquads * sizeof(struct prstmt));
+   for (b = 0; b < g.c_nblocks; b++)
+      for (first = *ns, i = g.c_blocks[b].b_first; i < g.c_blocks[b].b_last;
+           i++) {
+         if (f->f_quads[i].q_op != Q_BGNSTMT)
+            continue;
+         for (k = first; k < *ns && s[k].s_line != f->f_quads[i].q_n; k++)
+            ;
+         if (k == *ns) {
+            s[k].s_line = f->f_quads[i].q_n;
+            s[k].s_block = b;
+            (*ns)++;
+         }
+      }
+   *sp = s;
+   memset(&nf, 0, sizeof(nf));
+   nf.f_ntemp = f->f_ntemp;
+   nf.f_nlabel = f->f_nlabel;
+   for (b = 0; b < g.c_nblocks; b++) {
+      /* the count goes after the label, or the heading of the function */
+      for (i = g.c_blocks[b].b_first; i < g.c_blocks[b].b_last; i++) {
+         q = &f->f_quads[i];
+         if (q->q_op != Q_LABEL && q->q_op != Q_FUNC &&
+             q->q_op != Q_FORMAL && q->q_op != Q_LOCALLOC)
+            break;
+         *qput(&nf, 0, 0, 0) = *q;
+      }
+      prbump(&nf, array, b, 1);
+      if (b == 0)
+         prexit(&nf, array, g.c_nblocks,
+                prname("_pd_", f->f_quads[0].q_s));
+      for (; i < g.c_blocks[b].b_last; i++)
+         *qput(&nf, 0, 0, 0) = f->f_quads[i];
+   }
+   b = g.c_nblocks;
+   cfgfree(&g);
+   free(f->f_quads);
+   *f = nf;
+   return (b);
+}
+
+/*
+ * prprint - append to f a call of printf with format fmt, n and word b
+ *           of array
+ */
+static void prprint(struct qfunc *f, char *fmt, int n, char *array, int b)
+{
+   struct quad *q;
+   int e, k, t, v;
+
+   qput(f, Q_STR, 0, t = qnewtemp(f))->q_s = fmt;
+   qput(f, Q_CON, 0, k = qnewtemp(f))->q_s = prnum(n);
+   e = prword(f, array, b);
+   q = qput(f, Q_DEREF, 'i', v = qnewtemp(f));
+   q->q_y = e;
+   qput(f, Q_ARG, 'i', 0)->q_y = t;
+   qput(f, Q_ARG, 'i', 0)->q_y = k;
+   qput(f, Q_ARG, 'i', 0)->q_y = v;
+   qput(f, Q_GLOBAL, 0, t = qnewtemp(f))->q_s = slookup("printf");
+   q = qput(f, Q_CALL, 'i', qnewtemp(f));
+   q->q_x = t;
+   q->q_n = 3;
+}
+
+/*
+ * prdumper - put before f, of nblocks blocks and ns statements s, its
+ *            array of counts, with the word saying _pd_f went to atexit,
+ *            and the function _pd_f printing them; free s
+ */
+void prdumper(struct qfunc *f, int nblocks, struct prstmt *s, int ns)
+{
+   struct qfunc nf;
+   struct quad *q;
+   char *name, *array, *fmt, *bfmt, *lfmt;
+   int b;
+
+   if (nblocks == 0) {
+      free(s);
+      return;
+   }
+   name = f->f_quads[0].q_s;
+   array = prname("_p_", name);
+   memset(&nf, 0, sizeof(nf));
+   nf.f_ntemp = f->f_ntemp;
+   nf.f_nlabel = f->f_nlabel;
+   q = qput(&nf, Q_ALLOC, 0, 0);
+   q->q_s = array;
+   q->q_n = 4 * (nblocks + 1);
+   qput(&nf, Q_FUNC, 0, 0)->q_s = prname("_pd_", name);
+   fmt = alloc(strlen(name) + 20);
+   sprintf(fmt, "\"#prof %s %%d %%d\\n\"", name);
+   bfmt = snlookup(fmt, strlen(fmt));
+   sprintf(fmt, "\"#stmt %s %%d %%d\\n\"", name);
+   lfmt = snlookup(fmt, strlen(fmt));
+   free(fmt);
+   for (b = 0; b < nblocks; b++)
+      prprint(&nf, bfmt, b, array, b);
+   for (b = 0; b < ns; b++)
+      prprint(&nf, lfmt, s[b].s_line, array, s[b].s_block);
+   free(s);
+   qput(&nf, Q_FEND, 0, 0);
+   for (q = f->f_quads; q < &f->f_quads[f->f_nquads]; q++)
+      *qput(&nf, 0, 0, 0) = *q;
+   free(f->f_quads);
+   *f = nf;
+}
+
+/*
+ * prcold - nonzero if block b of f, with counts p, never ran and may be
+ *          moved
+ */
+static int prcold(struct prfunc *p, int b)
+{
+   return (b > 0 && p->p_counts[b] == 0);
+}
+
+/*
+ * prflip - if quad i of f is bt tx Lm and tx a comparison in block b of
+ *          g read nowhere else, test the opposite and branch to label l
+ *          instead, and return nonzero
+ */
+static int prflip(struct qfunc *f, struct cfg *g, int b, int i, int l)
+{
+   struct quad *q = &f->f_quads[i], *d, *p;
+   int op;
+
+   if (q->q_op != Q_BT)
+      return (0);
+   for (d = q - 1; d >= &f->f_quads[g->c_blocks[b].b_first]; d--)
+      if (d->q_z == q->q_x)
+         break;
+   if (d < &f->f_quads[g->c_blocks[b].b_first] ||
+       (op = jinvert(d->q_op, d->q_t)) == 0)
+      return (0);
+   for (p = f->f_quads; p < &f->f_quads[f->f_nquads]; p++)
+      if (p != q && ((qusesx(p->q_op) && p->q_x == q->q_x) ||
+                     (qusesy(p->q_op) && p->q_y == q->q_x)))
+         return (0);
+   d->q_op = op;
+   q->q_m = l;
+   return (1);
+}
+
+/*
+ * prlayout - move the blocks of f that never ran in the profile after
+ *            the rest, so the code run is together
+ *
+ * A block falling into one no longer after it gets a branch there, and
+ * the one fallen into a label if it has none, as the arm of a bt falling
+ * into it does not.  Where the block ends in bt to the block now after
+ * it, on a comparison, the test is turned around instead, so the code
+ * run falls through.  The last block, ending the function, stays last.
+ */
+void prlayout(struct qfunc *f)
+{
+   struct prfunc *p;
+   struct qfunc nf;
+   struct cfg g;
+   struct quad *q;
+   int *order, *fix, *lab, b, i, k, n, moved = 0;
+
+   if (qbpatch || f->f_nquads == 0 || f->f_quads[0].q_op != Q_FUNC ||
+       (p = prfind(f->f_quads[0].q_s, 0)) == NULL || p->p_nblocks == 0 ||
+       p->p_counts[0] == 0)
+      return;
+   cfgbuild(&g, f);
+   n = g.c_nblocks;
+   if (p->p_nblocks != n) {
+      cfgfree(&g);
+      return;
+   }
+   order = (int *) oalloc(n * sizeof(int));
+   fix = (int *) oalloc(n * sizeof(int));
+   lab = (int *) oalloc(n * sizeof(int));
+   for (k = b = 0; b < n - 1; b++)
+      if (!prcold(p, b))
+         order[k++] = b;
+   for (b = 0; b < n - 1; b++)
+      if (prcold(p, b)) {
+         order[k++] = b;
+         moved++;
+      }
+   order[k] = n - 1;
+   if (moved == 0)
+      goto out;
+
+   for (i = 0; i < n; i++) {
+      b = order[i];
+      q = &f->f_quads[g.c_blocks[b].b_last - 1];
+      if (b + 1 == n || (i + 1 < n && order[i + 1] == b + 1) ||
+          q->q_op == Q_BR || q->q_op == Q_GOTO || q->q_op == Q_RET)
+         continue;
+      k = g.c_blocks[b + 1].b_first;
+      if (f->f_quads[k].q_op == Q_LABEL)
+         fix[b] = f->f_quads[k].q_n;
+      else
+         fix[b] = lab[b + 1] = qnewlabel(f);
+      k = g.c_blocks[order[i + 1]].b_first;
+      if (q->q_op == Q_BT && f->f_quads[k].q_op == Q_LABEL &&
+          f->f_quads[k].q_n == q->q_m &&
+          prflip(f, &g, b, g.c_blocks[b].b_last - 1, fix[b]))
+         fix[b] = 0;
+   }
+
+   memset(&nf, 0, sizeof(nf));
+   nf.f_ntemp = f->f_ntemp;
+   nf.f_nlabel = f->f_nlabel;
+   for (i = 0; i < n; i++) {
+      b = order[i];
+      if (lab[b])
+         qput(&nf, Q_LABEL, 0, 0)->q_n = lab[b];
+      for (k = g.c_blocks[b].b_first; k < g.c_blocks[b].b_last; k++)
+         *qput(&nf, 0, 0, 0) = f->f_quads[k];
+      if (fix[b])
+         qput(&nf, Q_BR, 0, 0)->q_m = fix[b];
+   }
+   free(f->f_quads);
+   *f = nf;
+out:
+   free(order);
+   free(fix);
+   free(lab);
+   cfgfree(&g);
+}
@@ -0,0 +1,14 @@
+/* a statement of a function counted, for its _pd_f */
+struct prstmt {
+   int s_line;			/* its line, from bgnstmt */
+   int s_block;			/* the block it starts in */
+};
+
+extern int profgen;
+extern char *proffile;
+
+void prload(char *);
+int prinstrument(struct qfunc *, struct prstmt **, int *);
+long prline(char *, int);
+void prlayout(struct qfunc *);
+void prdumper(struct qfunc *, int, struct prstmt *, int);
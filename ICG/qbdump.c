@@ -0,0 +1,66 @@
+/* qbdump - print binary quads from csem -b as text, by way of qbread.c */
+
+# include <stdio.h>
+# include <stdlib.h>
+# include <string.h>
+# include "cc.h"
+# include "quad.h"
+# include "qbread.h"
+
+/*
+ * yyerror - report error msg, for quad.c
+ */
+void yyerror(const char *msg)
+{
+   fprintf(stderr, "qbdump: %s\n", msg);
+}
+
+/*
+ * main - print the quads of the file named, or of stdin, in the textual
+ *        form csem writes without -b; with -f name only function name
+ */
+int main(int argc, char *argv[])
+{
+   struct qbfile *b;
+   struct qfunc f;
+   FILE *fp = stdin;
+   char *name = NULL;
+   int i = 1, n;
+
+   if (i + 1 < argc && strcmp(argv[i], "-f") == 0) {
+      name = argv[i + 1];
+      i += 2;
+   }
+   if (i < argc && (fp = fopen(argv[i], "rb")) == NULL) {
+      fprintf(stderr, "qbdump: cannot open %s\n", argv[i]);
+      exit(1);
+   }
+   if ((b = qbopen(fp)) == NULL) {
+      fprintf(stderr, "qbdump: not binary quads\n");
+      exit(1);
+   }
+   memset(&f, 0, sizeof(f));
+   if (name) {
+      if ((n = qbfind(b, name)) < 0 || !qbread(b, n, &f)) {
+         fprintf(stderr, "qbdump: no function %s\n", name);
+         exit(1);
+      }
+   }
+   else {
+      f.f_maxquads = 1024;
+      f.f_quads = (struct quad *) malloc(f.f_maxquads * sizeof(struct quad));
+      while (f.f_quads && (n = qbnext(b, &f.f_quads[f.f_nquads])) > 0)
+         if (++f.f_nquads == f.f_maxquads) {
+            f.f_maxquads *= 2;
+            f.f_quads = (struct quad *) realloc(f.f_quads,
+                                     f.f_maxquads * sizeof(struct quad));
+         }
+      if (f.f_quads == NULL || n < 0) {
+         fprintf(stderr, "qbdump: quads not whole\n");
+         exit(1);
+      }
+   }
+   qwrite(stdout, &f);
+   qbclose(b);
+   exit(0);
+}
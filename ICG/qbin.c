@@ -0,0 +1,224 @@
+/* writing the quads of a file in binary, see qbin.h */
+
+# include <stdio.h>
+# include <stdlib.h>
+# include <string.h>
+# include "cc.h"
+# include "quad.h"
+# include "qbin.h"
+
+int qbinary = 0;			/* -b: write the binary form */
+
+/* a function in the index */
+struct qbent {
+   int e_name;				/* number of its name */
+   unsigned long e_off;			/* offset of its func quad */
+   int e_nquads;			/* quads from func to fend */
+};
+
+/* state of the file this thread is writing */
+static UNIT unsigned char *bbuf = NULL;	/* bytes not yet written */
+static UNIT unsigned blen = 0;		/* bytes in bbuf */
+static UNIT unsigned bmax = 0;		/* room in bbuf */
+static UNIT unsigned long boff = 0;	/* bytes written before bbuf */
+static UNIT char **bstrs = NULL;	/* copies of the strings, by number */
+static UNIT int bnstrs = 0;		/* strings in bstrs */
+static UNIT int *bstab = NULL;		/* hash table of string number + 1 */
+static UNIT unsigned bsmask = 0;	/* size of bstab - 1 */
+static UNIT struct qbent *bents = NULL;	/* the functions written */
+static UNIT int bnents = 0;		/* functions in bents */
+static UNIT int bmaxents = 0;		/* room in bents */
+static UNIT int bcount = 0;		/* quads since the last func */
+
+/*
+ * broom - make room for n more bytes in bbuf
+ */
+static void broom(unsigned n)
+{
+   if (blen + n > bmax) {
+      while (blen + n > bmax)
+         bmax = bmax ? 2 * bmax : 65536;
+      if ((bbuf = realloc(bbuf, bmax)) == NULL) {
+         fprintf(stderr, "csem: out of space\n");
+         exit (1);
+      }
+   }
+}
+
+/*
+ * bnum - append unsigned varint n
+ */
+static void bnum(unsigned long n)
+{
+   broom(10);
+   while (n >= 0200) {
+      bbuf[blen++] = (n & 0177) | 0200;
+      n >>= 7;
+   }
+   bbuf[blen++] = n;
+}
+
+/*
+ * bzig - append signed n, zigzag encoded
+ */
+static void bzig(int n)
+{
+   bnum(((unsigned) n << 1) ^ (unsigned) (n >> 31));
+}
+
+/*
+ * bhash - hash of string s
+ */
+static unsigned bhash(char *s)
+{
+   unsigned h = 0;
+
+   while (*s)
+      h = h * 31 + (unsigned char) *s++;
+   return (h);
+}
+
+/*
+ * bstring - the number of string s, entered if new
+ */
+static int bstring(char *s)
+{
+   unsigned i;
+   int n;
+
+   if (2 * (bnstrs + 1) > bsmask) {
+      free(bstab);
+      bsmask = bsmask ? 2 * bsmask + 1 : 255;
+      bstab = (int *) calloc(bsmask + 1, sizeof(int));
+      bstrs = (char **) realloc(bstrs, (bsmask + 1) * sizeof(char *));
+      if (bstab == NULL || bstrs == NULL) {
+         fprintf(stderr, "csem: out of space\n");
+         exit (1);
+      }
+      for (n = 0; n < bnstrs; n++) {
+         for (i = bhash(bstrs[n]) & bsmask; bstab[i]; i = (i + 1) & bsmask)
+            ;
+         bstab[i] = n + 1;
+      }
+   }
+   for (i = bhash(s) & bsmask; bstab[i]; i = (i + 1) & bsmask)
+      if (strcmp(bstrs[bstab[i] - 1], s) == 0)
+         return (bstab[i] - 1);
+   if ((bstrs[bnstrs] = malloc(strlen(s) + 1)) == NULL) {
+      fprintf(stderr, "csem: out of space\n");
+      exit (1);
+   }
+   strcpy(bstrs[bnstrs], s);
+   bstab[i] = ++bnstrs;
+   return (bnstrs - 1);
+}
+
+/*
+ * bhead - append the magic number and version
+ */
+static void bhead()
+{
+   broom(sizeof(QBMAGIC));
+   memcpy(bbuf, QBMAGIC, sizeof(QBMAGIC) - 1);
+   bbuf[sizeof(QBMAGIC) - 1] = QBVERSION;
+   blen = sizeof(QBMAGIC);
+}
+
+/*
+ * qbwrite - write the quads of f to fp in binary, noting the functions
+ *           among them for the index
+ */
+void qbwrite(FILE *fp, struct qfunc *f)
+{
+   struct quad *q;
+   int mask;
+
+   if (boff == 0 && blen == 0)
+      bhead();
+   for (q = f->f_quads; q < &f->f_quads[f->f_nquads]; q++) {
+      if (q->q_op == Q_FUNC) {
+         if (bnents == bmaxents) {
+            bmaxents = bmaxents ? 2 * bmaxents : 64;
+            bents = (struct qbent *) realloc(bents,
+                                             bmaxents * sizeof(struct qbent));
+            if (bents == NULL) {
+               fprintf(stderr, "csem: out of space\n");
+               exit (1);
+            }
+         }
+         bents[bnents].e_name = bstring(q->q_s);
+         bents[bnents].e_off = boff + blen;
+         bents[bnents++].e_nquads = 0;
+         bcount = 0;
+      }
+      bcount++;
+      if (q->q_op == Q_FEND && bnents)
+         bents[bnents - 1].e_nquads = bcount;
+
+      mask = (q->q_t ? QB_T : 0) | (q->q_z ? QB_Z : 0) |
+             (q->q_x ? QB_X : 0) | (q->q_y ? QB_Y : 0) |
+             (q->q_n ? QB_N : 0) | (q->q_m ? QB_M : 0) | (q->q_s ? QB_S : 0);
+      bnum(q->q_op);
+      broom(1);
+      bbuf[blen++] = mask;
+      if (mask & QB_T)
+         bnum(q->q_t);
+      if (mask & QB_Z)
+         bnum(q->q_z);
+      if (mask & QB_X)
+         bnum(q->q_x);
+      if (mask & QB_Y)
+         bnum(q->q_y);
+      if (mask & QB_N)
+         bzig(q->q_n);
+      if (mask & QB_M)
+         bzig(q->q_m);
+      if (mask & QB_S)
+         bnum(bstring(q->q_s));
+   }
+   fwrite(bbuf, 1, blen, fp);
+   boff += blen;
+   blen = 0;
+}
+
+/*
+ * qbfinish - end the binary quads written to fp with the strings and the
+ *            index, and start over for the next file
+ */
+void qbfinish(FILE *fp)
+{
+   unsigned long tab;
+   int i, n;
+
+   if (boff == 0 && blen == 0)
+      bhead();
+   bnum(Q_NOPS);
+   tab = boff + blen;
+   bnum(bnstrs);
+   for (i = 0; i < bnstrs; i++) {
+      n = strlen(bstrs[i]);
+      bnum(n);
+      broom(n);
+      memcpy(bbuf + blen, bstrs[i], n);
+      blen += n;
+   }
+   bnum(bnents);
+   for (i = 0; i < bnents; i++) {
+      bnum(bents[i].e_name);
+      bnum(bents[i].e_off);
+      bnum(bents[i].e_nquads);
+   }
+   broom(8 + sizeof(QBMAGIC));
+   for (i = 0; i < 8; i++)
+      bbuf[blen++] = (tab >> 8 * i) & 0377;
+   memcpy(bbuf + blen, QBMAGIC, sizeof(QBMAGIC) - 1);
+   blen += sizeof(QBMAGIC) - 1;
+   fwrite(bbuf, 1, blen, fp);
+
+   boff = blen = 0;
+   for (i = 0; i < bnstrs; i++)
+      free(bstrs[i]);
+   bnstrs = bnents = 0;
+   if (bstab)
+      memset(bstab, 0, (bsmask + 1) * sizeof(int));
+}
@@ -0,0 +1,31 @@
+/*
+ * Binary form of the quads of a file, written with -b:
+ *
+ *    "CSQB" version
+ *    quad ...			up to a quad of opcode Q_NOPS
+ *    nstrings (len bytes) ...	the strings the quads name, by number
+ *    nfuncs (name offset nquads) ...	where each function starts
+ *    offset of nstrings, 8 bytes little-endian, then "CSQB"
+ *
+ * Numbers are unsigned varints, 7 bits to a byte, low first, the high
+ * bit set in all but the last byte.  A quad is its opcode, a byte of the
+ * QB_ bits below telling which fields are not zero, and those in the
+ * order of the bits: q_n and q_m zigzag encoded as they may be negative,
+ * q_s as the number of its string.  Offsets count from the start of the
+ * file, the first at 5.
+ */
+# define QBMAGIC "CSQB"
+# define QBVERSION 1
+
+# define QB_T 01		/* q_t */
+# define QB_Z 02		/* q_z */
+# define QB_X 04		/* q_x */
+# define QB_Y 010		/* q_y */
+# define QB_N 020		/* q_n */
+# define QB_M 040		/* q_m */
+# define QB_S 0100		/* q_s */
+
+extern int qbinary;
+
+void qbwrite(FILE *, struct qfunc *);
+void qbfinish(FILE *);
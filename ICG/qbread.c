@@ -0,0 +1,234 @@
+/* reader of the binary quads csem writes with -b, for back ends */
+
+# include <stdio.h>
+# include <stdlib.h>
+# include <string.h>
+# include "cc.h"
+# include "quad.h"
+# include "qbin.h"
+# include "qbread.h"
+
+/*
+ * A back end links this and quad.h's opcodes, and never sees the text:
+ *
+ *    b = qbopen(fp);
+ *    while (qbnext(b, &q) > 0)
+ *       ... q.q_op, q.q_z, q.q_s ...
+ *
+ * or reads the functions it wants, found by name with qbfind, with
+ * qbread.  The file is read in whole and checked as it is decoded; the
+ * strings of the quads point into it, and last until qbclose.
+ */
+
+/*
+ * qbnum - read the unsigned varint at *pos in b into *n and move *pos
+ *         past it, return zero if it runs past end
+ */
+static int qbnum(struct qbfile *b, unsigned long *pos, unsigned long end,
+                 unsigned long *n)
+{
+   int shift = 0;
+
+   *n = 0;
+   while (*pos < end && shift < 64) {
+      *n |= (unsigned long) (b->b_buf[*pos] & 0177) << shift;
+      if ((b->b_buf[(*pos)++] & 0200) == 0)
+         return (1);
+      shift += 7;
+   }
+   return (0);
+}
+
+/*
+ * qbint - read a varint that must be below lim into *n
+ */
+static int qbint(struct qbfile *b, unsigned long *pos, unsigned long end,
+                 unsigned long lim, int *n)
+{
+   unsigned long v;
+
+   if (!qbnum(b, pos, end, &v) || v >= lim)
+      return (0);
+   *n = (int) v;
+   return (1);
+}
+
+/*
+ * qbopen - read the binary quads on fp, return NULL if they are not
+ *          whole
+ */
+struct qbfile *qbopen(FILE *fp)
+{
+   struct qbfile *b;
+   unsigned long pos, max = 0, n, len, end;
+   unsigned char *p;
+   int i, k;
+
+   if ((b = (struct qbfile *) calloc(1, sizeof(struct qbfile))) == NULL)
+      return (NULL);
+   do {
+      if (max - b->b_len < 65536) {
+         max = max ? 2 * max : 262144;
+         if ((p = realloc(b->b_buf, max + 1)) == NULL) {
+            qbclose(b);
+            return (NULL);
+         }
+         b->b_buf = p;
+      }
+      n = fread(b->b_buf + b->b_len, 1, max - b->b_len, fp);
+      b->b_len += n;
+   } while (n > 0);
+
+   len = sizeof(QBMAGIC) - 1;
+   if (b->b_len < 2 * len + 9 ||
+       memcmp(b->b_buf, QBMAGIC, len) != 0 || b->b_buf[len] != QBVERSION ||
+       memcmp(b->b_buf + b->b_len - len, QBMAGIC, len) != 0) {
+      qbclose(b);
+      return (NULL);
+   }
+   end = b->b_len - len - 8;
+   for (pos = 0, i = 7; i >= 0; i--)
+      pos = pos << 8 | b->b_buf[end + i];
+   b->b_end = pos;
+   b->b_pos = len + 1;
+
+   if (pos > end || !qbint(b, &pos, end, end, &b->b_nstrs) ||
+       (b->b_strs = (char **) calloc(b->b_nstrs + 1, sizeof(char *))) ==
+       NULL) {
+      qbclose(b);
+      return (NULL);
+   }
+   /* each string is moved down over its length, and ended */
+   for (i = 0; i < b->b_nstrs; i++) {
+      if (!qbnum(b, &pos, end, &n) || n > end - pos) {
+         qbclose(b);
+         return (NULL);
+      }
+      b->b_strs[i] = memmove(b->b_buf + pos - 1, b->b_buf + pos, n);
+      b->b_strs[i][n] = '\0';
+      pos += n;
+   }
+   if (!qbint(b, &pos, end, end, &b->b_nfuncs) ||
+       (b->b_funcs = (struct qbfunc *) calloc(b->b_nfuncs + 1,
+                                              sizeof(struct qbfunc))) == NULL) {
+      qbclose(b);
+      return (NULL);
+   }
+   for (i = 0; i < b->b_nfuncs; i++)
+      if (!qbint(b, &pos, end, b->b_nstrs, &k) ||
+          !qbnum(b, &pos, end, &b->b_funcs[i].bf_off) ||
+          b->b_funcs[i].bf_off >= b->b_end ||
+          !qbint(b, &pos, end, 0x7fffffff, &b->b_funcs[i].bf_nquads)) {
+         qbclose(b);
+         return (NULL);
+      }
+      else
+         b->b_funcs[i].bf_name = b->b_strs[k];
+   return (b);
+}
+
+/*
+ * qbfind - the number of the function named name, -1 if there is none
+ */
+int qbfind(struct qbfile *b, char *name)
+{
+   int i;
+
+   for (i = 0; i < b->b_nfuncs; i++)
+      if (strcmp(b->b_funcs[i].bf_name, name) == 0)
+         return (i);
+   return (-1);
+}
+
+/*
+ * qbseek - make function i the next qbnext reads, or with -1 the start
+ */
+void qbseek(struct qbfile *b, int i)
+{
+   if (i < 0 || i >= b->b_nfuncs)
+      b->b_pos = sizeof(QBMAGIC);
+   else
+      b->b_pos = b->b_funcs[i].bf_off;
+}
+
+/*
+ * qbnext - read the next quad into *q, return 1, or 0 at the end and -1
+ *          if the quad is not whole
+ */
+int qbnext(struct qbfile *b, struct quad *q)
+{
+   unsigned long v, end = b->b_end;
+   int mask;
+
+   memset(q, 0, sizeof(struct quad));
+   if (!qbint(b, &b->b_pos, end, Q_NOPS + 1, &q->q_op))
+      return (-1);
+   if (q->q_op == Q_NOPS) {
+      b->b_pos--;
+      return (0);
+   }
+   if (b->b_pos >= end)
+      return (-1);
+   mask = b->b_buf[b->b_pos++];
+   if ((mask & QB_T && !qbint(b, &b->b_pos, end, 256, &q->q_t)) ||
+       (mask & QB_Z && !qbint(b, &b->b_pos, end, 0x80000000UL, &q->q_z)) ||
+       (mask & QB_X && !qbint(b, &b->b_pos, end, 0x80000000UL, &q->q_x)) ||
+       (mask & QB_Y && !qbint(b, &b->b_pos, end, 0x80000000UL, &q->q_y)))
+      return (-1);
+   if (mask & QB_N) {
+      if (!qbnum(b, &b->b_pos, end, &v) || v > 0xffffffffUL)
+         return (-1);
+      q->q_n = (int) (v >> 1) ^ -(int) (v & 1);
+   }
+   if (mask & QB_M) {
+      if (!qbnum(b, &b->b_pos, end, &v) || v > 0xffffffffUL)
+         return (-1);
+      q->q_m = (int) (v >> 1) ^ -(int) (v & 1);
+   }
+   if (mask & QB_S) {
+      if (!qbnum(b, &b->b_pos, end, &v) || v >= (unsigned long) b->b_nstrs)
+         return (-1);
+      q->q_s = b->b_strs[v];
+   }
+   return (1);
+}
+
+/*
+ * qbread - append the quads of function i to f, return nonzero if they
+ *          were whole
+ */
+int qbread(struct qbfile *b, int i, struct qfunc *f)
+{
+   struct quad *q;
+   int n;
+
+   if (i < 0 || i >= b->b_nfuncs)
+      return (0);
+   n = b->b_funcs[i].bf_nquads;
+   if (f->f_nquads + n > f->f_maxquads) {
+      f->f_maxquads = f->f_nquads + n;
+      q = (struct quad *) realloc(f->f_quads,
+                                  f->f_maxquads * sizeof(struct quad));
+      if (q == NULL)
+         return (0);
+      f->f_quads = q;
+   }
+   qbseek(b, i);
+   while (n-- > 0)
+      if (qbnext(b, &f->f_quads[f->f_nquads++]) <= 0) {
+         f->f_nquads--;
+         return (0);
+      }
+   return (1);
+}
+
+/*
+ * qbclose - free b, and the strings of the quads read from it
+ */
+void qbclose(struct qbfile *b)
+{
+   free(b->b_buf);
+   free(b->b_strs);
+   free(b->b_funcs);
+   free(b);
+}
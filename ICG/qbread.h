@@ -0,0 +1,27 @@
+/* reading the binary quads csem writes with -b, see qbin.h */
+
+/* a function of a binary quad file */
+struct qbfunc {
+   char *bf_name;		/* its name */
+   unsigned long bf_off;	/* offset of its func quad */
+   int bf_nquads;		/* quads from func to fend */
+};
+
+/* a binary quad file, read in whole */
+struct qbfile {
+   unsigned char *b_buf;	/* its bytes */
+   unsigned long b_len;		/* bytes in b_buf */
+   unsigned long b_end;		/* offset of the string table */
+   unsigned long b_pos;		/* offset of the quad qbnext reads next */
+   char **b_strs;		/* its strings, by number */
+   int b_nstrs;			/* strings in b_strs */
+   struct qbfunc *b_funcs;	/* its functions, in order */
+   int b_nfuncs;		/* functions in b_funcs */
+};
+
+struct qbfile *qbopen(FILE *);
+int qbfind(struct qbfile *, char *);
+void qbseek(struct qbfile *, int);
+int qbnext(struct qbfile *, struct quad *);
+int qbread(struct qbfile *, int, struct qfunc *);
+void qbclose(struct qbfile *);
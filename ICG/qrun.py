@@ -0,0 +1,216 @@
+"""
+Runs the quads csem writes, in the text form, resolved or with -B, so the
+output of one -O level can be checked against another.  Runs main if the
+program has one, else each function in turn with zero arguments, and
+prints what printf printed, what each function run returned and the
+final values of the globals.  Calls to functions the program does not
+define, other than printf and atexit, print their arguments and return 0.
+"""
+import re
+import sys
+
+STEPS = 5000000
+
+
+def i32(v):
+    """v as a 32-bit int."""
+    v = int(v) & 0xffffffff
+    return v - (1 << 32) if v & 0x80000000 else v
+
+
+class Func:
+    def __init__(self, name):
+        self.name = name
+        self.code = []
+        self.labels = {}
+        self.formals = []
+        self.bpatch = {}
+
+
+def parse(text):
+    """The functions of the quads text by name, their names in order, and
+    the globals allocated."""
+    funcs, order, globs = {}, [], {}
+    cur = None
+    for line in text.splitlines():
+        line = line.strip()
+        if not line:
+            continue
+        w = line.split()
+        m = re.match(r'B(\d+)=L(\d+)$', line)
+        if w[0] == 'alloc':
+            globs[w[1]] = int(w[2])
+        elif w[0] == 'func':
+            cur = Func(w[1])
+            funcs[w[1]] = cur
+            order.append(w[1])
+        elif w[0] == 'fend':
+            cur.code.append(None)
+            cur = None
+        elif w[0] == 'formal':
+            cur.formals.append(int(w[1]))
+        elif m:
+            cur.bpatch['B' + m.group(1)] = 'L' + m.group(2)
+        elif w[0] == 'label':
+            cur.labels[w[1]] = len(cur.code)
+        elif w[0] not in ('localloc', 'bgnstmt'):
+            cur.code.append((line, w))
+    return funcs, order, globs
+
+
+class Machine:
+    def __init__(self, text):
+        self.funcs, self.order, self.globs = parse(text)
+        self.mem = {}
+        self.out = []
+        self.steps = 0
+        self.exits = []
+        self.frames = 0
+
+    def extern(self, name, args):
+        """Call name, which the program does not define."""
+        if name == 'printf':
+            fmt = bytes(args[0][1:-1], 'utf-8').decode('unicode_escape')
+            self.out.append(fmt % tuple(args[1:]))
+        elif name == 'atexit':
+            self.exits.append(args[0][1])
+        else:
+            self.out.append('%s%r\n' % (name, tuple(args)))
+        return 0
+
+    def call(self, name, args):
+        """Run function name on args, return what it returns."""
+        if name not in self.funcs:
+            return self.extern(name, args)
+        f = self.funcs[name]
+        self.frames += 1
+        frame = self.frames
+        for k, a in enumerate(args):
+            self.mem[('p', frame, k)] = a
+        t, pend, pc = {}, [], 0
+
+        def label(l):
+            return f.labels[f.bpatch.get(l, l)]
+
+        while True:
+            self.steps += 1
+            if self.steps > STEPS:
+                raise Exception('more than %d steps' % STEPS)
+            if f.code[pc] is None:
+                return 0
+            line, w = f.code[pc]
+            pc += 1
+            if w[0] == 'br':
+                pc = label(w[1])
+            elif w[0] == 'bt':
+                if t[w[1]] != 0:
+                    pc = label(w[2])
+            elif w[0] in ('argi', 'argf'):
+                pend.append(t[w[1]])
+            elif w[0] in ('reti', 'retf'):
+                if len(w) == 1:
+                    return 0 if w[0] == 'reti' else 0.0
+                v = t[w[1]]
+                if w[0] == 'retf':
+                    return float(v)
+                return v if isinstance(v, (str, tuple)) else i32(v)
+            elif w[1] in ('=i', '=f'):
+                self.mem[t[w[0]]] = t[w[2]]
+            else:
+                t[w[0]] = self.value(line, w[2:], t, pend, frame)
+
+    def value(self, line, r, t, pend, frame):
+        """The value of the right side r of quad line."""
+        if r[0].startswith('"'):
+            return line.split(':= ', 1)[1]
+        if len(r) == 1:
+            return float(r[0]) if '.' in r[0] or 'e' in r[0] else int(r[0])
+        if r[0] == 'global':
+            return ('g', r[1], 0)
+        if r[0] in ('local', 'param'):
+            return (r[0][0], frame, int(r[1]))
+        if r[0] in ('fi', 'ff'):
+            n = int(r[2])
+            args = pend[len(pend) - n:] if n else []
+            del pend[len(pend) - n:]
+            v = self.call(t[r[1]][1], args)
+            if r[0] == 'ff':
+                return float(v)
+            return int(v) if isinstance(v, float) else i32(v)
+        if len(r) == 2:
+            op, y = r[0][:-1], t[r[1]]
+            typ = r[0][-1]
+            if op == '@':
+                return self.mem.get(y, 0.0 if typ == 'f' else 0)
+            if op == 'cv':
+                return float(y) if typ == 'f' else i32(int(y))
+            if op == '-':
+                return -y if typ == 'f' else i32(-y)
+            if op == '~':
+                return i32(~y)
+            raise Exception('cannot run ' + line)
+        x, op, y = t[r[0]], r[1][:-1], t[r[2]]
+        typ = r[1][-1]
+        if op == '=':
+            self.mem[x] = y
+            return y
+        if op == '[]':
+            return (x[0], x[1], x[2] + y * (8 if typ == 'f' else 4))
+        if isinstance(x, tuple) and op in ('+', '-'):
+            return (x[0], x[1], x[2] + (y if op == '+' else -y))
+        if isinstance(y, tuple) and op == '+':
+            return (y[0], y[1], y[2] + x)
+        if typ == 'f':
+            x, y = float(x), float(y)
+        if op in ('==', '!=', '<', '<=', '>', '>='):
+            return int({'==': x == y, '!=': x != y, '<': x < y,
+                        '<=': x <= y, '>': x > y, '>=': x >= y}[op])
+        if op == '+':
+            v = x + y
+        elif op == '-':
+            v = x - y
+        elif op == '*':
+            v = x * y
+        elif op == '/':
+            if typ == 'f':
+                v = x / y if y else float('inf')
+            else:
+                v = int(x / y) if y else 0
+        elif op == '%':
+            v = (abs(x) % abs(y)) * (1 if x >= 0 else -1) if y else 0
+        elif op == '|':
+            v = x | y
+        elif op == '^':
+            v = x ^ y
+        elif op == '&':
+            v = x & y
+        elif op == '<<':
+            v = x << (y & 31)
+        elif op == '>>':
+            v = x >> (y & 31)
+        else:
+            raise Exception('cannot run ' + line)
+        return v if typ == 'f' else i32(v)
+
+
+def run(text):
+    """What running the quads text prints."""
+    m = Machine(text)
+    names = ['main'] if 'main' in m.funcs else m.order
+    for name in names:
+        f = m.funcs[name]
+        try:
+            r = m.call(name, [0.0 if n == 8 else 0 for n in f.formals])
+        except Exception as e:
+            r = 'error: %s' % e
+        m.out.append('%s -> %r\n' % (name, r))
+    while m.exits:
+        m.call(m.exits.pop(), [])
+    m.out.append('globals %r\n' % sorted(
+        (k[1], k[2], v) for k, v in m.mem.items() if k[0] == 'g'))
+    return ''.join(m.out)
+
+
+if __name__ == '__main__':
+    with open(sys.argv[1]) if len(sys.argv) > 1 else sys.stdin as fp:
+        sys.stdout.write(run(fp.read()))
@@ -0,0 +1,420 @@
+/* in-memory intermediate code */
+
+# include <stdio.h>
+# include <stdlib.h>
+# include <string.h>
+# include "cc.h"
+# include "quad.h"
+# include "qbin.h"
+
+extern void yyerror(const char *);
+
+/*
+ * Opcodes, by number.  An opcode reads a temporary in q_x for O_X and in
+ * q_y for O_Y, so its arity is the count of the two; one with O_INT or
+ * O_FLT carries the variant in q_t and prints it after the mnemonic.
+ */
+# define O_BIN (O_X | O_Y | O_Z | O_INT | O_FLT | O_PURE)
+# define O_UN  (O_Y | O_Z | O_INT | O_FLT | O_PURE)
+
+struct qop qops[Q_NOPS] = {
+   {"alloc", 0},
+   {"func", 0},
+   {"fend", 0},
+   {"formal", 0},
+   {"localloc", 0},
+   {"bgnstmt", 0},
+   {"label", 0},
+   {"bt", O_X},
+   {"br", 0},
+   {"br", 0},
+   {"", 0},
+   {"", O_Z | O_PURE},
+   {"", O_Z | O_PURE},
+   {"global", O_Z | O_PURE},
+   {"local", O_Z | O_PURE},
+   {"param", O_Z | O_PURE},
+   {"arg", O_Y | O_INT | O_FLT},
+   {"ret", O_Y | O_INT | O_FLT},
+   {"f", O_X | O_Z | O_INT | O_FLT},
+   {"cv", O_UN},
+   {"@", O_UN & ~O_PURE},
+   {"-", O_UN},
+   {"~", O_UN},
+   {"=", O_BIN & ~O_PURE},
+   {"[]", O_BIN},
+   {"+", O_BIN | O_COMM},
+   {"-", O_BIN},
+   {"*", O_BIN | O_COMM},
+   {"/", O_BIN | O_TRAP},
+   {"%", (O_BIN & ~O_FLT) | O_TRAP},
+   {"|", (O_BIN & ~O_FLT) | O_COMM},
+   {"^", (O_BIN & ~O_FLT) | O_COMM},
+   {"&", (O_BIN & ~O_FLT) | O_COMM},
+   {"<<", O_BIN & ~O_FLT},
+   {">>", O_BIN & ~O_FLT},
+   {"==", O_BIN | O_COMM},
+   {"!=", O_BIN | O_COMM},
+   {"<", O_BIN},
+   {"<=", O_BIN},
+   {">", O_BIN},
+   {">=", O_BIN},
+   {"", 0},
+};
+
+UNIT struct qfunc qcur;			/* quads not yet written */
+UNIT FILE *qout;			/* where they go, stdout if NULL */
+int qbpatch = 0;			/* leave backpatches to the reader */
+
+static UNIT char *obuf = NULL;		/* serialized output */
+static UNIT unsigned olen = 0;		/* bytes in obuf */
+static UNIT unsigned omax = 0;		/* room in obuf */
+
+/*
+ * qgen - append a quad with opcode op and result z, return it to be filled
+ */
+struct quad *qgen(int op, int z)
+{
+   struct qfunc *f = &qcur;
+   struct quad *q;
+
+   if (f->f_nquads >= f->f_maxquads) {
+      f->f_maxquads = f->f_maxquads ? 2 * f->f_maxquads : 1024;
+      f->f_quads = (struct quad *) realloc(f->f_quads,
+                                           f->f_maxquads * sizeof(struct quad));
+      if (f->f_quads == NULL) {
+         yyerror("csem: out of space");
+         exit (1);
+      }
+   }
+   q = &f->f_quads[f->f_nquads++];
+   memset(q, 0, sizeof(struct quad));
+   q->q_op = op;
+   q->q_z = z;
+   return (q);
+}
+
+/*
+ * qflush - write out and discard the pending quads
+ */
+void qflush()
+{
+   qwrite(qout ? qout : stdout, &qcur);
+   qcur.f_nquads = 0;
+}
+
+/*
+ * qusesx - nonzero if quads with opcode op read temporary q_x
+ */
+int qusesx(int op)
+{
+   return (qops[op].o_flags & O_X);
+}
+
+/*
+ * qusesy - nonzero if quads with opcode op read temporary q_y
+ */
+int qusesy(int op)
+{
+   return (qops[op].o_flags & O_Y);
+}
+
+/*
+ * qtemps - find the lowest and highest temporary numbers used in f
+ */
+void qtemps(struct qfunc *f, int *lo, int *hi)
+{
+   struct quad *q;
+
+   *lo = 0x7fffffff;
+   *hi = 0;
+   for (q = f->f_quads; q < &f->f_quads[f->f_nquads]; q++) {
+      if (q->q_z) {
+         *lo = q->q_z < *lo ? q->q_z : *lo;
+         *hi = q->q_z > *hi ? q->q_z : *hi;
+      }
+      if (qusesx(q->q_op) && q->q_x < *lo)
+         *lo = q->q_x;
+      if (qusesy(q->q_op) && q->q_y && q->q_y < *lo)
+         *lo = q->q_y;
+   }
+   if (*hi == 0)
+      *lo = 1;
+}
+
+/*
+ * qcompact - squeeze the quads marked Q_DEAD out of f
+ */
+void qcompact(struct qfunc *f)
+{
+   struct quad *q, *p;
+
+   for (p = q = f->f_quads; q < &f->f_quads[f->f_nquads]; q++)
+      if (q->q_op != Q_DEAD)
+         *p++ = *q;
+   f->f_nquads = p - f->f_quads;
+}
+
+/*
+ * qnewtemp - return a temporary not yet used in f
+ */
+int qnewtemp(struct qfunc *f)
+{
+   return (++f->f_ntemp);
+}
+
+/*
+ * qnewlabel - return a label Ln not yet used in f, nor in the file
+ */
+int qnewlabel(struct qfunc *f)
+{
+   return (++f->f_nlabel);
+}
+
+/*
+ * qshift - add n to the number of every temporary in f
+ */
+void qshift(struct qfunc *f, int n)
+{
+   struct quad *q;
+
+   for (q = f->f_quads; q < &f->f_quads[f->f_nquads]; q++) {
+      if (q->q_z)
+         q->q_z += n;
+      if (qusesx(q->q_op))
+         q->q_x += n;
+      if (qusesy(q->q_op) && q->q_y)
+         q->q_y += n;
+   }
+}
+
+/*
+ * qlshift - add n to the number of every label Ln in f
+ */
+void qlshift(struct qfunc *f, int n)
+{
+   struct quad *q;
+
+   for (q = f->f_quads; q < &f->f_quads[f->f_nquads]; q++)
+      if (q->q_op == Q_LABEL)
+         q->q_n += n;
+      else if ((q->q_op == Q_BT || q->q_op == Q_BR || q->q_op == Q_BPATCH) &&
+               q->q_m)
+         q->q_m += n;
+}
+
+/*
+ * qinsert - open n zeroed quads in f before index at, return the first
+ */
+struct quad *qinsert(struct qfunc *f, int at, int n)
+{
+   if (f->f_nquads + n > f->f_maxquads) {
+      while (f->f_nquads + n > f->f_maxquads)
+         f->f_maxquads = f->f_maxquads ? 2 * f->f_maxquads : 1024;
+      f->f_quads = (struct quad *) realloc(f->f_quads,
+                                           f->f_maxquads * sizeof(struct quad));
+      if (f->f_quads == NULL) {
+         yyerror("csem: out of space");
+         exit (1);
+      }
+   }
+   memmove(&f->f_quads[at + n], &f->f_quads[at],
+           (f->f_nquads - at) * sizeof(struct quad));
+   memset(&f->f_quads[at], 0, n * sizeof(struct quad));
+   f->f_nquads += n;
+   return (&f->f_quads[at]);
+}
+
+/*
+ * qresolve - point the branches of f at their labels, drop unused labels
+ *
+ * The backpatch quads Bn=Lm of the function are folded into the branches
+ * that use Bn, which then carry Lm in q_m, and are deleted.  A label no
+ * branch targets is deleted as well, unless it was declared by the user.
+ */
+void qresolve(struct qfunc *f)
+{
+   struct quad *q, *p;
+   int *bmap, *lused, blo, bhi, llo, lhi;
+
+   blo = llo = 0x7fffffff;
+   bhi = lhi = 0;
+   for (q = f->f_quads; q < &f->f_quads[f->f_nquads]; q++)
+      if (q->q_op == Q_BT || q->q_op == Q_BR || q->q_op == Q_BPATCH) {
+         blo = q->q_n < blo ? q->q_n : blo;
+         bhi = q->q_n > bhi ? q->q_n : bhi;
+      }
+      else if (q->q_op == Q_LABEL) {
+         llo = q->q_n < llo ? q->q_n : llo;
+         lhi = q->q_n > lhi ? q->q_n : lhi;
+      }
+   if (bhi == 0)
+      return;
+   bmap = (int *) calloc(bhi - blo + 1, sizeof(int));
+   lused = (int *) calloc(lhi >= llo ? lhi - llo + 1 : 1, sizeof(int));
+   if (bmap == NULL || lused == NULL) {
+      yyerror("csem: out of space");
+      exit (1);
+   }
+
+   for (q = f->f_quads; q < &f->f_quads[f->f_nquads]; q++)
+      if (q->q_op == Q_BPATCH)
+         bmap[q->q_n - blo] = q->q_m;
+   for (q = f->f_quads; q < &f->f_quads[f->f_nquads]; q++)
+      if ((q->q_op == Q_BT || q->q_op == Q_BR) &&
+          (q->q_m = bmap[q->q_n - blo]) >= llo && q->q_m <= lhi)
+         lused[q->q_m - llo] = 1;
+
+   for (p = q = f->f_quads; q < &f->f_quads[f->f_nquads]; q++)
+      if (q->q_op == Q_BPATCH)
+         continue;
+      else if (q->q_op == Q_LABEL && q->q_s == NULL && !lused[q->q_n - llo])
+         continue;
+      else
+         *p++ = *q;
+   f->f_nquads = p - f->f_quads;
+   free(bmap);
+   free(lused);
+}
+
+/*
+ * oroom - make room for n more bytes of output
+ */
+static void oroom(unsigned n)
+{
+   if (olen + n > omax) {
+      while (olen + n > omax)
+         omax = omax ? 2 * omax : 65536;
+      if ((obuf = realloc(obuf, omax)) == NULL) {
+         yyerror("csem: out of space");
+         exit (1);
+      }
+   }
+}
+
+/*
+ * ostr - append string s to the output
+ */
+static void ostr(char *s)
+{
+   unsigned n = strlen(s);
+
+   oroom(n);
+   memcpy(obuf + olen, s, n);
+   olen += n;
+}
+
+/*
+ * onum - append decimal n to the output
+ */
+static void onum(int n)
+{
+   char d[12];
+   int i = sizeof(d);
+   unsigned u = n < 0 ? -(unsigned) n : n;
+
+   do
+      d[--i] = '0' + u % 10;
+   while ((u /= 10) != 0);
+   if (n < 0)
+      d[--i] = '-';
+   oroom(sizeof(d));
+   memcpy(obuf + olen, d + i, sizeof(d) - i);
+   olen += sizeof(d) - i;
+}
+
+/*
+ * otemp - append temporary name tn to the output
+ */
+static void otemp(int n)
+{
+   oroom(1);
+   obuf[olen++] = 't';
+   onum(n);
+}
+
+/*
+ * qwrite - write the quads of f to fp in the textual format, or with -b
+ *          in the binary one
+ */
+void qwrite(FILE *fp, struct qfunc *f)
+{
+   struct quad *q;
+   char t[2];
+
+   if (qbinary) {
+      qbwrite(fp, f);
+      return;
+   }
+   olen = 0;
+   t[1] = '\0';
+   for (q = f->f_quads; q < &f->f_quads[f->f_nquads]; q++) {
+      t[0] = q->q_t;
+      switch (q->q_op) {
+         case Q_ALLOC:
+            ostr("alloc "); ostr(q->q_s); ostr(" "); onum(q->q_n);
+            break;
+         case Q_FUNC:
+            ostr("func "); ostr(q->q_s);
+            break;
+         case Q_FEND:
+            ostr("fend");
+            break;
+         case Q_FORMAL: case Q_LOCALLOC: case Q_BGNSTMT:
+            ostr(qops[q->q_op].o_name); ostr(" "); onum(q->q_n);
+            break;
+         case Q_LABEL:
+            ostr("label L"); onum(q->q_n);
+            break;
+         case Q_BT: case Q_BR:
+            ostr(qops[q->q_op].o_name); ostr(" ");
+            if (q->q_op == Q_BT) {
+               otemp(q->q_x); ostr(" ");
+            }
+            if (q->q_m) {
+               ostr("L"); onum(q->q_m);
+            }
+            else {
+               ostr("B"); onum(q->q_n);
+            }
+            break;
+         case Q_GOTO:
+            ostr("br L"); ostr(q->q_s);
+            break;
+         case Q_BPATCH:
+            ostr("B"); onum(q->q_n); ostr("=L"); onum(q->q_m);
+            break;
+         case Q_CON: case Q_STR:
+            otemp(q->q_z); ostr(" := "); ostr(q->q_s);
+            break;
+         case Q_GLOBAL:
+            otemp(q->q_z); ostr(" := global "); ostr(q->q_s);
+            break;
+         case Q_LOCAL: case Q_PARAM:
+            otemp(q->q_z); ostr(" := "); ostr(qops[q->q_op].o_name); ostr(" ");
+            onum(q->q_n);
+            break;
+         case Q_ARG: case Q_RET:
+            ostr(qops[q->q_op].o_name); ostr(t);
+            if (q->q_y) {
+               ostr(" "); otemp(q->q_y);
+            }
+            break;
+         case Q_CALL:
+            otemp(q->q_z); ostr(" := f"); ostr(t); ostr(" "); otemp(q->q_x);
+            ostr(" "); onum(q->q_n);
+            break;
+         default:
+            if (q->q_z) {
+               otemp(q->q_z); ostr(" := ");
+            }
+            if (qusesx(q->q_op)) {
+               otemp(q->q_x); ostr(" ");
+            }
+            ostr(qops[q->q_op].o_name); ostr(t); ostr(" "); otemp(q->q_y);
+            break;
+      }
+      ostr("\n");
+   }
+   fwrite(obuf, 1, olen, fp);
+}
@@ -0,0 +1,101 @@
+/* quad opcodes *** keep in step with qops in quad.c *** */
+enum q_op {
+   Q_ALLOC,			/* alloc s n */
+   Q_FUNC,			/* func s */
+   Q_FEND,			/* fend */
+   Q_FORMAL,			/* formal n */
+   Q_LOCALLOC,			/* localloc n */
+   Q_BGNSTMT,			/* bgnstmt n */
+   Q_LABEL,			/* label Ln */
+   Q_BT,			/* bt tx Bn, or bt tx Lm once resolved */
+   Q_BR,			/* br Bn, or br Lm once resolved */
+   Q_GOTO,			/* br Ls */
+   Q_BPATCH,			/* Bn=Lm */
+   Q_CON,			/* tz := s (numeric literal) */
+   Q_STR,			/* tz := s (string literal) */
+   Q_GLOBAL,			/* tz := global s */
+   Q_LOCAL,			/* tz := local n */
+   Q_PARAM,			/* tz := param n */
+   Q_ARG,			/* argT ty */
+   Q_RET,			/* retT ty, or retT alone if y == 0 */
+   Q_CALL,			/* tz := fT tx n */
+   Q_CV,			/* tz := cvT ty */
+   Q_DEREF,			/* tz := @T ty */
+   Q_NEG,			/* tz := -T ty */
+   Q_COM,			/* tz := ~T ty */
+   Q_ASSIGN,			/* tz := tx =T ty, or tx =T ty if z == 0 */
+   Q_INDEX,			/* tz := tx []T ty */
+   Q_ADD,			/* tz := tx +T ty, and so on */
+   Q_SUB,
+   Q_MUL,
+   Q_DIV,
+   Q_MOD,
+   Q_OR,
+   Q_XOR,
+   Q_AND,
+   Q_LSH,
+   Q_RSH,
+   Q_EQ,
+   Q_NE,
+   Q_LT,
+   Q_LE,
+   Q_GT,
+   Q_GE,
+   Q_DEAD,			/* deleted, see qcompact */
+   Q_NOPS
+};
+
+/* what an opcode is, indexed by opcode in qops */
+struct qop {
+   char *o_name;		/* mnemonic */
+   int o_flags;			/* O_ bits below */
+};
+
+# define O_X     01		/* reads temporary q_x */
+# define O_Y     02		/* reads temporary q_y, when nonzero */
+# define O_Z     04		/* sets temporary q_z */
+# define O_INT   010		/* has an i variant */
+# define O_FLT   020		/* has an f variant */
+# define O_COMM  040		/* operands may be swapped */
+# define O_PURE  0100		/* value depends only on its operands */
+# define O_TRAP  0200		/* i variant may trap, so must not be moved */
+
+/* quadruple */
+struct quad {
+   int q_op;			/* opcode */
+   int q_t;			/* type suffix, 'i' or 'f' */
+   int q_z;			/* result temporary */
+   int q_x;			/* first operand temporary */
+   int q_y;			/* second operand temporary */
+   int q_n;			/* size, offset, line, label or count */
+   int q_m;			/* label a backpatch or branch resolves to */
+   char *q_s;			/* name or literal */
+};
+
+/* quads of one function, or of the declarations between functions */
+struct qfunc {
+   struct quad *f_quads;	/* the quads, in order */
+   int f_nquads;		/* quads in use */
+   int f_maxquads;		/* room in f_quads */
+   int f_ntemp;			/* last temporary given out in f */
+   int f_nlabel;		/* last label Ln given out in f */
+};
+
+extern struct qop qops[Q_NOPS];
+extern UNIT struct qfunc qcur;
+extern UNIT FILE *qout;
+extern int qbpatch;
+
+struct quad *qgen(int, int);
+void qflush();
+void qresolve(struct qfunc *);
+int qusesx(int);
+int qusesy(int);
+void qtemps(struct qfunc *, int *, int *);
+void qcompact(struct qfunc *);
+int qnewtemp(struct qfunc *);
+int qnewlabel(struct qfunc *);
+void qshift(struct qfunc *, int);
+void qlshift(struct qfunc *, int);
+struct quad *qinsert(struct qfunc *, int, int);
+void qwrite(FILE *, struct qfunc *);
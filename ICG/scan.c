@@ -1,159 +1,269 @@
 # include <stdio.h>
+# include <stdlib.h>
+# include <string.h>
 # include <ctype.h>
 # include "y.tab.h"
 # include "cc.h"
 # include "scan.h"
 # include "sym.h"
+# include "stats.h"
 
-# define MAXTOK 100	/* maximum token size */
+extern void yyerror(const char *);
 
-# define LETTER 'a'
-# define DIGIT '0'
+# define INBLK 65536	/* input is read in pieces this size */
 
-int lineno = 1;		/* current line number */
+/* character classes */
+# define C_ALPHA 01	/* letter, starts an identifier */
+# define C_DIGIT 02	/* digit */
+# define C_ID    04	/* letter, digit or _, continues an identifier */
+# define C_SPACE 010	/* white space */
+
+UNIT int lineno = 1;	/* current line number */
+
+static unsigned char cclass[256];	/* class bits of each character */
+static UNIT char *ibuf = NULL;		/* the whole input */
+static UNIT char *ip;			/* next character of ibuf */
+static UNIT char *iend;			/* end of ibuf, a nul is stored there */
+static UNIT char *tbuf = NULL;		/* token text that is not in ibuf */
+static UNIT unsigned tmax = 0;		/* room in tbuf */
+
+/*
+ * Reserved words and operators, found by a perfect hash of their length
+ * and first and last characters.  kwasso holds KWSIZE for a character
+ * that begins or ends none of them, which puts the hash out of range.
+ */
+# define KWSIZE 104	/* slots in kwtab */
+# define KWMAXLEN 8	/* longest entry, "continue" */
+
+static unsigned char kwasso[256] = {
+   104, 104, 104, 104, 104, 104, 104, 104, 104, 104, 104, 104, 104, 104, 104, 104,
+   104, 104, 104, 104, 104, 104, 104, 104, 104, 104, 104, 104, 104, 104, 104, 104,
+   104,   0, 104, 104, 104,  26,   6, 104, 104, 104,  25,  49, 104,   1, 104,  13,
+   104, 104, 104, 104, 104, 104, 104, 104, 104, 104, 104, 104,   4,  30,  44, 104,
+   104, 104, 104, 104, 104, 104, 104, 104, 104, 104, 104, 104, 104, 104, 104, 104,
+   104, 104, 104, 104, 104, 104, 104, 104, 104, 104, 104, 104, 104, 104,   9, 104,
+   104, 104,   8,  31,  51,  46,  30,  48, 104,  11, 104,  31, 104, 104,   9,   2,
+   104, 104,  32, 104,  45, 104, 104,   9, 104, 104, 104, 104,  24, 104,  37, 104,
+   104, 104, 104, 104, 104, 104, 104, 104, 104, 104, 104, 104, 104, 104, 104, 104,
+   104, 104, 104, 104, 104, 104, 104, 104, 104, 104, 104, 104, 104, 104, 104, 104,
+   104, 104, 104, 104, 104, 104, 104, 104, 104, 104, 104, 104, 104, 104, 104, 104,
+   104, 104, 104, 104, 104, 104, 104, 104, 104, 104, 104, 104, 104, 104, 104, 104,
+   104, 104, 104, 104, 104, 104, 104, 104, 104, 104, 104, 104, 104, 104, 104, 104,
+   104, 104, 104, 104, 104, 104, 104, 104, 104, 104, 104, 104, 104, 104, 104, 104,
+   104, 104, 104, 104, 104, 104, 104, 104, 104, 104, 104, 104, 104, 104, 104, 104,
+   104, 104, 104, 104, 104, 104, 104, 104, 104, 104, 104, 104, 104, 104, 104, 104,
+};
+
+static struct kw {
+   char *k_name;			/* spelling, empty if slot unused */
+   int k_type;				/* its token */
+} kwtab[KWSIZE] = {
+   {"", 0},
+   {"!", NOT},
+   {"", 0},
+   {"-", SUB},
+   {"", 0}, {"", 0}, {"", 0}, {"", 0}, {"", 0},
+   {"<", LT},
+   {"<<", LSH},
+   {"", 0}, {"", 0},
+   {"&", BITAND},
+   {"&&", AND},
+   {"", 0}, {"", 0}, {"", 0}, {"", 0},
+   {"^", BITXOR},
+   {"", 0}, {"", 0}, {"", 0}, {"", 0}, {"", 0}, {"", 0},
+   {"", 0},
+   {"/", DIV},
+   {"", 0}, {"", 0}, {"", 0}, {"", 0},
+   {"!=", NE},
+   {"-=", SETSUB},
+   {"", 0}, {"", 0},
+   {"<=", LE},
+   {"<<=", SETLSH},
+   {"&=", SETAND},
+   {"", 0}, {"", 0},
+   {"^=", SETXOR},
+   {"", 0},
+   {"if", IF},
+   {"break", BREAK},
+   {"/=", SETDIV},
+   {"", 0},
+   {"return", RETURN},
+   {"", 0},
+   {"|", BITOR},
+   {"||", OR},
+   {"*", MUL},
+   {"", 0},
+   {"%", MOD},
+   {"goto", GOTO},
+   {"do", DO},
+   {"|=", SETOR},
+   {"*=", SETMUL},
+   {"%=", SETMOD},
+   {"int", INT},
+   {"while", WHILE},
+   {"=", SET},
+   {"==", EQ},
+   {"", 0}, {"", 0},
+   {"for", FOR},
+   {"", 0},
+   {"char", CHAR},
+   {"", 0}, {"", 0}, {"", 0}, {"", 0}, {"", 0}, {"", 0},
+   {"", 0},
+   {"~", COM},
+   {">=", GE},
+   {">>=", SETRSH},
+   {"", 0}, {"", 0},
+   {"float", FLOAT},
+   {"+=", SETADD},
+   {"", 0}, {"", 0}, {"", 0},
+   {"continue", CONTINUE},
+   {"", 0}, {"", 0}, {"", 0},
+   {">", GT},
+   {">>", RSH},
+   {"", 0}, {"", 0}, {"", 0}, {"", 0}, {"", 0},
+   {"else", ELSE},
+   {"", 0}, {"", 0},
+   {"+", ADD},
+   {"", 0}, {"", 0}, {"", 0},
+   {"double", DOUBLE},
+};
 
 /* 
- * initlex - initialize lexical analyzer
+ * initlex - initialize lexical analyzer, once for all files
  */
 void initlex()
 {
-   initrw(SET, "=");
-   initrw(SETOR, "|=");
-   initrw(SETXOR, "^=");
-   initrw(SETAND, "&=");
-   initrw(SETLSH, "<<=");
-   initrw(SETRSH, ">>=");
-   initrw(SETADD, "+=");
-   initrw(SETSUB, "-=");
-   initrw(SETMUL, "*=");
-   initrw(SETDIV, "/=");
-   initrw(SETMOD, "%=");
-   initrw(OR, "||");
-   initrw(AND, "&&");
-   initrw(BITOR, "|");
-   initrw(BITXOR, "^");
-   initrw(BITAND, "&");
-   initrw(EQ, "==");
-   initrw(NE, "!=");
-   initrw(GT, ">");
-   initrw(GE, ">=");
-   initrw(LT, "<");
-   initrw(LE, "<=");
-   initrw(LSH, "<<");
-   initrw(RSH, ">>");
-   initrw(ADD, "+");
-   initrw(SUB, "-");
-   initrw(MUL, "*");
-   initrw(DIV, "/");
-   initrw(MOD, "%");
-   initrw(NOT, "!");
-   initrw(COM, "~");
-   initrw(IF, "if");
-   initrw(FOR, "for");
-   initrw(ELSE, "else");
-   initrw(WHILE, "while");
-   initrw(DO, "do");
-   initrw(RETURN, "return");
-   initrw(CONTINUE, "continue");
-   initrw(BREAK, "break");
-   initrw(GOTO, "goto");
-   initrw(CHAR, "char");
-   initrw(FLOAT, "float");
-   initrw(DOUBLE, "double");
-   initrw(INT, "int");
+   int c;
+
+   for (c = 0; c < 256; c++) {
+      if (isalpha(c))
+         cclass[c] |= C_ALPHA | C_ID;
+      if (isdigit(c))
+         cclass[c] |= C_DIGIT | C_ID;
+      if (isspace(c))
+         cclass[c] |= C_SPACE;
+   }
+   cclass['_'] |= C_ID;
 }
 
-/* 
- * initrw - initialize a reserved word entry
+/*
+ * kwlook - token of the reserved word or operator in the n characters at
+ *          s, 0 if they are not one
  */
-void initrw(int k, char *s)
+int kwlook(char *s, unsigned n)
 {
-   struct id_entry *p;
- 
-   p = install(slookup(s), 1);
-   p->i_type = k;
-   p->i_defined = 1;
+   struct kw *k;
+   unsigned h;
+
+   if (n > KWMAXLEN)
+      return (0);
+   h = n + kwasso[(unsigned char) s[0]] + kwasso[(unsigned char) s[n - 1]];
+   if (h >= KWSIZE)
+      return (0);
+   k = &kwtab[h];
+   if (strncmp(k->k_name, s, n) == 0 && k->k_name[n] == '\0')
+      return (k->k_type);
+   return (0);
 }
 
 /*
- * yylex - fetch next token
+ * readin - read all of fp into ibuf, the input of the next file
  */
-int yylex()
+void readin(FILE *fp)
 {
-   int c, i, type;
-   char lin[MAXTOK];
-   struct id_entry *p;
+   unsigned len = 0, max = 0, n;
+
+   do {
+      if (max - len < INBLK) {
+         max = max ? 2 * max : 4 * INBLK;
+         ibuf = realloc(ibuf, max + 1);
+         if (ibuf == NULL) {
+            yyerror("csem: out of space");
+            exit (1);
+         }
+      }
+      n = fread(ibuf + len, 1, max - len, fp);
+      len += n;
+   } while (n > 0);
+   ip = ibuf;
+   iend = ibuf + len;
+   *iend = '\0';
+   lineno = 1;
+}
+
+/*
+ * lex - fetch next token, its value in *lval
+ *
+ * The text of a token is interned straight from the input, save for a
+ * string that has to be patched up.  Reserved words and operators are
+ * told apart by kwlook and never interned.
+ */
+static int lex(YYSTYPE *lval)
+{
+   int c, type;
+   char *s;
 
-   i = 0;
-   type = RESERVED;
    skip();
-   switch (istype(c = getchar())) {
-      case EOF:
-         return (-1);
-         break;
-      case LETTER: 
-         putbak(c);
-         while ((isalpha(c = getchar()) || isdigit(c) || c == '_') &&
-                i < MAXTOK)
-            lin[i++] = c;
-         putbak(c);
-         type = ID;
-         break;
-      case DIGIT:
-         putbak(c);
-         while (isdigit(c = getchar()) && i < MAXTOK)
-            lin[i++] = c;
-         putbak(c);
-         type = CON;
-         break;
+   if (ip >= iend)
+      return (-1);
+   s = ip;
+   c = (unsigned char) *ip++;
+   if (cclass[c] & C_ALPHA) {
+      while (cclass[(unsigned char) *ip] & C_ID)
+         ip++;
+      if ((type = kwlook(s, ip - s)) != 0)
+         return (type);
+      lval->str_ptr = snlookup(s, ip - s);
+      return (ID);
+   }
+   if (cclass[c] & C_DIGIT) {
+      while (cclass[(unsigned char) *ip] & C_DIGIT)
+         ip++;
+      lval->str_ptr = snlookup(s, ip - s);
+      return (CON);
+   }
+   switch (c) {
       case '(': case ')': case ',': case '.': case ':': 
       case ';': case '?': case '[': case ']': case '{':
       case '}':
-         type = lin[i++] = c;
-         break;
+         return (c);
       case '~':
-         lin[i++] = c;
          break;
       case '!': case '%': case '*': case '/': case '^': case '=':
-         lin[i++] = c;
-         c = getchar();
-         if (c == '=')
-            lin[i++] = c;
-         else
-            putbak(c);
+         if (*ip == '=')
+            ip++;
          break;
       case '&': case '+': case '-': case '|':
-         lin[i++] = c;
-         c = getchar();
-         if (c == '=' || c == lin[i-1])
-            lin[i++] = c;
-         else
-            putbak(c);
+         if (*ip == '=' || *ip == c)
+            ip++;
          break;
       case '<': case '>':
-         lin[i++] = c;
-         c = getchar();
-         if (c == lin[i-1]) {
-            lin[i++] = c;
-            c = getchar();
-         }
-         if (c == '=')
-            lin[i++] = c;
-         else
-            putbak(c);
+         if (*ip == c)
+            ip++;
+         if (*ip == '=')
+            ip++;
          break;
       case '"':
-         i = quote(lin);
-         type = STR;
-         break;
+         lval->str_ptr = quote(s);
+         return (STR);
       default:
-        fprintf(stderr, "illegal character: %o\n", c);
-        return (yylex());
+         fprintf(stderr, "illegal character: %o\n", c);
+         return (lex(lval));
    }
-   lin[i] = 0;
-   p = lookup(yylval.str_ptr = slookup(lin), 0);
-   if (p != NULL && p->i_blevel == 1)
-      type = p->i_type;
+   /* ++ and -- are not operators here */
+   return ((type = kwlook(s, ip - s)) != 0 ? type : RESERVED);
+}
+
+/*
+ * yylex - fetch next token for the parser, timed as the scanner's
+ */
+int yylex(YYSTYPE *lval)
+{
+   int ph, type;
+
+   ph = tenter(PH_LEX);
+   type = lex(lval);
+   tenter(ph);
    return (type);
 }
 
@@ -162,26 +272,17 @@ int yylex()
  */
 void skip()
 {
-   int c1, c2;
-
-   c1 = getchar(); 
    for (;;)
-      if (isspace(c1)) {
-         if (c1 == '\n')
+      if (cclass[(unsigned char) *ip] & C_SPACE) {
+         if (*ip++ == '\n')
             lineno++;
-         c1 = getchar();
       }
-      else if (c1 == '/' && (c2 = getchar()) == '*') {
+      else if (ip[0] == '/' && ip[1] == '*') {
+         ip += 2;
          comment();
-         c1 = getchar();
-      }
-      else if (c1 == '/') {
-         putbak(c2);
-         break;
       }
       else
          break;
-   putbak(c1);
 }
 
 /*
@@ -189,101 +290,72 @@ void skip()
  */
 void comment()
 {
-   int c1, c2;
-
-   for (;;) {
-      c1 = getchar();
-      if (c1 == EOF)
-         break;
-      else if (c1 == '*' && (c2 = getchar()) == '/')
-         break;
-      else if (c1 == '*')
-         putbak(c2);
-      else if (c1 == '\n')
+   for (; ip < iend; ip++)
+      if (ip[0] == '*' && ip[1] == '/') {
+         ip += 2;
+         return;
+      }
+      else if (*ip == '\n')
          lineno++;
-   }
-}
-
-/*
- * istype - classify character
- */
-int istype(int c)
-{
-   if (isalpha(c))
-      return(LETTER);
-   else if (isdigit(c))
-      return(DIGIT);
-   else
-      return(c);
 }
 
 /*
- * putbak - push character back onto input
+ * tput - store c at tbuf[i], making room as needed
  */
-void putbak(int c)
+static void tput(unsigned i, int c)
 {
-   if (c != EOF)
-      ungetc(c, stdin);
+   if (i >= tmax) {
+      tmax = tmax ? 2 * tmax : 256;
+      if ((tbuf = realloc(tbuf, tmax)) == NULL) {
+         yyerror("csem: out of space");
+         exit (1);
+      }
+   }
+   tbuf[i] = c;
 }
 
 /*
- * quote - get quoted string
+ * quote - get quoted string starting at s, return it interned
+ *
+ * An escaped newline is dropped and a missing closing quote supplied;
+ * only then is the text copied out of the input.
  */
-int quote(char lin[])
+char *quote(char *s)
 {
-   int c, i, j, peek;
+   unsigned i;
+   char *t;
 
-   i = j = 0;
-
-   /* copy quote */
-   lin[i++] = '"';
-
-   /* get rest of string */
-   c = getchar();
-   for (;;) {
-      if (c == '"') {
-         lin[i++] = c;
-         break;
+   /* the usual case needs no copy */
+   for (; ip < iend && *ip != '"'; ip++)
+      if (ip[0] == '\\') {
+         if (ip[1] == '\n')
+            break;
+         if (ip + 1 < iend)
+            ip++;
       }
+   if (ip < iend && *ip == '"')
+      return (snlookup(s, ++ip - s));
 
-      /* supply a missing quote if needed */
-      if (c == EOF) {
+   for (i = 0, t = s; t < ip; t++)
+      tput(i++, *t);
+   for (;;) {
+      if (ip >= iend) {
          fprintf(stderr, "missing quote\n");
-         lin[i++] = '"';
+         tput(i++, '"');
          break;
       }
-
-      /* handle escaped characters */
-      if (c == '\\') {
-         peek = getchar();
-
-         /* ignore escaped newline */
-         if (peek == '\n') {
-            c = getchar();
-            lineno++;
-            continue;
-         }
-         else
-            putbak(peek);
+      if (*ip == '"') {
+         tput(i++, *ip++);
+         break;
       }
-
-      /* count characters inside string */
-      j++;
-
-      /* copy next char */
-      lin[i] = c;
-
-      /* get the next character */
-      c = getchar();
-
-      /* copy escaped char */
-      if (lin[i++] == '\\' && c != EOF) {
-         lin[i++] = c;
-         c = getchar();
+      if (ip[0] == '\\' && ip[1] == '\n') {
+         ip += 2;
+         lineno++;
+         continue;
       }
+      tput(i++, *ip);
+      if (*ip++ == '\\' && ip < iend)
+         tput(i++, *ip++);
    }
-
-   /* terminate the string */
-   lin[i++] = '\0';
-   return (i);
+   return (snlookup(tbuf, i));
 }
@@ -1,8 +1,7 @@
 void initlex();
-void initrw(int, char *);
+int kwlook(char *, unsigned);
+void readin(FILE *);
 int yylex();
 void skip();
 void comment();
-int istype(int);
-void putbak(int);
-int quote(char []);
+char *quote(char *);
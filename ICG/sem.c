@@ -11,33 +11,38 @@
 # include "semutil.h"
 # include "sem.h"
 # include "sym.h"
+# include "quad.h"
+# include "pool.h"
 
 #include <string.h>
-#define MAXLOOPS 500
 
 // Forward declare the error function so gcc will shut up
 extern void yyerror(const char *s);
 
 // Tracks formal parameters and their types in the current scope level
-extern int formalnum;
-extern char formaltypes[];
+extern UNIT int formalnum;
+extern UNIT char *formaltypes;
 
 // Tracks local variables and their types in the current scope level
-extern int localnum;
-extern char localtypes[];
+extern UNIT int localnum;
+extern UNIT char *localtypes;
 
 // Tracks widths of locals 
-extern int localwidths[];
+extern UNIT int *localwidths;
 
-int numlabels = 0;                      /* total labels in file */
-int numblabels = 0;                     /* total backpatch labels in file */
-int numloops = 0;			// Track how many times we have looped
-struct sem_rec* loops[MAXLOOPS];	// Track n for patching
+// Last temporary number, kept by nexttemp
+extern UNIT int ntmp;
 
-int infunc = 0;				// If we are in a function, we need to track the type
+UNIT int numlabels = 0;                 /* total labels in file */
+UNIT int numblabels = 0;                /* total backpatch labels in file */
+UNIT int numloops = 0;			// Track how many times we have looped
+UNIT struct sem_rec **loops = NULL;	// Track n for patching
+UNIT int maxloops = 0;			// Room in loops
+
+UNIT int infunc = 0;			// If we are in a function, we need to track the type
 					// to handle implicit returns of
 					// doubles
-int functype = 0;			
+UNIT int functype = 0;			
 
 void deepcopy(struct sem_rec *, struct sem_rec *);	// Local helper
 
@@ -60,8 +65,11 @@ void backpatch(struct sem_rec *p, int k){
 	 */
 
 	struct sem_rec *curr = p;
+	struct quad *q;
 	while(NULL != curr){
-		printf("B%d=L%d\n", p->s_place, k);
+		q = qgen(Q_BPATCH, 0);
+		q->q_n = curr->s_place;
+		q->q_m = k;
 		curr = curr->back.s_link;
 	}
 }
@@ -72,8 +80,8 @@ void backpatch(struct sem_rec *p, int k){
  */
 void bgnstmt(){
 
-	extern int lineno;
-	printf("bgnstmt %d\n", lineno);
+	extern UNIT int lineno;
+	qgen(Q_BGNSTMT, 0)->q_n = lineno;
 }
 
 
@@ -88,7 +96,7 @@ struct sem_rec *call(char *f, struct sem_rec *args){
 	int numargs = 0;
 
 	while(NULL != curr){
-		gen("arg", (struct sem_rec *)NULL, curr, curr->s_mode);
+		gen(Q_ARG, (struct sem_rec *)NULL, curr, curr->s_mode);
 		numargs++;
 		curr = curr->back.s_link;
 	}
@@ -109,7 +117,7 @@ struct sem_rec *call(char *f, struct sem_rec *args){
 	// At this point, we have a valid entry
 
 	// Name the global identifier
-	printf("t%d := global %s\n", nexttemp(), f);
+	qgen(Q_GLOBAL, nexttemp())->q_s = f;
 
 	/*
 	 * Use gen to print out the call
@@ -120,7 +128,7 @@ struct sem_rec *call(char *f, struct sem_rec *args){
 	 * symbol table.
 	 */
 
-	return gen("f",
+	return gen(Q_CALL,
 		   node(currtemp(), 0, (struct sem_rec *)NULL, (struct sem_rec *)NULL),
 		   node(numargs, 0, (struct sem_rec *)NULL, (struct sem_rec *)NULL),
 		   p->i_type);
@@ -147,6 +155,7 @@ struct sem_rec *ccand(struct sem_rec *e1, int m, struct sem_rec *e2){
 struct sem_rec *ccexpr(struct sem_rec *e){
 	
 	struct sem_rec *t1;
+	struct quad *q;
 
 	if(e){
 		/* 
@@ -183,7 +192,7 @@ struct sem_rec *ccexpr(struct sem_rec *e){
 		 * upstream and then back down into gen for the call
 		 * immediately below.  Again, a new temporary is preinted for
 		 * assignment.  This time, the op is caught by the
-		 * is(x!= NULL && *op != 'f') clause, and the place of the
+		 * is(x!= NULL && op != Q_CALL) clause, and the place of the
 		 * e sem_rec is printed, followed by the op, and then the
 		 * place of the cast sem_rec: tnew := te !=f ti.  So we have
 		 * converted zero if necessary, given it a temp, and now finally
@@ -197,11 +206,13 @@ struct sem_rec *ccexpr(struct sem_rec *e){
 		 */
 
 		int realtype = e->s_mode &~ T_ADDR;
-		t1 = gen("!=", e, cast(con("0"), realtype), realtype);
+		t1 = gen(Q_NE, e, cast(con("0"), realtype), realtype);
 		numblabels++;
-		printf("bt t%d B%d\n", t1->s_place, numblabels);
+		q = qgen(Q_BT, 0);
+		q->q_x = t1->s_place;
+		q->q_n = numblabels;
 		numblabels++;
-		printf("br B%d\n", numblabels);
+		qgen(Q_BR, 0)->q_n = numblabels;
 		return 	node(0,
 			     0,
 			     node(numblabels-1, 0, (struct sem_rec *) NULL, (struct sem_rec *) NULL),
@@ -254,7 +265,7 @@ struct sem_rec *con(char *x){
 	}
 
 	/* print the quad t%d = const */
-	printf("t%d := %s\n", nexttemp(), x);
+	qgen(Q_CON, nexttemp())->q_s = x;
 
 	/* construct a new node corresponding to this constant generation 
 	  into a temporary. This will allow this temporary to be referenced
@@ -272,7 +283,7 @@ void dobreak(){
 	
 	// Print out intermediate code
 	numblabels++;
-	printf("br B%d\n", numblabels);
+	qgen(Q_BR, 0)->q_n = numblabels;
 
 	/*
 	 * We need to incorporate the falselist of the current
@@ -288,8 +299,14 @@ void dobreak(){
 		}
 	}
 	
-	// Make a new node for the label number generated above
-	curr = node(numblabels, 0, (struct sem_rec *)NULL, (struct sem_rec *)NULL);
+	// Make a new node for the label number generated above and hang it
+	// off the end of the list so endloopscope patches it
+	if(NULL != curr){
+		curr->back.s_link = node(numblabels, 0, (struct sem_rec *)NULL, (struct sem_rec *)NULL);
+	}
+	else{
+		loops[numloops]->s_false = node(numblabels, 0, (struct sem_rec *)NULL, (struct sem_rec *)NULL);
+	}
 }
 
 
@@ -302,7 +319,7 @@ void docontinue(){
 	
 	// Print out intermediate code
 	numblabels++;
-	printf("br B%d\n", numblabels);
+	qgen(Q_BR, 0)->q_n = numblabels;
 
 	/*
 	 * We need to incorporate the truelist of the current
@@ -318,8 +335,14 @@ void docontinue(){
 		}
 	}
 	
-	// Make a new node for the label number generated above
-	curr = node(numblabels, 0, (struct sem_rec *)NULL, (struct sem_rec *)NULL);
+	// Make a new node for the label number generated above and hang it
+	// off the end of the list so the loop routine patches it
+	if(NULL != curr){
+		curr->back.s_link = node(numblabels, 0, (struct sem_rec *)NULL, (struct sem_rec *)NULL);
+	}
+	else{
+		loops[numloops]->back.s_true = node(numblabels, 0, (struct sem_rec *)NULL, (struct sem_rec *)NULL);
+	}
 }
 
 
@@ -423,7 +446,7 @@ void dofor(int m1, struct sem_rec *e2, int m2, struct sem_rec *n1, int m3,
 void dogoto(char *id){
 	
 	// Use the symbol table to get the appropriate entry to jump to
-	printf("br L%s\n", slookup(id));
+	qgen(Q_GOTO, 0)->q_s = slookup(id);
 }
 
 
@@ -464,16 +487,16 @@ void doifelse(struct sem_rec *e, int m1, struct sem_rec *n,
 void doret(struct sem_rec *e){
 	if(NULL != e){
 		// Pass first record as null to catch return case properly
-		gen("ret", (struct sem_rec *)NULL, e,  e->s_mode);
+		gen(Q_RET, (struct sem_rec *)NULL, e,  e->s_mode);
 	}
 	else{
 		// If there is no return, use the function type to print
 		// return properly
 		if(functype & T_DOUBLE){
-			printf("retf\n");
+			qgen(Q_RET, 0)->q_t = 'f';
 		}
 		else{
-			printf("reti\n");
+			qgen(Q_RET, 0)->q_t = 'i';
 		}
 	}
 }
@@ -558,22 +581,22 @@ void fhead(struct id_entry *p){
 	for(int i = 0; i<formalnum; ++i){
 		if('i' == formaltypes[i]){
 			// integer types 4 bytes
-			printf("formal 4\n");
+			qgen(Q_FORMAL, 0)->q_n = 4;
 		}
 		else{
 			// others are 8 (pointer or double)
-			printf("formal 8\n");
+			qgen(Q_FORMAL, 0)->q_n = 8;
 		}
 	}
 
 	for(int i = 0; i<localnum; ++i){
 		if('i' == localtypes[i]){
 			// integer types 4 bytes
-			printf("localloc 4\n");
+			qgen(Q_LOCALLOC, 0)->q_n = 4;
 		}
 		else{
 			// others are 8 (pointer or double)
-			printf("localloc 8\n");
+			qgen(Q_LOCALLOC, 0)->q_n = 8;
 		}		
 	}
 }
@@ -598,8 +621,10 @@ struct id_entry *fname(int t, char *id){
 			functype = T_DOUBLE;
 	}
 
-	// Print out the intermediate code
-	printf("func %s\n", id);
+	// Write out the declarations seen since the last function, then
+	// start the intermediate code for this one
+	pflush(0);
+	qgen(Q_FUNC, 0)->q_s = id;
 	
 	// Initialize formals and locals list for this context
 	formalnum = 0;
@@ -629,8 +654,10 @@ struct id_entry *fname(int t, char *id){
  */
 void ftail(){
 	
-	// Print intermediate code stmt
-	printf("fend\n");
+	// Print intermediate code stmt, then hand the function on to have
+	// its branches pointed at their labels, be optimized and written out
+	qgen(Q_FEND, 0);
+	pflush(1);
 	
 	// Leave function scope
 	leaveblock();
@@ -643,6 +670,7 @@ void ftail(){
  */
 struct sem_rec *id(char *x){
 	struct id_entry *p;
+	struct quad *q;
 
 	if((p = lookup(x, 0)) == NULL){
 		yyerror("undeclared identifier");
@@ -652,16 +680,18 @@ struct sem_rec *id(char *x){
 		p->i_defined = 1;
 	}
 	if (p->i_scope == GLOBAL){
-		printf("t%d := global %s\n", nexttemp(), x);
+		qgen(Q_GLOBAL, nexttemp())->q_s = x;
 	}
 	else if(p->i_scope == LOCAL){
-		printf("t%d := local %d\n", nexttemp(), p->i_offset);
+		qgen(Q_LOCAL, nexttemp())->q_n = p->i_offset;
 	}
 	else if(p->i_scope == PARAM){
-		printf("t%d := param %d\n", nexttemp(), p->i_offset);
+		qgen(Q_PARAM, nexttemp())->q_n = p->i_offset;
 		if(p->i_type & T_ARRAY){
 	   		(void) nexttemp();
-			printf("t%d := @i t%d\n", currtemp(), currtemp()-1);
+			q = qgen(Q_DEREF, currtemp());
+			q->q_t = 'i';
+			q->q_y = currtemp()-1;
 		}
 	}
 
@@ -679,7 +709,7 @@ struct sem_rec *id(char *x){
  */
 struct sem_rec *tom_index(struct sem_rec *x, struct sem_rec *i){
 
-	return (gen("[]", x, cast(i, T_INT), x->s_mode&~(T_ARRAY)));
+	return (gen(Q_INDEX, x, cast(i, T_INT), x->s_mode&~(T_ARRAY)));
 }
 
 
@@ -687,12 +717,14 @@ struct sem_rec *tom_index(struct sem_rec *x, struct sem_rec *i){
  * labeldcl - process a label declaration
  */
 void labeldcl(char *id){
-	// Cue the lookup table to install an id (or error out)
-	slookup(id);
-	
-	// Make a new local label
+	struct quad *q;
+
+
+	// Make a new local label, named so it is never dropped as untargeted
 	numlabels++;
-	printf("label L%d\n", numlabels);
+	q = qgen(Q_LABEL, 0);
+	q->q_n = numlabels;
+	q->q_s = slookup(id);
 	
 }
 
@@ -709,7 +741,7 @@ int m(){
 	 */
 
 	numlabels++;
-	printf("label L%d\n", numlabels);
+	qgen(Q_LABEL, 0)->q_n = numlabels;
 	return numlabels;
 }
 
@@ -726,7 +758,7 @@ struct sem_rec *n(){
 
 	// Print the goto as an unconditional branch
 	numblabels++;
-	printf("br B%d\n", numblabels);
+	qgen(Q_BR, 0)->q_n = numblabels;
 	return node(numblabels, 0, (struct sem_rec *)NULL, (struct sem_rec *)NULL);
 }
 
@@ -734,9 +766,9 @@ struct sem_rec *n(){
 /*
  * op1 - unary operators
  */
-struct sem_rec *op1(char *op, struct sem_rec *y){
+struct sem_rec *op1(int op, struct sem_rec *y){
 
-	if(*op == '@' && !(y->s_mode&T_ARRAY)){
+	if(op == Q_DEREF && !(y->s_mode&T_ARRAY)){
 	 /* get rid of T_ADDR if it is being dereferenced so can handle
 	    T_DOUBLE types correctly */
 		y->s_mode &= ~T_ADDR;
@@ -751,7 +783,7 @@ struct sem_rec *op1(char *op, struct sem_rec *y){
 /*
  * op2 - arithmetic operators
  */
-struct sem_rec *op2(char *op, struct sem_rec *x, struct sem_rec *y){
+struct sem_rec *op2(int op, struct sem_rec *x, struct sem_rec *y){
 	
 	struct sem_rec *p;
 	if(NULL != x){
@@ -774,7 +806,7 @@ struct sem_rec *op2(char *op, struct sem_rec *x, struct sem_rec *y){
 /*
  * opb - bitwise operators
  */
-struct sem_rec *opb(char *op, struct sem_rec *x, struct sem_rec *y){
+struct sem_rec *opb(int op, struct sem_rec *x, struct sem_rec *y){
 
 	struct sem_rec *p;
 
@@ -791,12 +823,13 @@ struct sem_rec *opb(char *op, struct sem_rec *x, struct sem_rec *y){
 /*
  * rel - relational operators
  */
-struct sem_rec *rel(char *op, struct sem_rec *x, struct sem_rec *y){
+struct sem_rec *rel(int op, struct sem_rec *x, struct sem_rec *y){
 
 	int realtypex = x->s_mode & ~T_ADDR;
 	int realtypey = y->s_mode & ~T_ADDR;
 
 	struct sem_rec *p;
+	struct quad *q;
 	//if(x->s_mode & T_DOUBLE && y->s_mode & T_INT){
 	if(realtypex > realtypey){
 		p = cast(y, x->s_mode);
@@ -813,29 +846,47 @@ struct sem_rec *rel(char *op, struct sem_rec *x, struct sem_rec *y){
 	// Need to generate the branches to be taken for this
 	// condition per the grammar 6.43
 	numblabels++;
-	printf("bt t%d B%d\n", currtemp(), numblabels);
+	q = qgen(Q_BT, 0);
+	q->q_x = currtemp();
+	q->q_n = numblabels;
 	ret->back.s_true = node(numblabels, x->s_mode, (struct sem_rec *)NULL, (struct sem_rec *)NULL);
 	
 	numblabels++;
 	ret->s_false = node(numblabels, x->s_mode, (struct sem_rec *)NULL, (struct sem_rec *)NULL);
-	printf("br B%d\n", numblabels);
+	qgen(Q_BR, 0)->q_n = numblabels;
 	
 	return ret;
 }
 
 
+/*
+ * semreset - start the numbering of temporaries and labels over for the
+ * next file
+ */
+void semreset(){
+
+	ntmp = 0;
+	numlabels = 0;
+	numblabels = 0;
+	numloops = 0;
+	infunc = 0;
+	functype = 0;
+}
+
+
 /*
  * set - assignment operators
  */
-struct sem_rec *set(char *op, struct sem_rec *x, struct sem_rec *y){
+struct sem_rec *set(int op, struct sem_rec *x, struct sem_rec *y){
 	
 	/* assign the value of expression y to the lval x */
 	struct sem_rec *p, *cast_y, *p2;
+	struct quad *q;
 	
 	
 	// Generate an intermediate temp if one of our operands was null, we
 	// need to dereference.
-	if(*op!='\0' || x==NULL || y==NULL){
+	if(op != Q_ASSIGN || x==NULL || y==NULL){
 	
 		int realtypex = x->s_mode & ~T_ADDR;
 		int realtypey = y->s_mode & ~T_ADDR;
@@ -843,13 +894,13 @@ struct sem_rec *set(char *op, struct sem_rec *x, struct sem_rec *y){
 		// Print dereference statement	
 		if(1 == realtypex){
 			// first needs to be null or it comes out backwards
-			p = gen("@", (struct sem_rec *)NULL, x, T_INT);
+			p = gen(Q_DEREF, (struct sem_rec *)NULL, x, T_INT);
 			
 			// Print casting if necessary
 			cast_y = cast(y, T_INT);
 		}
 		else{
-			p = gen("@", (struct sem_rec *)NULL, x, T_DOUBLE);
+			p = gen(Q_DEREF, (struct sem_rec *)NULL, x, T_DOUBLE);
 			
 			// Print casting if necessary
 			cast_y = cast(y, T_DOUBLE);
@@ -860,10 +911,10 @@ struct sem_rec *set(char *op, struct sem_rec *x, struct sem_rec *y){
 		p2 = gen(op, p, cast_y, cast_y->s_mode);
 		
 		// Do the assignment
-		return gen("=", x, p2, cast_y->s_mode);
+		return gen(Q_ASSIGN, x, p2, cast_y->s_mode);
 
 		/*
-		p = op1("@", x);
+		p = op1(Q_DEREF, x);
 
 		// Print dereference statement
 		if(p->s_mode & T_INT){
@@ -906,11 +957,14 @@ struct sem_rec *set(char *op, struct sem_rec *x, struct sem_rec *y){
 		}
 
 		/*output quad for assignment*/
+		q = qgen(Q_ASSIGN, nexttemp());
+		q->q_x = x->s_place;
+		q->q_y = cast_y->s_place;
 		if((x->s_mode &~ T_ARRAY)& T_INT){
-			printf("t%d := t%d =i t%d\n", nexttemp(), x->s_place, cast_y->s_place);
+			q->q_t = 'i';
 		}
 		else{
-			printf("t%d := t%d =f t%d\n", nexttemp(), x->s_place, cast_y->s_place);
+			q->q_t = 'f';
 		}
 	}
 
@@ -950,7 +1004,10 @@ void startloopscope(){
 	// Create a new node to jump to
 	struct sem_rec * curr = node(0, 0, (struct sem_rec *)NULL, (struct sem_rec *)NULL);
 
-	// Track it in our array
+	// Track it in our array, grown for the deepest nest seen yet
+	if(numloops >= maxloops){
+		loops = vgrow(loops, &maxloops, numloops, sizeof(struct sem_rec *));
+	}
 	loops[numloops] = curr;
 	
 	// Enter new scope for symbol table
@@ -967,7 +1024,7 @@ struct sem_rec *string(char *s){
 	struct sem_rec *ret = node(nexttemp(), T_STR, (struct sem_rec *)NULL, (struct sem_rec *)NULL);	
 
 	// Print the intermediate code
-	printf("t%d := %s\n", ret->s_place, s);
+	qgen(Q_STR, ret->s_place)->q_s = s;
 
 	return ret;
 }
@@ -981,10 +1038,10 @@ struct sem_rec *string(char *s){
 struct sem_rec *cast(struct sem_rec *y, int t){
 	
 	if(t == T_DOUBLE && y->s_mode != T_DOUBLE){
-		return (gen("cv", (struct sem_rec *) NULL, y, t));
+		return (gen(Q_CV, (struct sem_rec *) NULL, y, t));
 	}
 	else if(t != T_DOUBLE && y->s_mode == T_DOUBLE){
-		return (gen("cv", (struct sem_rec *) NULL, y, t));
+		return (gen(Q_CV, (struct sem_rec *) NULL, y, t));
 	}
 	else{
 		return (y);
@@ -1012,31 +1069,36 @@ struct sem_rec *cast(struct sem_rec *y, int t){
  *	the assignment of assignment operators
  *	the operator of assignment operators
  */
-struct sem_rec *gen(char *op, struct sem_rec *x, struct sem_rec *y, int t){
+struct sem_rec *gen(int op, struct sem_rec *x, struct sem_rec *y, int t){
 	
-	if(strncmp(op, "arg", 3) != 0 && strncmp(op, "ret", 3) != 0){
-		printf("t%d := ", nexttemp());
+	struct quad *q;
+	char msg[64];
+	int z = 0;
+
+	if(qops[op].o_flags & O_Z){
+		z = nexttemp();
 	}
-	if(x != NULL && *op != 'f'){
-	   printf("t%d ", x->s_place);
+	q = qgen(op, z);
+	if(x != NULL){
+	   q->q_x = x->s_place;
 	}
-	printf("%s", op);
-	if(t & T_DOUBLE && (!(t & T_ADDR) || (*op == '[' && *(op+1) == ']'))) {
-		printf("f");
-		if(*op == '%'){
-			yyerror("cannot %% floating-point values");
+	if(t & T_DOUBLE && (!(t & T_ADDR) || op == Q_INDEX)) {
+		q->q_t = 'f';
+		if(!(qops[op].o_flags & O_FLT)){
+			sprintf(msg, "cannot %s floating-point values", qops[op].o_name);
+			yyerror(msg);
 		}
 	}
 	else{
-		printf("i");
+		q->q_t = 'i';
 	}
-	if(x != NULL && *op == 'f'){
-		printf(" t%d %d", x->s_place, y->s_place);
+	if(x != NULL && op == Q_CALL){
+		// The second operand of a call is its argument count
+		q->q_n = y->s_place;
 	}
 	else if(y != NULL){
-		printf(" t%d", y->s_place);
+		q->q_y = y->s_place;
 	}
-	printf("\n");
 	return (node(currtemp(), t, (struct sem_rec *) NULL, (struct sem_rec *) NULL));
 }
 
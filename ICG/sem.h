@@ -22,16 +22,17 @@ struct sem_rec *exprs(struct sem_rec *, struct sem_rec *);
 void fhead(struct id_entry *);
 struct id_entry *fname(int, char *);
 void ftail();
-struct sem_rec *gen(char *, struct sem_rec *, struct sem_rec *, int);
+struct sem_rec *gen(int, struct sem_rec *, struct sem_rec *, int);
 struct sem_rec *id(char *);
 struct sem_rec *tom_index(struct sem_rec *x, struct sem_rec *i);
 void labeldcl(char *);
 int m();
 struct sem_rec *n();
-struct sem_rec *op1(char *, struct sem_rec *);
-struct sem_rec *op2(char *, struct sem_rec *, struct sem_rec *);
-struct sem_rec *opb(char *, struct sem_rec *, struct sem_rec *);
-struct sem_rec *rel(char *, struct sem_rec *, struct sem_rec *);
-struct sem_rec *set(char *, struct sem_rec *, struct sem_rec *);
+struct sem_rec *op1(int, struct sem_rec *);
+struct sem_rec *op2(int, struct sem_rec *, struct sem_rec *);
+struct sem_rec *opb(int, struct sem_rec *, struct sem_rec *);
+struct sem_rec *rel(int, struct sem_rec *, struct sem_rec *);
+void semreset();
+struct sem_rec *set(int, struct sem_rec *, struct sem_rec *);
 void startloopscope();
 struct sem_rec *string(char *);
@@ -2,18 +2,22 @@
 # include <stdlib.h>
 # include "cc.h"
 # include "sem.h"
+# include "semutil.h"
 # include "sym.h"
-# define MAXARGS 50
-# define MAXLOCS 50
+# include "quad.h"
 
-int ntmp = 0;                /* last temporary number      */
-int formalnum;               /* number of formal arguments */
-char formaltypes[MAXARGS];   /* types of formal arguments  */
-int localnum;                /* number of local variables  */
-char localtypes[MAXLOCS];    /* types of local variables   */
-int localwidths[MAXLOCS];    /* widths of local variables  */
+extern void yyerror(const char *);
 
-extern struct sem_rec **top;
+UNIT int ntmp = 0;                /* last temporary number      */
+UNIT int formalnum;               /* number of formal arguments */
+UNIT char *formaltypes = NULL;    /* types of formal arguments  */
+UNIT int localnum;                /* number of local variables  */
+UNIT char *localtypes = NULL;     /* types of local variables   */
+UNIT int *localwidths = NULL;     /* widths of local variables  */
+
+static UNIT int formalmax = 0;    /* room in formaltypes        */
+static UNIT int localmax = 0;     /* room in localtypes         */
+static UNIT int widthmax = 0;     /* room in localwidths        */
 
 /*
  * currtemp - returns the current temporary number
@@ -28,7 +32,8 @@ int currtemp()
  */
 struct id_entry *dcl(struct id_entry *p, int type, int scope)
 {
-   extern int level;
+   extern UNIT int level;
+   struct quad *q;
 
    p->i_type += type;
    if (scope != 0)
@@ -39,30 +44,30 @@ struct id_entry *dcl(struct id_entry *p, int type, int scope)
       p->i_scope = LOCAL;
    if (level > 2 && p->i_scope == PARAM) {
       p->i_offset = formalnum;
+      if (formalnum >= formalmax)
+         formaltypes = vgrow(formaltypes, &formalmax, formalnum, 1);
       if (p->i_type == T_DOUBLE)
          formaltypes[formalnum++] = 'f';
       else
          formaltypes[formalnum++] = 'i';
-      if (formalnum > MAXARGS) {
-         fprintf(stderr, "too many arguments\n");
-         exit(1);
-      }
    }
    else if (level > 2 && p->i_scope != PARAM) {
       p->i_offset = localnum;
+      if (localnum >= localmax)
+         localtypes = vgrow(localtypes, &localmax, localnum, 1);
+      if (localnum >= widthmax)
+         localwidths = vgrow(localwidths, &widthmax, localnum, sizeof(int));
       localwidths[localnum] = p->i_width;
       if (p->i_type & T_DOUBLE)
          localtypes[localnum++] = 'f';
       else
          localtypes[localnum++] = 'i';
-      if (localnum > MAXLOCS) {
-         fprintf(stderr, "too many locals\n");
-         exit(1);
-      }
    }
-   else if (p->i_width > 0 && level == 2)
-      printf("alloc %s %d\n", p->i_name,
-             p->i_width * tsize(p->i_type&~T_ARRAY));
+   else if (p->i_width > 0 && level == 2) {
+      q = qgen(Q_ALLOC, 0);
+      q->q_s = p->i_name;
+      q->q_n = p->i_width * tsize(p->i_type&~T_ARRAY);
+   }
    return p;
 }
 
@@ -72,7 +77,7 @@ struct id_entry *dcl(struct id_entry *p, int type, int scope)
 struct id_entry *dclr(char *name, int type, int width)
 {
    struct id_entry *p;
-   extern int level;
+   extern UNIT int level;
    char msg[80];
 
    if ((p = lookup(name, 0)) == NULL || p->i_blevel != level)
@@ -121,11 +126,8 @@ struct sem_rec *node(int a, int b, struct sem_rec *c, struct sem_rec *d)
 {
    struct sem_rec *t;
 
-   /* allocate space */
-   t = (struct sem_rec *) alloc(sizeof(struct sem_rec));
-
-   /* save semantic record */
-   save_rec(t);
+   /* allocate space, reclaimed when the enclosing block exits */
+   t = (struct sem_rec *) ralloc(sizeof(struct sem_rec));
 
    /* fill in the fields */
    t->s_place = a;
@@ -147,3 +149,21 @@ int tsize(int type)
    else 
       return(0);
 }
+
+/*
+ * vgrow - grow vector v of *max elements of size bytes until element n
+ *         fits, return it
+ *
+ * A vector is kept from one function to the next, so it is only grown
+ * by a function bigger than any before it.
+ */
+void *vgrow(void *v, int *max, int n, unsigned size)
+{
+   while (n >= *max)
+      *max = *max ? 2 * *max : 64;
+   if ((v = realloc(v, *max * size)) == NULL) {
+      yyerror("csem: out of space");
+      exit (1);
+   }
+   return (v);
+}
@@ -5,3 +5,4 @@ struct sem_rec *merge(struct sem_rec *, struct sem_rec *);
 int nexttemp();
 struct sem_rec *node(int, int, struct sem_rec *, struct sem_rec *);
 int tsize(int);
+void *vgrow(void *, int *, int, unsigned);
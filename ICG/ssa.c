@@ -0,0 +1,1127 @@
+/* static single assignment form, and the passes over it */
+
+# include <stdio.h>
+# include <stdlib.h>
+# include <string.h>
+# include "cc.h"
+# include "quad.h"
+# include "cfg.h"
+# include "opt.h"
+# include "sym.h"
+
+extern void yyerror(const char *);
+
+/*
+ * Temporaries are assigned once already; what is not in SSA form is the
+ * scalar variables, which live in memory, each use a load through the
+ * address a local or param quad gives and each assignment a store.  A
+ * variable whose address is only loaded and stored through is promoted,
+ * after Cytron et al.: a phi for it is placed on the iterated dominance
+ * frontier of the blocks storing it, and a walk of the dominator tree
+ * renames each load to the value last stored or the phi.  The stores go.
+ *
+ * On that form constants are propagated by the algorithm of Wegman and
+ * Zadeck, which also finds the branches that only go one way and the
+ * blocks never reached, and then equal expressions are numbered alike
+ * over the dominator tree, a quad whose value a dominating one computes
+ * going.  A phi whose operands are all one value is that value.
+ *
+ * The quads have no copy, so leaving SSA puts a variable back in memory
+ * where its phis need it: a phi still used becomes a load at the head of
+ * its block, and each predecessor stores the value the variable has at
+ * its end.  A variable read before it is set is loaded once at entry.
+ */
+
+# define STOP 0			/* lattice value: not yet known */
+# define SCON 1			/* a constant */
+# define SBOT 2			/* varies */
+
+/* variable slot, local n or param n, that may live in temporaries */
+struct svar {
+   struct quad *v_q;		/* a quad taking its address */
+   int v_t;			/* type of its loads and stores, 0 until seen */
+   int v_ok;			/* nonzero while it may be promoted */
+   int v_entry;			/* temporary for its value at entry */
+   int v_cur;			/* its value while renaming */
+   int v_addr;			/* temporary for its address when put back */
+};
+
+/* phi of variable p_var at the head of block p_blk */
+struct sphi {
+   int p_var;			/* the variable */
+   int p_blk;			/* the block */
+   int p_z;			/* temporary it sets */
+   int *p_arg;			/* value along each edge in, as in b_pred */
+   int p_next;			/* next phi of the block, -1 at the end */
+   int p_dead;			/* replaced by the value of its operands */
+   int p_const;			/* a nonnegative int constant */
+};
+
+/* what is known of a temporary while propagating constants */
+struct slat {
+   int l_s;			/* STOP, SCON or SBOT */
+   struct kval l_k;		/* the constant */
+};
+
+/* value numbering table entry */
+struct sgv {
+   int g_op;			/* opcode */
+   int g_t;			/* type suffix */
+   int g_x;			/* first operand */
+   int g_y;			/* second operand */
+   int g_n;			/* integer operand */
+   char *g_s;			/* name or literal */
+   int g_z;			/* temporary holding the value */
+   int g_next;			/* next entry of the chain, -1 at the end */
+};
+
+/* undo log entry: variable u_v had value u_x, or temporary -1 - u_v
+   was not yet set */
+struct sundo {
+   int u_v;
+   int u_x;
+};
+
+/* store of v's value st_val at the end of a block, putting it back */
+struct sst {
+   int st_v;			/* the variable */
+   int st_val;			/* its value */
+   int st_next;			/* next store of the block, -1 at the end */
+};
+
+/* a function in SSA form */
+struct ssa {
+   struct qfunc *s_f;		/* the function */
+   struct cfg s_g;		/* its graph */
+   int s_lo;			/* its lowest temporary */
+   int s_ntemps;		/* length of the arrays indexed by temporary */
+   int *s_blk;			/* block of each quad */
+   char *s_dead;		/* quads to delete */
+   int *s_def;			/* quad setting each temporary, or -1 */
+   int *s_phiof;		/* phi setting each temporary, or -1 */
+   int *s_var;			/* variable each temporary is the address of */
+   int s_nvar;			/* temporaries in s_var */
+   int *s_repl;			/* temporary replacing each, or 0 */
+   char *s_seen;		/* temporaries set above, while renaming */
+   struct svar *s_vars;		/* the variables */
+   int s_nvars;			/* variables in s_vars */
+   struct sphi *s_phis;		/* the phis */
+   int s_nphis;			/* phis in s_phis */
+   int s_maxphis;		/* room in s_phis */
+   int *s_bphi;			/* first phi of each block, or -1 */
+   int *s_pre;			/* reachable blocks in dominator tree preorder */
+   int s_npre;			/* blocks in s_pre */
+   int *s_end;			/* place in s_pre past the subtree of each */
+   struct sundo *s_log;		/* what renaming has done, to be undone */
+   int s_nlog;			/* entries in the log */
+   int s_maxlog;		/* room in the log */
+   char *s_exec;		/* blocks found executable */
+   char *s_eexec;		/* edges found executable, two per block */
+   struct slat *s_lat;		/* what is known of each temporary */
+   int *s_use0;			/* first user of each temporary in s_uses */
+   int *s_uses;			/* users: quad index, or -1 - phi */
+   int *s_wl;			/* temporaries whose values have changed */
+   int s_nwl;			/* temporaries in s_wl */
+   int *s_ewl;			/* edges found executable, not yet followed */
+   int s_newl;			/* edges in s_ewl */
+};
+
+/*
+ * sroom - make room in array p, of *max elements of size bytes, for n
+ */
+static void *sroom(void *p, int *max, int n, unsigned size)
+{
+   if (n <= *max)
+      return (p);
+   *max = *max ? 2 * *max : 16;
+   if (*max < n)
+      *max = n;
+   if ((p = realloc(p, *max * size)) == NULL) {
+      yyerror("csem: out of space");
+      exit (1);
+   }
+   return (p);
+}
+
+/*
+ * sfind - the temporary t stands for
+ */
+static int sfind(struct ssa *s, int t)
+{
+   while (s->s_repl[t - s->s_lo])
+      t = s->s_repl[t - s->s_lo];
+   return (t);
+}
+
+/*
+ * saddr - the variable temporary t is the address of, or -1 if none
+ *         that is promoted
+ */
+static int saddr(struct ssa *s, int t)
+{
+   int v;
+
+   if (t < s->s_lo || t - s->s_lo >= s->s_nvar ||
+       (v = s->s_var[t - s->s_lo]) < 0 || !s->s_vars[v].v_ok)
+      return (-1);
+   return (v);
+}
+
+/*
+ * sfindvars - find the variable slots of s, and which may be promoted:
+ *             those only loaded and stored through, by one type
+ */
+static void sfindvars(struct ssa *s)
+{
+   struct qfunc *f = s->s_f;
+   struct quad *q;
+   struct svar *v;
+   int *tab, i, n;
+   unsigned h, size;
+
+   for (n = 0, q = f->f_quads; q < &f->f_quads[f->f_nquads]; q++)
+      if (q->q_op == Q_LOCAL || q->q_op == Q_PARAM)
+         n++;
+   s->s_vars = (struct svar *) oalloc(n * sizeof(struct svar));
+   for (size = 16; size < 2 * n; size *= 2)
+      ;
+   tab = (int *) oalloc(size * sizeof(int));
+   s->s_nvar = s->s_ntemps;
+   s->s_var = (int *) oalloc(s->s_nvar * sizeof(int));
+   for (i = 0; i < s->s_nvar; i++)
+      s->s_var[i] = -1;
+
+   for (q = f->f_quads; q < &f->f_quads[f->f_nquads]; q++) {
+      if (q->q_op != Q_LOCAL && q->q_op != Q_PARAM)
+         continue;
+      h = ((unsigned) q->q_n * 2 + (q->q_op == Q_PARAM)) * 2654435761u;
+      for (h &= size - 1; tab[h]; h = (h + 1) & (size - 1)) {
+         v = &s->s_vars[tab[h] - 1];
+         if (v->v_q->q_op == q->q_op && v->v_q->q_n == q->q_n)
+            break;
+      }
+      if (tab[h] == 0) {
+         v = &s->s_vars[s->s_nvars];
+         v->v_q = q;
+         v->v_ok = 1;
+         tab[h] = ++s->s_nvars;
+      }
+      s->s_var[q->q_z - s->s_lo] = tab[h] - 1;
+   }
+   free(tab);
+
+   for (q = f->f_quads; q < &f->f_quads[f->f_nquads]; q++) {
+      if (qusesx(q->q_op) && (i = saddr(s, q->q_x)) >= 0) {
+         v = &s->s_vars[i];
+         if (q->q_op != Q_ASSIGN || (v->v_t && v->v_t != q->q_t))
+            v->v_ok = 0;
+         v->v_t = q->q_t;
+      }
+      if (qusesy(q->q_op) && q->q_y && (i = saddr(s, q->q_y)) >= 0) {
+         v = &s->s_vars[i];
+         if (q->q_op != Q_DEREF || (v->v_t && v->v_t != q->q_t))
+            v->v_ok = 0;
+         v->v_t = q->q_t;
+      }
+   }
+}
+
+/*
+ * splace - place the phis of the promoted variables, on the iterated
+ *          dominance frontier of the blocks that store them
+ */
+static void splace(struct ssa *s)
+{
+   struct qfunc *f = s->s_f;
+   struct block *bl = s->s_g.c_blocks;
+   struct quad *q;
+   struct sphi *p;
+   int *st0, *st, *has, *work, *wl, nb = s->s_g.c_nblocks, n, v, i, b, d, k;
+
+   /* the blocks storing each variable */
+   st0 = (int *) oalloc((s->s_nvars + 1) * sizeof(int));
+   for (n = i = 0, q = f->f_quads; i < f->f_nquads; i++, q++)
+      if (q->q_op == Q_ASSIGN && (v = saddr(s, q->q_x)) >= 0) {
+         st0[v + 1]++;
+         n++;
+      }
+   for (v = 0; v < s->s_nvars; v++)
+      st0[v + 1] += st0[v];
+   st = (int *) oalloc(n * sizeof(int));
+   work = (int *) oalloc((s->s_nvars > nb ? s->s_nvars : nb) * sizeof(int));
+   for (i = 0, q = f->f_quads; i < f->f_nquads; i++, q++)
+      if (q->q_op == Q_ASSIGN && (v = saddr(s, q->q_x)) >= 0)
+         st[st0[v] + work[v]++] = s->s_blk[i];
+
+   has = (int *) oalloc(nb * sizeof(int));
+   wl = (int *) oalloc(nb * sizeof(int));
+   memset(work, 0, nb * sizeof(int));
+   s->s_bphi = (int *) oalloc(nb * sizeof(int));
+   for (b = 0; b < nb; b++)
+      s->s_bphi[b] = -1;
+   for (v = 0; v < s->s_nvars; v++) {
+      if (!s->s_vars[v].v_ok)
+         continue;
+      for (n = 0, i = st0[v]; i < st0[v + 1]; i++)
+         if (work[st[i]] != v + 1 && bl[st[i]].b_idom >= 0) {
+            work[st[i]] = v + 1;
+            wl[n++] = st[i];
+         }
+      while (n > 0) {
+         d = wl[--n];
+         for (k = 0; k < bl[d].b_ndf; k++) {
+            b = bl[d].b_df[k];
+            if (has[b] == v + 1)
+               continue;
+            has[b] = v + 1;
+            s->s_phis = (struct sphi *) sroom(s->s_phis, &s->s_maxphis,
+                                              s->s_nphis + 1,
+                                              sizeof(struct sphi));
+            p = &s->s_phis[s->s_nphis];
+            p->p_var = v;
+            p->p_blk = b;
+            p->p_z = qnewtemp(f);
+            p->p_arg = (int *) oalloc(bl[b].b_npred * sizeof(int));
+            p->p_next = s->s_bphi[b];
+            p->p_dead = p->p_const = 0;
+            s->s_bphi[b] = s->s_nphis++;
+            if (work[b] != v + 1) {
+               work[b] = v + 1;
+               wl[n++] = b;
+            }
+         }
+      }
+      s->s_vars[v].v_entry = s->s_vars[v].v_cur = qnewtemp(f);
+   }
+   free(st0);
+   free(st);
+   free(has);
+   free(work);
+   free(wl);
+}
+
+/*
+ * sdomtree - list the reachable blocks of s in dominator tree preorder,
+ *            children in the order of their blocks
+ */
+static void sdomtree(struct ssa *s)
+{
+   struct block *bl = s->s_g.c_blocks;
+   int *kid0, *kids, *stk, *size, nb = s->s_g.c_nblocks, b, i, sp;
+
+   kid0 = (int *) oalloc((nb + 1) * sizeof(int));
+   kids = (int *) oalloc(nb * sizeof(int));
+   for (b = 1; b < nb; b++)
+      if (bl[b].b_idom >= 0)
+         kid0[bl[b].b_idom + 1]++;
+   for (b = 0; b < nb; b++)
+      kid0[b + 1] += kid0[b];
+   size = (int *) oalloc(nb * sizeof(int));
+   for (b = 1; b < nb; b++)
+      if (bl[b].b_idom >= 0)
+         kids[kid0[bl[b].b_idom] + size[bl[b].b_idom]++] = b;
+
+   s->s_pre = (int *) oalloc(nb * sizeof(int));
+   s->s_end = (int *) oalloc(nb * sizeof(int));
+   stk = (int *) oalloc(nb * sizeof(int));
+   for (sp = 0, stk[sp++] = 0; sp > 0;) {
+      b = stk[--sp];
+      s->s_end[b] = s->s_npre;
+      s->s_pre[s->s_npre++] = b;
+      for (i = kid0[b + 1] - 1; i >= kid0[b]; i--)
+         stk[sp++] = kids[i];
+   }
+   memset(size, 0, nb * sizeof(int));
+   for (i = s->s_npre - 1; i >= 0; i--) {
+      b = s->s_pre[i];
+      size[b]++;
+      if (b != 0)
+         size[bl[b].b_idom] += size[b];
+   }
+   for (i = 0; i < s->s_npre; i++) {
+      b = s->s_pre[i];
+      s->s_end[b] += size[b];
+   }
+   free(kid0);
+   free(kids);
+   free(stk);
+   free(size);
+}
+
+/*
+ * slog - remember that variable v had value x, or with v < 0 that
+ *        temporary -1 - v was not yet set, for sundo
+ */
+static void slog(struct ssa *s, int v, int x)
+{
+   s->s_log = (struct sundo *) sroom(s->s_log, &s->s_maxlog, s->s_nlog + 1,
+                                     sizeof(struct sundo));
+   s->s_log[s->s_nlog].u_v = v;
+   s->s_log[s->s_nlog++].u_x = x;
+}
+
+/*
+ * sundo - undo what was done since the log held n entries
+ */
+static void sundo(struct ssa *s, int n)
+{
+   int v;
+
+   while (s->s_nlog > n) {
+      v = s->s_log[--s->s_nlog].u_v;
+      if (v >= 0)
+         s->s_vars[v].v_cur = s->s_log[s->s_nlog].u_x;
+      else
+         s->s_seen[-1 - v - s->s_lo] = 0;
+   }
+}
+
+/*
+ * sset - note that temporary t is set, and so may be used below
+ */
+static void sset(struct ssa *s, int t)
+{
+   s->s_seen[t - s->s_lo] = 1;
+   slog(s, -1 - t, 0);
+}
+
+/*
+ * sstore - make x the value of variable v
+ */
+static void sstore(struct ssa *s, int v, int x)
+{
+   slog(s, v, s->s_vars[v].v_cur);
+   s->s_vars[v].v_cur = x;
+}
+
+/*
+ * srenblock - rename the loads and stores of block b, and give the phis
+ *             of its successors their operands from it; return zero if
+ *             a temporary is used where its setting does not dominate
+ */
+static int srenblock(struct ssa *s, int b)
+{
+   struct block *bl = s->s_g.c_blocks, *t;
+   struct quad *q;
+   int i, j, k, p, v;
+
+   for (p = s->s_bphi[b]; p >= 0; p = s->s_phis[p].p_next) {
+      sstore(s, s->s_phis[p].p_var, s->s_phis[p].p_z);
+      sset(s, s->s_phis[p].p_z);
+   }
+   for (i = bl[b].b_first; i < bl[b].b_last; i++) {
+      q = &s->s_f->f_quads[i];
+      if ((qusesx(q->q_op) && !s->s_seen[sfind(s, q->q_x) - s->s_lo]) ||
+          (qusesy(q->q_op) && q->q_y &&
+           !s->s_seen[sfind(s, q->q_y) - s->s_lo]))
+         return (0);
+      if (q->q_op == Q_DEREF && (v = saddr(s, q->q_y)) >= 0) {
+         s->s_repl[q->q_z - s->s_lo] = s->s_vars[v].v_cur;
+         s->s_dead[i] = 1;
+      }
+      else if (q->q_op == Q_ASSIGN && (v = saddr(s, q->q_x)) >= 0) {
+         sstore(s, v, sfind(s, q->q_y));
+         if (q->q_z)
+            s->s_repl[q->q_z - s->s_lo] = s->s_vars[v].v_cur;
+         s->s_dead[i] = 1;
+      }
+      else if ((q->q_op == Q_LOCAL || q->q_op == Q_PARAM) &&
+               saddr(s, q->q_z) >= 0)
+         s->s_dead[i] = 1;
+      if (q->q_z)
+         sset(s, q->q_z);
+   }
+   for (k = 0; k < bl[b].b_nsucc; k++) {
+      t = &bl[bl[b].b_succ[k]];
+      for (j = 0; t->b_pred[j] != b; j++)
+         ;
+      for (p = s->s_bphi[t - bl]; p >= 0; p = s->s_phis[p].p_next)
+         s->s_phis[p].p_arg[j] = s->s_vars[s->s_phis[p].p_var].v_cur;
+   }
+   return (1);
+}
+
+/*
+ * srename - rename over the dominator tree, return zero if the function
+ *           is not in a form that can be
+ */
+static int srename(struct ssa *s)
+{
+   int *stk, *mark, k, b, sp = 0, ok = 1;
+
+   stk = (int *) oalloc(s->s_g.c_nblocks * sizeof(int));
+   mark = (int *) oalloc(s->s_g.c_nblocks * sizeof(int));
+   for (k = 0; k < s->s_npre && ok; k++) {
+      b = s->s_pre[k];
+      while (sp > 0 && k >= s->s_end[stk[sp - 1]])
+         sundo(s, mark[stk[--sp]]);
+      mark[b] = s->s_nlog;
+      stk[sp++] = b;
+      ok = srenblock(s, b);
+   }
+   sundo(s, 0);
+   free(stk);
+   free(mark);
+   return (ok);
+}
+
+/*
+ * sedgeexec - nonzero if the edge from block a to block b is executable
+ */
+static int sedgeexec(struct ssa *s, int a, int b)
+{
+   struct block *p = &s->s_g.c_blocks[a];
+
+   return ((p->b_succ[0] == b && s->s_eexec[2 * a]) ||
+           (p->b_nsucc > 1 && p->b_succ[1] == b && s->s_eexec[2 * a + 1]));
+}
+
+/*
+ * sedge - find the edge from block b to its successor k executable
+ */
+static void sedge(struct ssa *s, int b, int k)
+{
+   if (!s->s_eexec[2 * b + k]) {
+      s->s_eexec[2 * b + k] = 1;
+      s->s_ewl[s->s_newl++] = 2 * b + k;
+   }
+}
+
+/*
+ * slower - lower what is known of temporary t to meet l
+ */
+static void slower(struct ssa *s, int t, struct slat *l)
+{
+   struct slat *o = &s->s_lat[t - s->s_lo];
+
+   if (l->l_s == STOP || o->l_s == SBOT)
+      return;
+   if (o->l_s == STOP)
+      *o = *l;
+   else if (l->l_s == SBOT || l->l_k.k_t != o->l_k.k_t ||
+            memcmp(&l->l_k, &o->l_k, sizeof(struct kval)) != 0)
+      o->l_s = SBOT;
+   else
+      return;
+   s->s_wl[s->s_nwl++] = t;
+}
+
+/*
+ * sevalq - find what is known of the value of quad i, or for a branch,
+ *          where it goes
+ */
+static void sevalq(struct ssa *s, int i)
+{
+   struct quad *q = &s->s_f->f_quads[i];
+   struct block *b = &s->s_g.c_blocks[s->s_blk[i]];
+   struct slat r, *a = NULL, *c = NULL;
+   int k;
+
+   if (qusesx(q->q_op))
+      a = &s->s_lat[sfind(s, q->q_x) - s->s_lo];
+   if (qusesy(q->q_op) && q->q_y)
+      c = &s->s_lat[sfind(s, q->q_y) - s->s_lo];
+   if (q->q_op == Q_BT) {
+      if (a->l_s == SCON && b->b_nsucc == 2)
+         sedge(s, s->s_blk[i], (a->l_k.k_t == 'f' ? a->l_k.k_d != 0 :
+                                a->l_k.k_i != 0) ? 0 : 1);
+      else if (a->l_s != STOP)
+         for (k = 0; k < b->b_nsucc; k++)
+            sedge(s, s->s_blk[i], k);
+      return;
+   }
+   if (q->q_z == 0)
+      return;
+   r.l_s = SBOT;
+   if (q->q_op == Q_CON || q->q_op == Q_CV || q->q_op == Q_NEG ||
+       q->q_op == Q_COM || (q->q_op >= Q_ADD && q->q_op <= Q_GE)) {
+      if ((a && a->l_s == STOP) || (c && c->l_s == STOP))
+         return;
+      if ((a == NULL || a->l_s == SCON) && (c == NULL || c->l_s == SCON) &&
+          kfold(q, a ? &a->l_k : NULL, c ? &c->l_k : NULL, &r.l_k))
+         r.l_s = SCON;
+   }
+   slower(s, q->q_z, &r);
+}
+
+/*
+ * sevalphi - find what is known of the value of phi p, from the edges
+ *            into its block that are executable
+ */
+static void sevalphi(struct ssa *s, int p)
+{
+   struct sphi *ph = &s->s_phis[p];
+   struct block *b = &s->s_g.c_blocks[ph->p_blk];
+   struct slat r, *a;
+   int j;
+
+   r.l_s = STOP;
+   for (j = 0; j < b->b_npred && r.l_s != SBOT; j++) {
+      if (!sedgeexec(s, b->b_pred[j], ph->p_blk))
+         continue;
+      a = &s->s_lat[sfind(s, ph->p_arg[j]) - s->s_lo];
+      if (a->l_s == STOP)
+         continue;
+      if (r.l_s == STOP)
+         r = *a;
+      else if (a->l_s == SBOT || a->l_k.k_t != r.l_k.k_t ||
+               memcmp(&a->l_k, &r.l_k, sizeof(struct kval)) != 0)
+         r.l_s = SBOT;
+   }
+   slower(s, ph->p_z, &r);
+}
+
+/*
+ * svisit - evaluate block b, found executable
+ */
+static void svisit(struct ssa *s, int b)
+{
+   struct block *bl = &s->s_g.c_blocks[b];
+   int i, k;
+
+   for (i = s->s_bphi[b]; i >= 0; i = s->s_phis[i].p_next)
+      sevalphi(s, i);
+   for (i = bl->b_first; i < bl->b_last; i++)
+      if (!s->s_dead[i])
+         sevalq(s, i);
+   if (s->s_f->f_quads[bl->b_last - 1].q_op != Q_BT)
+      for (k = 0; k < bl->b_nsucc; k++)
+         sedge(s, b, k);
+}
+
+/*
+ * suses - list the users of each temporary, by what they stand for
+ */
+static void suses(struct ssa *s)
+{
+   struct block *bl = s->s_g.c_blocks;
+   struct quad *q;
+   struct sphi *p;
+   int i, j, n, pass;
+
+   s->s_use0 = (int *) oalloc((s->s_ntemps + 1) * sizeof(int));
+   for (pass = 0; pass < 2; pass++) {
+      for (i = 0, q = s->s_f->f_quads; i < s->s_f->f_nquads; i++, q++) {
+         if (s->s_dead[i] || bl[s->s_blk[i]].b_idom < 0)
+            continue;
+         if (qusesx(q->q_op)) {
+            n = sfind(s, q->q_x) - s->s_lo;
+            if (pass)
+               s->s_uses[s->s_use0[n]++] = i;
+            else
+               s->s_use0[n + 1]++;
+         }
+         if (qusesy(q->q_op) && q->q_y) {
+            n = sfind(s, q->q_y) - s->s_lo;
+            if (pass)
+               s->s_uses[s->s_use0[n]++] = i;
+            else
+               s->s_use0[n + 1]++;
+         }
+      }
+      for (p = s->s_phis; p < &s->s_phis[s->s_nphis]; p++)
+         for (j = 0; j < bl[p->p_blk].b_npred; j++)
+            if (p->p_arg[j]) {
+               n = sfind(s, p->p_arg[j]) - s->s_lo;
+               if (pass)
+                  s->s_uses[s->s_use0[n]++] = -1 - (p - s->s_phis);
+               else
+                  s->s_use0[n + 1]++;
+            }
+      if (pass == 0) {
+         for (i = 0; i < s->s_ntemps; i++)
+            s->s_use0[i + 1] += s->s_use0[i];
+         s->s_uses = (int *) oalloc(s->s_use0[s->s_ntemps] * sizeof(int));
+      }
+      else {
+         for (i = s->s_ntemps; i > 0; i--)
+            s->s_use0[i] = s->s_use0[i - 1];
+         s->s_use0[0] = 0;
+      }
+   }
+}
+
+/*
+ * ssccp - sparse conditional constant propagation, return the number of
+ *         quads removed or made constant
+ *
+ * Blocks are evaluated as edges into them are found executable, and the
+ * users of a temporary again as what is known of it is lowered.  Then a
+ * quad found to make a nonnegative int constant becomes that constant,
+ * a branch on a constant goes or falls through always, and a block never
+ * found executable is deleted.
+ */
+static int ssccp(struct ssa *s)
+{
+   struct block *bl = s->s_g.c_blocks;
+   struct quad *q;
+   struct slat *l;
+   struct sphi *p;
+   int nb = s->s_g.c_nblocks, changed = 0, i, e, b, u, t;
+   char buf[16];
+
+   s->s_exec = oalloc(nb);
+   s->s_eexec = oalloc(2 * nb);
+   s->s_ewl = (int *) oalloc(2 * nb * sizeof(int));
+   s->s_wl = (int *) oalloc(2 * s->s_ntemps * sizeof(int));
+   s->s_lat = (struct slat *) oalloc(s->s_ntemps * sizeof(struct slat));
+   for (i = 0; i < s->s_nvars; i++)
+      if (s->s_vars[i].v_ok)
+         s->s_lat[s->s_vars[i].v_entry - s->s_lo].l_s = SBOT;
+   suses(s);
+
+   s->s_exec[0] = 1;
+   svisit(s, 0);
+   while (s->s_newl > 0 || s->s_nwl > 0)
+      if (s->s_newl > 0) {
+         e = s->s_ewl[--s->s_newl];
+         b = bl[e / 2].b_succ[e % 2];
+         if (!s->s_exec[b]) {
+            s->s_exec[b] = 1;
+            svisit(s, b);
+         }
+         else
+            for (i = s->s_bphi[b]; i >= 0; i = s->s_phis[i].p_next)
+               sevalphi(s, i);
+      }
+      else {
+         t = s->s_wl[--s->s_nwl] - s->s_lo;
+         for (i = s->s_use0[t]; i < s->s_use0[t + 1]; i++)
+            if ((u = s->s_uses[i]) >= 0) {
+               if (s->s_exec[s->s_blk[u]])
+                  sevalq(s, u);
+            }
+            else if (s->s_exec[s->s_phis[-1 - u].p_blk])
+               sevalphi(s, -1 - u);
+      }
+
+   for (p = s->s_phis; p < &s->s_phis[s->s_nphis]; p++) {
+      l = &s->s_lat[p->p_z - s->s_lo];
+      p->p_const = l->l_s == SCON && l->l_k.k_t == 'i' && l->l_k.k_i >= 0;
+   }
+   for (i = 0, q = s->s_f->f_quads; i < s->s_f->f_nquads; i++, q++) {
+      if (s->s_dead[i])
+         continue;
+      if (!s->s_exec[s->s_blk[i]]) {
+         if (q->q_op != Q_FEND) {
+            s->s_dead[i] = 1;
+            changed++;
+         }
+         continue;
+      }
+      if (q->q_op == Q_BT) {
+         l = &s->s_lat[sfind(s, q->q_x) - s->s_lo];
+         if (l->l_s != SCON)
+            continue;
+         if (l->l_k.k_t == 'f' ? l->l_k.k_d != 0 : l->l_k.k_i != 0) {
+            q->q_op = Q_BR;
+            q->q_x = 0;
+         }
+         else
+            s->s_dead[i] = 1;
+         changed++;
+         continue;
+      }
+      if (q->q_z == 0 || q->q_op == Q_CON)
+         continue;
+      l = &s->s_lat[q->q_z - s->s_lo];
+      if (l->l_s != SCON || l->l_k.k_t != 'i' || l->l_k.k_i < 0)
+         continue;
+      sprintf(buf, "%d", l->l_k.k_i);
+      q->q_op = Q_CON;
+      q->q_t = q->q_x = q->q_y = q->q_n = 0;
+      q->q_s = slookup(buf);
+      changed++;
+   }
+   return (changed);
+}
+
+/*
+ * sgvn - global value numbering, return the number of quads removed
+ *
+ * The table holds the pure quads of the blocks dominating the one being
+ * numbered, so a quad found in it is computed on every path here, and is
+ * deleted, its result renamed to the one found.
+ */
+static int sgvn(struct ssa *s)
+{
+   struct block *bl;
+   struct sphi *p;
+   struct quad *q;
+   struct sgv *tab, *g;
+   int *head, *stk, *mark, k, b, i, j, a, w, x, y, sp = 0, n = 0;
+   int removed = 0;
+   unsigned h, size;
+
+   for (size = 16; size < 2 * s->s_f->f_nquads; size *= 2)
+      ;
+   head = (int *) oalloc(size * sizeof(int));
+   memset(head, -1, size * sizeof(int));
+   tab = (struct sgv *) oalloc((s->s_f->f_nquads + 1) * sizeof(struct sgv));
+   stk = (int *) oalloc(s->s_g.c_nblocks * sizeof(int));
+   mark = (int *) oalloc(s->s_g.c_nblocks * sizeof(int));
+   for (k = 0; k < s->s_npre; k++) {
+      b = s->s_pre[k];
+      while (sp > 0 && k >= s->s_end[stk[sp - 1]])
+         for (j = mark[stk[--sp]]; n > j;) {
+            g = &tab[--n];
+            h = g->g_op * 31u + g->g_t;
+            h = h * 1000003u ^ g->g_x;
+            h = h * 1000003u ^ g->g_y;
+            h = h * 1000003u ^ g->g_n;
+            h = h * 1000003u ^ (unsigned) (unsigned long) g->g_s;
+            head[h & (size - 1)] = g->g_next;
+         }
+      mark[b] = n;
+      stk[sp++] = b;
+      if (!s->s_exec[b])
+         continue;
+      bl = &s->s_g.c_blocks[b];
+
+      for (i = s->s_bphi[b]; i >= 0; i = p->p_next) {
+         p = &s->s_phis[i];
+         if (p->p_const)
+            continue;
+         for (w = 0, j = 0; j < bl->b_npred && w >= 0; j++) {
+            if (!sedgeexec(s, bl->b_pred[j], b) ||
+                (a = sfind(s, p->p_arg[j])) == p->p_z)
+               continue;
+            w = w == 0 || w == a ? a : -1;
+         }
+         if (w > 0) {
+            s->s_repl[p->p_z - s->s_lo] = w;
+            p->p_dead = 1;
+         }
+      }
+
+      for (i = bl->b_first; i < bl->b_last; i++) {
+         q = &s->s_f->f_quads[i];
+         if (s->s_dead[i] || q->q_z == 0 || !(qops[q->q_op].o_flags & O_PURE))
+            continue;
+         x = qusesx(q->q_op) ? sfind(s, q->q_x) : 0;
+         y = qusesy(q->q_op) && q->q_y ? sfind(s, q->q_y) : 0;
+         if ((qops[q->q_op].o_flags & O_COMM) && x > y) {
+            a = x;
+            x = y;
+            y = a;
+         }
+         h = q->q_op * 31u + q->q_t;
+         h = h * 1000003u ^ x;
+         h = h * 1000003u ^ y;
+         h = h * 1000003u ^ q->q_n;
+         h = h * 1000003u ^ (unsigned) (unsigned long) q->q_s;
+         h &= size - 1;
+         for (j = head[h]; j >= 0; j = tab[j].g_next) {
+            g = &tab[j];
+            if (g->g_op == q->q_op && g->g_t == q->q_t && g->g_x == x &&
+                g->g_y == y && g->g_n == q->q_n && g->g_s == q->q_s)
+               break;
+         }
+         if (j >= 0) {
+            s->s_repl[q->q_z - s->s_lo] = tab[j].g_z;
+            s->s_dead[i] = 1;
+            removed++;
+            continue;
+         }
+         g = &tab[n];
+         g->g_op = q->q_op;
+         g->g_t = q->q_t;
+         g->g_x = x;
+         g->g_y = y;
+         g->g_n = q->q_n;
+         g->g_s = q->q_s;
+         g->g_z = q->q_z;
+         g->g_next = head[h];
+         head[h] = n++;
+      }
+   }
+   free(head);
+   free(tab);
+   free(stk);
+   free(mark);
+   return (removed);
+}
+
+/*
+ * semit - append a quad to g
+ */
+static struct quad *semit(struct qfunc *g)
+{
+   return (qinsert(g, g->f_nquads, 1));
+}
+
+/*
+ * sload - append to g a load of variable v into temporary z
+ */
+static void sload(struct qfunc *g, struct svar *v, int z)
+{
+   struct quad *q = semit(g);
+
+   q->q_op = Q_DEREF;
+   q->q_t = v->v_t;
+   q->q_z = z;
+   q->q_y = v->v_addr;
+}
+
+/*
+ * sputback - append to g the stores of list i of st
+ */
+static void sputback(struct qfunc *g, struct ssa *s, struct sst *st, int i)
+{
+   struct quad *q;
+
+   for (; i >= 0; i = st[i].st_next) {
+      q = semit(g);
+      q->q_op = Q_ASSIGN;
+      q->q_t = s->s_vars[st[i].st_v].v_t;
+      q->q_x = s->s_vars[st[i].st_v].v_addr;
+      q->q_y = st[i].st_val;
+   }
+}
+
+/*
+ * sleave - leave SSA form, writing the quads of s afresh
+ */
+static void sleave(struct ssa *s)
+{
+   struct qfunc *f = s->s_f, g;
+   struct block *bl = s->s_g.c_blocks;
+   struct quad *q, *r;
+   struct sphi *p;
+   struct svar *v;
+   struct sst *st = NULL;
+   char *used, buf[16];
+   int *wl, *sthead, nst = 0, maxst = 0, n, b, i, j, a, last;
+
+   /* the phis still used, and the values they are of */
+   used = oalloc(s->s_ntemps);
+   for (i = 0, q = f->f_quads; i < f->f_nquads; i++, q++)
+      if (!s->s_dead[i]) {
+         if (qusesx(q->q_op))
+            used[sfind(s, q->q_x) - s->s_lo] = 1;
+         if (qusesy(q->q_op) && q->q_y)
+            used[sfind(s, q->q_y) - s->s_lo] = 1;
+      }
+   wl = (int *) oalloc((s->s_nphis + 1) * sizeof(int));
+   for (n = i = 0; i < s->s_nphis; i++)
+      if (!s->s_phis[i].p_dead && used[s->s_phis[i].p_z - s->s_lo])
+         wl[n++] = i;
+   while (n > 0) {
+      p = &s->s_phis[wl[--n]];
+      if (p->p_const)
+         continue;
+      for (j = 0; j < bl[p->p_blk].b_npred; j++) {
+         if (!sedgeexec(s, bl[p->p_blk].b_pred[j], p->p_blk))
+            continue;
+         a = sfind(s, p->p_arg[j]);
+         if (!used[a - s->s_lo]) {
+            used[a - s->s_lo] = 1;
+            if (s->s_phiof[a - s->s_lo] >= 0)
+               wl[n++] = s->s_phiof[a - s->s_lo];
+         }
+      }
+   }
+
+   /* the stores putting each variable back where a phi loads it */
+   sthead = (int *) oalloc(s->s_g.c_nblocks * sizeof(int));
+   memset(sthead, -1, s->s_g.c_nblocks * sizeof(int));
+   for (p = s->s_phis; p < &s->s_phis[s->s_nphis]; p++) {
+      if (p->p_dead || p->p_const || !used[p->p_z - s->s_lo])
+         continue;
+      v = &s->s_vars[p->p_var];
+      v->v_addr = 1;
+      for (j = 0; j < bl[p->p_blk].b_npred; j++) {
+         b = bl[p->p_blk].b_pred[j];
+         if (!sedgeexec(s, b, p->p_blk))
+            continue;
+         a = sfind(s, p->p_arg[j]);
+         if ((a == v->v_entry && b == 0) ||
+             ((i = s->s_phiof[a - s->s_lo]) >= 0 &&
+              s->s_phis[i].p_var == p->p_var && s->s_phis[i].p_blk == b &&
+              !s->s_phis[i].p_const))
+            continue;
+         for (i = sthead[b]; i >= 0 && st[i].st_v != p->p_var;
+              i = st[i].st_next)
+            ;
+         if (i >= 0)
+            continue;
+         st = (struct sst *) sroom(st, &maxst, nst + 1, sizeof(struct sst));
+         st[nst].st_v = p->p_var;
+         st[nst].st_val = a;
+         st[nst].st_next = sthead[b];
+         sthead[b] = nst++;
+      }
+   }
+   for (v = s->s_vars; v < &s->s_vars[s->s_nvars]; v++)
+      if (v->v_ok && (v->v_addr || used[v->v_entry - s->s_lo]))
+         v->v_addr = qnewtemp(f);
+      else
+         v->v_addr = 0;
+
+   memset(&g, 0, sizeof(g));
+   for (b = 0; b < s->s_g.c_nblocks; b++) {
+      i = bl[b].b_first;
+      if (b == 0) {
+         for (; i < bl[b].b_last && (f->f_quads[i].q_op == Q_FUNC ||
+                                     f->f_quads[i].q_op == Q_FORMAL ||
+                                     f->f_quads[i].q_op == Q_LOCALLOC ||
+                                     f->f_quads[i].q_op == Q_ALLOC); i++)
+            *semit(&g) = f->f_quads[i];
+         if (i < bl[b].b_last && f->f_quads[i].q_op == Q_BGNSTMT)
+            *semit(&g) = f->f_quads[i++];
+         for (v = s->s_vars; v < &s->s_vars[s->s_nvars]; v++)
+            if (v->v_addr) {
+               q = semit(&g);
+               *q = *v->v_q;
+               q->q_z = v->v_addr;
+            }
+         for (v = s->s_vars; v < &s->s_vars[s->s_nvars]; v++)
+            if (v->v_addr && used[v->v_entry - s->s_lo])
+               sload(&g, v, v->v_entry);
+      }
+      else if (s->s_exec[b]) {
+         if (f->f_quads[i].q_op == Q_LABEL)
+            *semit(&g) = f->f_quads[i++];
+         for (j = s->s_bphi[b]; j >= 0; j = s->s_phis[j].p_next) {
+            p = &s->s_phis[j];
+            if (p->p_dead || !used[p->p_z - s->s_lo])
+               continue;
+            if (!p->p_const) {
+               sload(&g, &s->s_vars[p->p_var], p->p_z);
+               continue;
+            }
+            sprintf(buf, "%d", s->s_lat[p->p_z - s->s_lo].l_k.k_i);
+            q = semit(&g);
+            q->q_op = Q_CON;
+            q->q_z = p->p_z;
+            q->q_s = slookup(buf);
+         }
+      }
+
+      last = bl[b].b_last - 1;
+      if (s->s_dead[last] || (f->f_quads[last].q_op != Q_BT &&
+                              f->f_quads[last].q_op != Q_BR &&
+                              f->f_quads[last].q_op != Q_GOTO &&
+                              f->f_quads[last].q_op != Q_RET))
+         last = bl[b].b_last;
+      for (; i < bl[b].b_last; i++) {
+         if (i == last)
+            sputback(&g, s, st, sthead[b]);
+         if (s->s_dead[i])
+            continue;
+         r = semit(&g);
+         *r = f->f_quads[i];
+         if (qusesx(r->q_op))
+            r->q_x = sfind(s, r->q_x);
+         if (qusesy(r->q_op) && r->q_y)
+            r->q_y = sfind(s, r->q_y);
+      }
+      if (last == bl[b].b_last)
+         sputback(&g, s, st, sthead[b]);
+   }
+   g.f_ntemp = f->f_ntemp;
+   g.f_nlabel = f->f_nlabel;
+   free(f->f_quads);
+   *f = g;
+   free(used);
+   free(wl);
+   free(sthead);
+   free(st);
+}
+
+/*
+ * sfree - release the storage of s
+ */
+static void sfree(struct ssa *s)
+{
+   struct sphi *p;
+
+   for (p = s->s_phis; p < &s->s_phis[s->s_nphis]; p++)
+      free(p->p_arg);
+   free(s->s_phis);
+   free(s->s_blk);
+   free(s->s_dead);
+   free(s->s_def);
+   free(s->s_phiof);
+   free(s->s_var);
+   free(s->s_repl);
+   free(s->s_seen);
+   free(s->s_vars);
+   free(s->s_bphi);
+   free(s->s_pre);
+   free(s->s_end);
+   free(s->s_log);
+   free(s->s_exec);
+   free(s->s_eexec);
+   free(s->s_lat);
+   free(s->s_use0);
+   free(s->s_uses);
+   free(s->s_wl);
+   free(s->s_ewl);
+   cfgfree(&s->s_g);
+}
+
+/*
+ * ssa - put f in SSA form, propagate constants and number values over
+ *       it, and take it out again; return number of quads removed or
+ *       made constant
+ *
+ * A function is left alone if a temporary in it is set twice or used
+ * where its setting does not dominate, which csem does not make, or if
+ * its branches are left on backpatch labels.
+ */
+int ssa(struct qfunc *f)
+{
+   struct ssa s;
+   struct quad *q;
+   int ntemp = f->f_ntemp, changed = 0, hi, i, b;
+
+   if (qbpatch || f->f_nquads == 0 || f->f_quads[0].q_op != Q_FUNC)
+      return (0);
+   memset(&s, 0, sizeof(s));
+   s.s_f = f;
+   qtemps(f, &s.s_lo, &hi);
+   s.s_ntemps = f->f_ntemp - s.s_lo + 1;
+   cfgbuild(&s.s_g, f);
+   cfgdf(&s.s_g);
+   s.s_blk = (int *) oalloc(f->f_nquads * sizeof(int));
+   for (b = 0; b < s.s_g.c_nblocks; b++)
+      for (i = s.s_g.c_blocks[b].b_first; i < s.s_g.c_blocks[b].b_last; i++)
+         s.s_blk[i] = b;
+   s.s_dead = oalloc(f->f_nquads);
+   sfindvars(&s);
+   splace(&s);
+
+   s.s_ntemps = f->f_ntemp - s.s_lo + 1;
+   s.s_def = (int *) oalloc(s.s_ntemps * sizeof(int));
+   s.s_phiof = (int *) oalloc(s.s_ntemps * sizeof(int));
+   s.s_repl = (int *) oalloc(s.s_ntemps * sizeof(int));
+   s.s_seen = oalloc(s.s_ntemps);
+   for (i = 0; i < s.s_ntemps; i++)
+      s.s_def[i] = s.s_phiof[i] = -1;
+   for (i = 0; i < s.s_nphis; i++)
+      s.s_phiof[s.s_phis[i].p_z - s.s_lo] = i;
+   for (i = 0; i < s.s_nvars; i++)
+      if (s.s_vars[i].v_ok)
+         s.s_seen[s.s_vars[i].v_entry - s.s_lo] = 1;
+   for (i = 0, q = f->f_quads; i < f->f_nquads; i++, q++)
+      if (q->q_z) {
+         if (s.s_def[q->q_z - s.s_lo] >= 0)
+            break;
+         s.s_def[q->q_z - s.s_lo] = i;
+      }
+   sdomtree(&s);
+   if (i < f->f_nquads || !srename(&s)) {
+      f->f_ntemp = ntemp;
+      sfree(&s);
+      return (0);
+   }
+
+   for (i = 0; i < f->f_nquads; i++)
+      changed += s.s_dead[i];
+   changed += ssccp(&s);
+   changed += sgvn(&s);
+   sleave(&s);
+   sfree(&s);
+   return (changed);
+}
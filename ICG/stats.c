@@ -0,0 +1,309 @@
+/* time spent in each phase of compiling, for -p, and the rest of -stats */
+
+# include <stdio.h>
+# include <stdlib.h>
+# include <string.h>
+# include <time.h>
+# include <pthread.h>
+# include "cc.h"
+# include "quad.h"
+# include "opt.h"
+# include "stats.h"
+
+extern void yyerror(const char *);
+
+/*
+ * A thread is in one phase at a time, or in none.  tenter moves it to
+ * another and charges the time since it last moved to the one it was in,
+ * so a phase calling into another, as the semantic actions call the
+ * optimizer, is charged only for its own time.  A thread adds up its
+ * times by itself and hands them on with tflush, once a file or a
+ * function is done.  Nothing is timed without -p or -stats.
+ *
+ * -stats counts what a thread allocates and its most semantic records
+ * the same way.  The chains of the identifier table are counted as they
+ * stand at the end of each file, those of the string table, which a
+ * thread keeps from one file to the next, once when it has compiled its
+ * last, and the temporaries and labels of each function as it is
+ * written, so in the order of the output.
+ */
+
+# define NCHAIN 9			/* lengths counted apart, the last
+					   and longer together */
+
+static char *phname[PH_N] = {
+   "read", "lex", "parse", "semantic", "optimize", "write"
+};
+
+static char *tbname[TB_N] = { "identifiers", "strings" };
+
+int sstat = 0;				/* -stats: 0, ST_TEXT or ST_JSON */
+
+static UNIT int tcur = -1;		/* phase this thread is in */
+static UNIT double tlast;		/* when it entered it, in msec */
+static UNIT double tacc[PH_N];		/* msec it has spent in each */
+UNIT unsigned long tbytes;		/* bytes it has had from alloc */
+UNIT int trecs;				/* most semantic records it has held */
+static UNIT unsigned long tlen[TB_N][NCHAIN]; /* chains of each length */
+static UNIT unsigned tlong[TB_N];	/* longest chain of each table */
+static UNIT char *tsrc;			/* file it is compiling */
+
+/* a function written, for -stats */
+struct tfn {
+   char *n_name;			/* its name */
+   char *n_file;			/* its file, NULL for stdin */
+   int n_temps;				/* distinct temporaries it uses */
+   int n_labels;			/* labels in it */
+};
+
+/* totals of the threads, for tstats */
+static pthread_mutex_t tlock = PTHREAD_MUTEX_INITIALIZER;
+static double ttotal[PH_N];
+static unsigned long sbytes;		/* total of tbytes */
+static int srecs;			/* most of trecs */
+static unsigned long slen[TB_N][NCHAIN]; /* totals of tlen */
+static unsigned slong[TB_N];		/* most of tlong */
+static struct tfn *sfns;		/* functions in the order written */
+static int snfns;			/* in sfns */
+static int smaxfns;			/* room in sfns */
+
+/*
+ * tnow - the time in msec
+ */
+static double tnow()
+{
+   struct timespec ts;
+
+   clock_gettime(CLOCK_MONOTONIC, &ts);
+   return (ts.tv_sec * 1000.0 + ts.tv_nsec / 1e6);
+}
+
+/*
+ * tenter - put this thread in phase ph, -1 for none, return the phase
+ *          it was in
+ */
+int tenter(int ph)
+{
+   double t;
+   int old = tcur;
+
+   if (!ostat && !sstat)
+      return (old);
+   t = tnow();
+   if (tcur >= 0)
+      tacc[tcur] += t - tlast;
+   tlast = t;
+   tcur = ph;
+   return (old);
+}
+
+/*
+ * tflush - add the times and counts of this thread to the totals
+ */
+void tflush()
+{
+   int i, j;
+
+   if (!ostat && !sstat)
+      return;
+   tenter(tcur);
+   pthread_mutex_lock(&tlock);
+   for (i = 0; i < PH_N; i++) {
+      ttotal[i] += tacc[i];
+      tacc[i] = 0;
+   }
+   sbytes += tbytes;
+   tbytes = 0;
+   if (trecs > srecs)
+      srecs = trecs;
+   for (i = 0; i < TB_N; i++) {
+      for (j = 0; j < NCHAIN; j++) {
+         slen[i][j] += tlen[i][j];
+         tlen[i][j] = 0;
+      }
+      if (tlong[i] > slong[i])
+         slong[i] = tlong[i];
+      tlong[i] = 0;
+   }
+   pthread_mutex_unlock(&tlock);
+}
+
+/*
+ * tchain - count a chain of n entries in table tb, 0 for an empty slot
+ */
+void tchain(int tb, unsigned n)
+{
+   tlen[tb][n < NCHAIN ? n : NCHAIN - 1]++;
+   if (n > tlong[tb])
+      tlong[tb] = n;
+}
+
+/*
+ * tsource - note that this thread is compiling file name, NULL for stdin
+ */
+void tsource(char *name)
+{
+   tsrc = name;
+}
+
+/*
+ * tfunc - note the distinct temporaries and the labels of f, if it is a
+ *         function
+ */
+void tfunc(struct qfunc *f)
+{
+   struct quad *q;
+   struct tfn *p;
+   char *name = NULL, *seen;
+   int lo, hi, temps = 0, labels = 0;
+
+   for (q = f->f_quads; q < &f->f_quads[f->f_nquads]; q++)
+      if (q->q_op == Q_FUNC)
+         name = q->q_s;
+      else if (q->q_op == Q_LABEL)
+         labels++;
+   if (name == NULL)
+      return;
+   qtemps(f, &lo, &hi);
+   for (q = f->f_quads; q < &f->f_quads[f->f_nquads]; q++) {
+      if (qusesx(q->q_op) && q->q_x > hi)
+         hi = q->q_x;
+      if (qusesy(q->q_op) && q->q_y > hi)
+         hi = q->q_y;
+   }
+   if ((seen = calloc(hi >= lo ? hi - lo + 1 : 1, 1)) == NULL) {
+      yyerror("csem: out of space");
+      exit (1);
+   }
+   for (q = f->f_quads; q < &f->f_quads[f->f_nquads]; q++) {
+      if (q->q_z)
+         seen[q->q_z - lo] = 1;
+      if (qusesx(q->q_op))
+         seen[q->q_x - lo] = 1;
+      if (qusesy(q->q_op) && q->q_y)
+         seen[q->q_y - lo] = 1;
+   }
+   for (; hi >= lo; hi--)
+      temps += seen[hi - lo];
+   free(seen);
+   pthread_mutex_lock(&tlock);
+   if (snfns >= smaxfns) {
+      smaxfns = smaxfns ? 2 * smaxfns : 256;
+      if ((sfns = realloc(sfns, smaxfns * sizeof(struct tfn))) == NULL) {
+         yyerror("csem: out of space");
+         exit (1);
+      }
+   }
+   p = &sfns[snfns++];
+   if ((p->n_name = malloc(strlen(name) + 1)) == NULL) {
+      yyerror("csem: out of space");
+      exit (1);
+   }
+   strcpy(p->n_name, name);
+   p->n_file = tsrc;
+   p->n_temps = temps;
+   p->n_labels = labels;
+   pthread_mutex_unlock(&tlock);
+}
+
+/*
+ * tstats - print the time spent in each phase on fp
+ */
+void tstats(FILE *fp)
+{
+   int i;
+
+   fprintf(fp, "%-10s %8s\n", "phase", "msec");
+   for (i = 0; i < PH_N; i++)
+      fprintf(fp, "%-10s %8.1f\n", phname[i], ttotal[i]);
+}
+
+/*
+ * jstr - print s on fp as a JSON string
+ */
+static void jstr(FILE *fp, char *s)
+{
+   putc('"', fp);
+   for (; *s; s++)
+      if (*s == '"' || *s == '\\')
+         fprintf(fp, "\\%c", *s);
+      else if ((unsigned char) *s < ' ')
+         fprintf(fp, "\\u%04x", *s);
+      else
+         putc(*s, fp);
+   putc('"', fp);
+}
+
+/*
+ * sjson - print the statistics of -stats=json on fp
+ */
+static void sjson(FILE *fp)
+{
+   int i, j;
+   unsigned long n;
+
+   fprintf(fp, "{\n  \"tables\": {");
+   for (i = 0; i < TB_N; i++) {
+      for (j = n = 0; j < NCHAIN; j++)
+         n += slen[i][j];
+      fprintf(fp, "%s\n    \"%s\": {\"slots\": %lu, \"empty\": %lu, "
+              "\"longest\": %u, \"chains\": [", i ? "," : "", tbname[i], n,
+              slen[i][0], slong[i]);
+      for (j = 1; j < NCHAIN; j++)
+         fprintf(fp, "%s%lu", j > 1 ? ", " : "", slen[i][j]);
+      fprintf(fp, "]}");
+   }
+   fprintf(fp, "\n  },\n  \"peak_records\": %d,\n  \"alloc_bytes\": %lu,\n",
+           srecs, sbytes);
+   fprintf(fp, "  \"phases_msec\": {");
+   for (i = 0; i < PH_N; i++)
+      fprintf(fp, "%s\"%s\": %.1f", i ? ", " : "", phname[i], ttotal[i]);
+   fprintf(fp, "},\n  \"functions\": [");
+   for (i = 0; i < snfns; i++) {
+      fprintf(fp, "%s\n    {\"name\": ", i ? "," : "");
+      jstr(fp, sfns[i].n_name);
+      fprintf(fp, ", \"file\": ");
+      if (sfns[i].n_file)
+         jstr(fp, sfns[i].n_file);
+      else
+         fprintf(fp, "null");
+      fprintf(fp, ", \"temps\": %d, \"labels\": %d}", sfns[i].n_temps,
+              sfns[i].n_labels);
+   }
+   fprintf(fp, "%s]\n}\n", snfns ? "\n  " : "");
+}
+
+/*
+ * sstats - print the statistics of -stats on fp
+ *
+ * The chains of a table are counted by length, from 1; a length of 0 is
+ * an empty slot.  A chain of the identifier table, which is open
+ * addressed, is the run of slots probed to find a name.
+ */
+void sstats(FILE *fp)
+{
+   int i, j;
+
+   if (sstat == ST_JSON) {
+      sjson(fp);
+      return;
+   }
+   fprintf(fp, "%-12s %8s %8s", "table", "empty", "longest");
+   for (j = 1; j < NCHAIN; j++)
+      fprintf(fp, " %7d%s", j, j == NCHAIN - 1 ? "+" : " ");
+   putc('\n', fp);
+   for (i = 0; i < TB_N; i++) {
+      fprintf(fp, "%-12s %8lu %8u", tbname[i], slen[i][0], slong[i]);
+      for (j = 1; j < NCHAIN; j++)
+         fprintf(fp, " %7lu ", slen[i][j]);
+      putc('\n', fp);
+   }
+   fprintf(fp, "peak records %8d\nalloc bytes  %8lu\n", srecs, sbytes);
+   if (!ostat)
+      tstats(fp);
+   fprintf(fp, "%-16s %-16s %6s %6s\n", "function", "file", "temps", "labels");
+   for (i = 0; i < snfns; i++)
+      fprintf(fp, "%-16s %-16s %6d %6d\n", sfns[i].n_name,
+              sfns[i].n_file ? sfns[i].n_file : "-", sfns[i].n_temps,
+              sfns[i].n_labels);
+}
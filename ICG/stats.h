@@ -0,0 +1,31 @@
+/* phases of compiling a file, timed for -p and -stats */
+# define PH_READ 0		/* reading the file in */
+# define PH_LEX 1		/* the scanner */
+# define PH_PARSE 2		/* the parser, less what it calls */
+# define PH_SEM 3		/* the semantic actions, less the rest */
+# define PH_OPT 4		/* resolving and optimizing functions */
+# define PH_WRITE 5		/* writing the quads, and waiting for them */
+# define PH_N 6
+
+/* what -stats prints, in sstat */
+# define ST_TEXT 1		/* a report */
+# define ST_JSON 2		/* the same as one JSON object */
+
+/* hash tables whose chains -stats counts */
+# define TB_ID 0		/* identifiers, in sym.c */
+# define TB_STR 1		/* interned strings, in sym.c */
+# define TB_N 2
+
+struct qfunc;
+
+extern int sstat;
+extern UNIT unsigned long tbytes;
+extern UNIT int trecs;
+
+int tenter(int);
+void tflush();
+void tstats(FILE *);
+void tchain(int, unsigned);
+void tsource(char *);
+void tfunc(struct qfunc *);
+void sstats(FILE *);
@@ -4,62 +4,116 @@
 # include <malloc.h>
 # include <stdlib.h>
 # include <string.h>
+# include <pthread.h>
 # include "cc.h"
+# include "arena.h"
 # include "sym.h"
+# include "stats.h"
 
-# define STABSIZE 119			   /* hash table size for strings */
-# define ITABSIZE 37			   /* hash table size for identifiers */
-# define MAXSTK   1000
+# define STABSIZE 256			   /* initial hash table size for strings */
+# define STRBLK   65536			   /* string arena block size */
+# define ITABSIZE 64			   /* initial hash table size for identifiers */
+# define RECBLK   16384			   /* semantic record arena block size */
 
-struct sem_rec *stk[MAXSTK];               /* stack of ptrs to semantic recs */
-struct sem_rec **top = stk;                /* stack pointer */
-struct sem_rec **prevtop = NULL;           /* previous top */
+UNIT struct arena rec_arena;               /* semantic records */
+UNIT struct rec_mark {
+   struct amark r_mark;                    /* rec_arena top at block entry */
+   int r_numrecs;                          /* numrecs at block entry */
+   } *rec_stk = NULL;                      /* one mark per open block */
+UNIT int rec_nstk = 0;                     /* marks in rec_stk */
+UNIT int rec_maxstk = 0;                   /* room in rec_stk */
 
-int numrecs = 0;                           /* number of semantic recs */
+UNIT int numrecs = 0;                      /* number of semantic recs */
 
-int level = 0;                             /* current block level */
+UNIT int level = 0;                        /* current block level */
 
-struct s_chain {
-   char *s_ptr;                            /* string pointer */
-   struct s_chain *s_next;                 /* next in chain */
-   } *str_table[STABSIZE] = {0};           /* string hash table */
+/*
+ * Each compiling thread interns into a string table of its own.  A thread
+ * optimizing a function for it borrows the table, and then every lookup
+ * holds st_lock.
+ */
+struct strtab {
+   struct s_chain {
+      char *s_ptr;                         /* string pointer */
+      unsigned s_hash;                     /* full hash of string */
+      struct s_chain *s_next;              /* next in chain */
+      } **st_table;                        /* string hash table */
+   unsigned st_size;                       /* buckets in st_table */
+   unsigned st_count;                      /* strings in st_table */
+   struct arena st_arena;                  /* string bytes */
+   struct arena st_chains;                 /* string table chains */
+   pthread_mutex_t st_lock;                /* held by lookups if sshared */
+};
+static UNIT struct strtab ownstrs;         /* the thread's own strings */
+static UNIT struct strtab *strs = NULL;    /* strings in use, ownstrs if NULL */
+int sshared = 0;                           /* string tables may be borrowed */
 
-struct id_entry *id_table[ITABSIZE] = {0}; /* identifier hash table */
+/*
+ * The identifier table is open addressed with linear probing, one slot per
+ * name, and the innermost entry for a name lives in the slot itself.  The
+ * entries it hides hang off i_link, innermost first.  A pointer returned
+ * by install or lookup is only good until the next install or leaveblock,
+ * as either may move entries around.
+ */
+UNIT struct id_entry *id_table = NULL;     /* identifier hash table */
+UNIT unsigned id_size = 0;                 /* slots in id_table */
+UNIT unsigned id_count = 0;                /* names in id_table */
+UNIT struct id_entry *id_free = NULL;      /* unused hidden entries */
+
+UNIT struct id_undo {
+   char *u_name;                           /* name installed */
+   int u_blevel;                           /* at this block level */
+   } *id_log = NULL;                       /* installs, oldest first */
+UNIT unsigned id_nlog = 0;                 /* entries in id_log */
+UNIT unsigned id_maxlog = 0;               /* room in id_log */
+UNIT unsigned *id_mark = NULL;             /* id_nlog as each level began */
+UNIT unsigned id_maxmark = 0;              /* room in id_mark */
 
 /*
  *  dump - dump identifiers with block level >= blev to f
  */
 void dump(int blev, FILE *f)
 {
-   struct id_entry **i, *p;
+   struct id_entry *i, *p;
 
    fprintf(f, "Dumping identifier table\n");
-   for (i = id_table; i < &id_table[ITABSIZE]; i++)
-      for (p = *i; p; p = p->i_link)
+   for (i = id_table; i < &id_table[id_size]; i++)
+      for (p = i->i_name ? i : NULL; p; p = p->i_link)
          if (p->i_blevel >= blev)
             fprintf(f, "%s\t%d\t%d\t%d\n", p->i_name, p->i_blevel, 
              p->i_type, p->i_defined);
 }
 
 /*
- * new_block - save previous stack top and mark a new one
+ * new_block - mark the semantic records of a new block
  */
 void new_block()
 {
-   save_rec((struct sem_rec *) prevtop);
-   prevtop = top - 1;
+   if (rec_nstk >= rec_maxstk) {
+      if (rec_stk == NULL)
+         ainit(&rec_arena, RECBLK);
+      rec_maxstk = rec_maxstk ? 2 * rec_maxstk : 64;
+      rec_stk = (struct rec_mark *) realloc(rec_stk,
+                                            rec_maxstk * sizeof(struct rec_mark));
+      if (rec_stk == NULL) {
+         yyerror("csem: out of space");
+         exit (1);
+      }
+   }
+   rec_stk[rec_nstk].r_mark = amark(&rec_arena);
+   rec_stk[rec_nstk++].r_numrecs = numrecs;
 }
 
 /*
- * exit_block - exit block, free up semantic records
+ * exit_block - exit block, release its semantic records all at once
  */
 void exit_block()
 {
-   for (top--; top > prevtop;) {
-      numrecs--;
-      free((char *) *top--);
+   if (rec_nstk > 0) {
+      rec_nstk--;
+      arelease(&rec_arena, rec_stk[rec_nstk].r_mark);
+      numrecs = rec_stk[rec_nstk].r_numrecs;
    }
-   prevtop = (struct sem_rec **) *top;
 }
 
 /*
@@ -69,6 +123,59 @@ void enterblock()
 {
    new_block();
    level++;
+   if (level >= id_maxmark) {
+      id_maxmark = id_maxmark ? 2 * id_maxmark : 64;
+      id_mark = (unsigned *) realloc(id_mark, id_maxmark * sizeof(unsigned));
+      if (id_mark == NULL) {
+         yyerror("csem: out of space");
+         exit (1);
+      }
+   }
+   id_mark[level] = id_nlog;
+}
+
+/*
+ * islot - return the slot holding name, or the empty slot it would take
+ */
+static unsigned islot(char *name)
+{
+   unsigned i;
+
+   for (i = hash(name) & (id_size - 1);
+        id_table[i].i_name && id_table[i].i_name != name;
+        i = (i + 1) & (id_size - 1))
+      ;
+   return (i);
+}
+
+/*
+ * igrow - double the number of slots in the identifier table
+ */
+static void igrow()
+{
+   struct id_entry *old = id_table, *p;
+   unsigned oldsize = id_size;
+
+   id_size = oldsize ? 2 * oldsize : ITABSIZE;
+   id_table = (struct id_entry *) alloc(id_size * sizeof(struct id_entry));
+   for (p = old; p < &old[oldsize]; p++)
+      if (p->i_name)
+         id_table[islot(p->i_name)] = *p;
+   free(old);
+}
+
+/*
+ * ihidden - return an entry for the chain of hidden declarations
+ */
+static struct id_entry *ihidden()
+{
+   struct id_entry *p;
+
+   if ((p = id_free) != NULL)
+      id_free = p->i_link;
+   else
+      p = (struct id_entry *) alloc(sizeof(struct id_entry));
+   return (p);
 }
 
 /*
@@ -76,48 +183,171 @@ void enterblock()
  */
 struct id_entry *install(char *name, int blev)
 {
-   struct id_entry *ip, **q;
+   struct id_entry *ip, *hp, **q;
    
    if (blev < 0)
       blev = level;
 
-   /* allocate space */
-   ip = (struct id_entry *) alloc(sizeof(struct id_entry));
+   /* keep the table at most half full */
+   if (2 * (id_count + 1) > id_size)
+      igrow();
+   ip = &id_table[islot(name)];
+   if (ip->i_name == NULL) {
+      id_count++;
+      memset(ip, 0, sizeof(struct id_entry));
+   }
+   else if (blev >= ip->i_blevel) {
+      /* the new entry hides the one in the slot */
+      hp = ihidden();
+      *hp = *ip;
+      memset(ip, 0, sizeof(struct id_entry));
+      ip->i_link = hp;
+   }
+   else {
+      /* an outer entry goes behind the inner ones */
+      for (q = &ip->i_link; *q; q = &((*q)->i_link))
+         if (blev >= (*q)->i_blevel)
+            break;
+      hp = ihidden();
+      memset(hp, 0, sizeof(struct id_entry));
+      hp->i_link = *q;
+      *q = hp;
+      ip = hp;
+   }
+
+   /* remember it so leaveblock can find it again */
+   if (id_nlog >= id_maxlog) {
+      id_maxlog = id_maxlog ? 2 * id_maxlog : 256;
+      id_log = (struct id_undo *) realloc(id_log,
+                                          id_maxlog * sizeof(struct id_undo));
+      if (id_log == NULL) {
+         yyerror("csem: out of space");
+         exit (1);
+      }
+   }
+   id_log[id_nlog].u_name = name;
+   id_log[id_nlog++].u_blevel = blev;
 
    /* set fields of symbol table */
    ip->i_name = name;
    ip->i_blevel = blev;
-   for (q = &id_table[hash(name)%ITABSIZE]; *q; q = &((*q)->i_link))
-      if (blev >= (*q)->i_blevel)
-         break;
-   ip->i_link = *q;
-   *q = ip;
    return (ip);
 }
 
+/*
+ * iremove - remove the entry for name at block level blev
+ */
+static void iremove(char *name, int blev)
+{
+   struct id_entry *ip, *hp, **q;
+   unsigned i, j, k, mask = id_size - 1;
+
+   ip = &id_table[i = islot(name)];
+   if (ip->i_name == NULL)
+      return;
+   if (ip->i_blevel != blev) {
+      for (q = &ip->i_link; *q; q = &((*q)->i_link))
+         if ((*q)->i_blevel == blev) {
+            hp = *q;
+            *q = hp->i_link;
+            hp->i_link = id_free;
+            id_free = hp;
+            break;
+         }
+      return;
+   }
+   if ((hp = ip->i_link) != NULL) {
+      /* uncover the next entry for the name */
+      *ip = *hp;
+      hp->i_link = id_free;
+      id_free = hp;
+      return;
+   }
+
+   /* empty the slot, closing up the probe sequence behind it */
+   for (j = (i + 1) & mask; id_table[j].i_name; j = (j + 1) & mask) {
+      /* entry j may move back to i unless its home lies in (i, j] */
+      k = hash(id_table[j].i_name) & mask;
+      if (i <= j ? (i < k && k <= j) : (i < k || k <= j))
+         continue;
+      id_table[i] = id_table[j];
+      i = j;
+   }
+   id_table[i].i_name = NULL;
+   id_count--;
+}
+
 /*
  * leaveblock - exit a block
  */
 void leaveblock()
 {
-   struct id_entry **i, *p, *tmp;
+   struct id_undo *u, *keep;
 
    if (level > 0) {
-      for (i = id_table; i < &id_table[ITABSIZE]; i++) {
-         for (p = *i; p; p = tmp)
-            if (p->i_blevel < level)
-               break;
-            else {
-               tmp = p->i_link;
-               free(p);
-            }
-         *i = p;
-      }
+      /* every entry at this level or deeper was installed since it began */
+      keep = &id_log[id_mark[level]];
+      for (u = keep; u < &id_log[id_nlog]; u++)
+         if (u->u_blevel < level)
+            *keep++ = *u;
+         else
+            iremove(u->u_name, u->u_blevel);
+      id_nlog = keep - id_log;
       level--;
    }
    exit_block();
 }
 
+/*
+ * symreset - forget every identifier and semantic record, ready for the
+ *            next file
+ *
+ * The interned strings are kept.
+ */
+void symreset()
+{
+   struct id_undo *u;
+
+   while (level > 0)
+      leaveblock();
+   while (rec_nstk > 0)
+      exit_block();
+   while (id_nlog > 0) {
+      u = &id_log[--id_nlog];
+      iremove(u->u_name, u->u_blevel);
+   }
+}
+
+/*
+ * symstats - count the chains of the identifier table of this thread for
+ *            -stats, before it is cleared for the next file
+ */
+void symstats()
+{
+   unsigned i, mask = id_size - 1;
+
+   for (i = 0; i < id_size; i++)
+      tchain(TB_ID, id_table[i].i_name ?
+                    ((i - hash(id_table[i].i_name)) & mask) + 1 : 0);
+}
+
+/*
+ * strstats - count the chains of the string table of this thread for
+ *            -stats, once it has compiled its last file
+ */
+void strstats()
+{
+   struct strtab *t = scurrent();
+   struct s_chain *p;
+   unsigned i, n;
+
+   for (i = 0; i < t->st_size; i++) {
+      for (n = 0, p = t->st_table[i]; p; p = p->s_next)
+         n++;
+      tchain(TB_STR, n);
+   }
+}
+
 /*
  * lookup - lookup name, return ptr; use default scope if blev == 0
  */
@@ -125,8 +355,10 @@ struct id_entry *lookup(char *name, int blev)
 {
    struct id_entry *p;
 
-   for (p = id_table[hash(name)%ITABSIZE]; p; p = p->i_link)
-      if (name == p->i_name && (blev == 0 || blev == p->i_blevel))
+   if (id_table == NULL)
+      return (NULL);
+   for (p = &id_table[islot(name)]; p && p->i_name; p = p->i_link)
+      if (blev == 0 || blev == p->i_blevel)
          return (p);
    return (NULL);
 }
@@ -136,46 +368,126 @@ struct id_entry *lookup(char *name, int blev)
  */
 void sdump(FILE *f)
 {
+   struct strtab *t = scurrent();
    struct s_chain **s, *p;
 
    fprintf(f, "Dumping string table\n");
-   for (s = str_table; s < &str_table[STABSIZE]; s++)
+   for (s = t->st_table; s < &t->st_table[t->st_size]; s++)
       for (p = *s; p; p = p->s_next)
          fprintf(f, "%s\n", p->s_ptr);
 }
 
+/*
+ * shash - hash the n characters at s (FNV-1a)
+ */
+static unsigned shash(char *s, unsigned n)
+{
+   unsigned h = 2166136261u;
+
+   while (n-- > 0)
+      h = (h ^ (unsigned char) *s++) * 16777619u;
+   return (h);
+}
+
+/*
+ * sgrow - double the number of buckets in string table t
+ */
+static void sgrow(struct strtab *t)
+{
+   struct s_chain **old = t->st_table, *p, *next;
+   unsigned i, oldsize = t->st_size, mask;
+
+   t->st_size = oldsize ? 2 * oldsize : STABSIZE;
+   mask = t->st_size - 1;
+   t->st_table = (struct s_chain **) alloc(t->st_size * sizeof(struct s_chain *));
+   for (i = 0; i < oldsize; i++)
+      for (p = old[i]; p; p = next) {
+         next = p->s_next;
+         p->s_next = t->st_table[p->s_hash & mask];
+         t->st_table[p->s_hash & mask] = p;
+      }
+   free(old);
+}
+
+/*
+ * scurrent - the string table this thread interns into
+ */
+struct strtab *scurrent()
+{
+   if (strs == NULL) {
+      strs = &ownstrs;
+      pthread_mutex_init(&strs->st_lock, NULL);
+   }
+   return (strs);
+}
+
+/*
+ * suse - intern into string table t from now on
+ */
+void suse(struct strtab *t)
+{
+   strs = t;
+}
+
 /*
  * slookup - lookup str in string table, install if necessary, return ptr 
  */
 char *slookup(char str[])
 {
-   struct s_chain *p;
-   int i, k;
-   
-   for (k = i = 0; i < 5; i++)	/* simple hash function */
-      if (str[i])
-         k += str[i];
-      else
-         break;
-   
-   k %= STABSIZE;
-   for (p = str_table[k]; p; p = p->s_next)
-      if (strcmp(str, p->s_ptr) == 0)
-         return (p->s_ptr);
-   p = (struct s_chain *) alloc(sizeof(struct s_chain));
-   p->s_next = str_table[k];
-   str_table[k] = p;
-   p->s_ptr = (char *) alloc((unsigned) strlen((const char*)str) + 1);
-   p->s_ptr = strcpy(p->s_ptr, str);
+   return (snlookup(str, strlen(str)));
+}
+
+/*
+ * snlookup - like slookup, for the n characters at s, which need not end
+ *            in a nul
+ */
+char *snlookup(char *s, unsigned n)
+{
+   struct strtab *t = strs ? strs : scurrent();
+   struct s_chain *p, **q;
+   unsigned h;
+
+   h = shash(s, n);
+   if (sshared)
+      pthread_mutex_lock(&t->st_lock);
+   if (t->st_table)
+      for (p = t->st_table[h & (t->st_size - 1)]; p; p = p->s_next)
+         if (p->s_hash == h && strncmp(s, p->s_ptr, n) == 0 &&
+             p->s_ptr[n] == '\0') {
+            if (sshared)
+               pthread_mutex_unlock(&t->st_lock);
+            return (p->s_ptr);
+         }
+   if (t->st_count >= t->st_size) {
+      if (t->st_table == NULL) {
+         ainit(&t->st_arena, STRBLK);
+         ainit(&t->st_chains, STRBLK);
+      }
+      sgrow(t);
+   }
+   t->st_count++;
+   q = &t->st_table[h & (t->st_size - 1)];
+   p = (struct s_chain *) aalloc(&t->st_chains, sizeof(struct s_chain));
+   p->s_hash = h;
+   p->s_next = *q;
+   *q = p;
+   p->s_ptr = asave(&t->st_arena, s, n);
+   if (sshared)
+      pthread_mutex_unlock(&t->st_lock);
    return (p->s_ptr);
 }
 
 /*
- * hash - hash name, turn address into hash number
+ * hash - hash name, turn address of its interned string into hash number
  */
-int hash(char *s)
+unsigned hash(char *s)
 {
-   return((int ) s);
+   unsigned long k = (unsigned long) s;
+
+   /* the low bits of an arena address carry little information */
+   k ^= k >> 29;
+   k *= 0x9e3779b97f4a7c15ul;
+   return ((unsigned) (k >> 32));
 }   
 
 /*
@@ -189,18 +501,18 @@ char *alloc(unsigned n)
       yyerror("csem: out of space");
       exit (1);
    }
+   tbytes += n;
    return (p);
 }
 
 /*
- * save_rec - save a semantic record so it can be reclaimed later
+ * ralloc - alloc space for a semantic record, reclaimed at block exit
  */
-void save_rec(struct sem_rec *s)
+char *ralloc(unsigned n)
 {
-   /* save on stack so can reclaim */
-   if (numrecs++ > MAXSTK) {
-      fprintf(stderr, "too many semantic records\n");
-      exit(1);
-   }
-   *top++ = s;
+   if (rec_stk == NULL)
+      new_block();
+   if (++numrecs > trecs)
+      trecs = numrecs;
+   return (aalloc(&rec_arena, n));
 }
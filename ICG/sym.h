@@ -1,3 +1,5 @@
+extern int sshared;
+
 void dump(int, FILE *);
 void new_block();
 void exit_block();
@@ -5,8 +7,14 @@ void enterblock();
 struct id_entry *install(char *, int);
 void leaveblock();
 struct id_entry *lookup(char *, int);
+void symreset();
+void symstats();
+void strstats();
 void sdump(FILE *);
 char *slookup(char []);
-int hash(char *);
+char *snlookup(char *, unsigned);
+unsigned hash(char *);
+struct strtab *scurrent();
+void suse(struct strtab *);
 char *alloc(unsigned);
-void save_rec(struct sem_rec *);
+char *ralloc(unsigned);
@@ -40,7 +40,7 @@ files = sorted(files)
 for f in files:
     command = "./sem_base.exe < {} > {}".format(os.path.join(TESTDIR, f),
                                                 os.path.join(EXP_OUT, "{}.out".format(f)))
-    command2 = "./csem < {} > {}".format(os.path.join(TESTDIR, f),
+    command2 = "./csem -B < {} > {}".format(os.path.join(TESTDIR, f),
                                                 os.path.join(RES_OUT, "{}.out".format(f)))
     command3 = "diff {} {}".format(os.path.join(EXP_OUT, "{}.out".format(f)),
                                   os.path.join(RES_OUT, "{}.out".format(f)))